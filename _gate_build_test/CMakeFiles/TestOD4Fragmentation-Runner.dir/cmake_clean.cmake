@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TestOD4Fragmentation-Runner.dir/TestOD4Fragmentation.cpp.o"
+  "CMakeFiles/TestOD4Fragmentation-Runner.dir/TestOD4Fragmentation.cpp.o.d"
+  "TestOD4Fragmentation-Runner"
+  "TestOD4Fragmentation-Runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestOD4Fragmentation-Runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
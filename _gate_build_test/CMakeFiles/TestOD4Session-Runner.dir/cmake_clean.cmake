@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TestOD4Session-Runner.dir/TestOD4Session.cpp.o"
+  "CMakeFiles/TestOD4Session-Runner.dir/TestOD4Session.cpp.o.d"
+  "TestOD4Session-Runner"
+  "TestOD4Session-Runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestOD4Session-Runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
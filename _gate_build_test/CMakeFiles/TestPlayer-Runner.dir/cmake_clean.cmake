@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TestPlayer-Runner.dir/TestPlayer.cpp.o"
+  "CMakeFiles/TestPlayer-Runner.dir/TestPlayer.cpp.o.d"
+  "TestPlayer-Runner"
+  "TestPlayer-Runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestPlayer-Runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
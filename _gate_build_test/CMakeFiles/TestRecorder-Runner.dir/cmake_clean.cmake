@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TestRecorder-Runner.dir/TestRecorder.cpp.o"
+  "CMakeFiles/TestRecorder-Runner.dir/TestRecorder.cpp.o.d"
+  "TestRecorder-Runner"
+  "TestRecorder-Runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestRecorder-Runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
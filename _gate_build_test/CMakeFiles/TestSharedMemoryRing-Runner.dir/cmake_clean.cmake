@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TestSharedMemoryRing-Runner.dir/TestSharedMemoryRing.cpp.o"
+  "CMakeFiles/TestSharedMemoryRing-Runner.dir/TestSharedMemoryRing.cpp.o.d"
+  "TestSharedMemoryRing-Runner"
+  "TestSharedMemoryRing-Runner.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TestSharedMemoryRing-Runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
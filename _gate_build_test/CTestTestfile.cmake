@@ -0,0 +1,16 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_gate_build_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(TestOD4Fragmentation-Runner "/root/repo/_gate_build_test/TestOD4Fragmentation-Runner")
+set_tests_properties(TestOD4Fragmentation-Runner PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;55;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(TestOD4Session-Runner "/root/repo/_gate_build_test/TestOD4Session-Runner")
+set_tests_properties(TestOD4Session-Runner PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;55;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(TestPlayer-Runner "/root/repo/_gate_build_test/TestPlayer-Runner")
+set_tests_properties(TestPlayer-Runner PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;55;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(TestRecorder-Runner "/root/repo/_gate_build_test/TestRecorder-Runner")
+set_tests_properties(TestRecorder-Runner PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;55;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(TestSharedMemoryRing-Runner "/root/repo/_gate_build_test/TestSharedMemoryRing-Runner")
+set_tests_properties(TestSharedMemoryRing-Runner PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;55;add_test;/root/repo/test/CMakeLists.txt;0;")
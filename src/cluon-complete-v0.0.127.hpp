@@ -2,6 +2,25 @@
 // Date: Sun, 03 Nov 2019 15:21:13 +0100
 // Version: 0.0.127
 //
+// This file is a locally modified fork of libcluon 0.0.127 and differs from the
+// upstream release of the same version; replacing it with an upstream
+// cluon-complete.hpp drops the following changes (see the git history of this
+// file and the test suites in test/ for details):
+//   + OD4Session: batched sending (packing into UDP packets opt-in per CID via
+//     CLUON_OD4SESSION_BATCHING), fragmentation of Envelopes exceeding a UDP
+//     packet (0x0D 0xA5 fragments), shared memory fast path for OD4Sessions on
+//     the same host (opt-in per CID via CLUON_OD4SESSION_SHAREDMEMORY), and
+//     time triggers on absolute monotonic deadlines.
+//   + UDPSender/UDPReceiver: sendmmsg and pooled receive buffers.
+//   + Proto and JSON codecs, cluon-msc, and EnvelopeConverter: contiguous
+//     buffers, shared payloads, and compiled message specifications.
+//   + Player: index sidecar files (<file>.rec.idx), memory-mapped replay,
+//     filtering by dataType/senderStamp, bounded caches, and chunked .rec files.
+//   + Recorder: asynchronous writing of plain and chunked .rec files.
+//   + Tools: cluon-replay (--keep, --rate, --lockstep), parallel cluon-rec2csv,
+//     and the additional tools cluon-rec2json and cluon-od4bench.
+#define CLUON_COMPLETE_LOCAL_FORK_OF_VERSION "0.0.127"
+//
 //
 // Implementation of N4562 std::experimental::any (merged into C++17) for C++11 compilers.
 //
@@ -4374,6 +4393,37 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_CODEC_TYPE_TRAIT
+#define PROTO_CODEC_TYPE_TRAIT
+// Types providing encodeProto/decodeProto are (de)serialized without visiting each field by name.
+template<typename T>
+struct isProtoCodec {
+    static const bool value = false;
+};
+#endif
+
+#ifndef SHARED_BYTES_TYPE
+#define SHARED_BYTES_TYPE
+#include <memory>
+#include <string>
+
+// Fields of type bytes are held in a buffer that is shared between copies of a
+// message; a shared buffer is never modified but copied before being modified.
+inline const std::string &emptySharedBytes() noexcept {
+    static const std::string EMPTY;
+    return EMPTY;
+}
+
+inline std::string &mutableSharedBytes(std::shared_ptr<std::string> &v) noexcept {
+    if (!v) {
+        v = std::make_shared<std::string>();
+    } else if (1 < v.use_count()) {
+        v = std::make_shared<std::string>(*v);
+    }
+    return *v;
+}
+#endif
+
 
 #ifndef CLUON_DATA_TIMESTAMP_HPP
 #define CLUON_DATA_TIMESTAMP_HPP
@@ -4395,6 +4445,7 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <memory>
 #include <string>
 #include <utility>
 namespace cluon { namespace data {
@@ -4485,6 +4536,32 @@ class LIB_API TimeStamp {
             std::forward<PostVisitor>(postVisit)();
         }
 
+    public:
+        // Proto tags are (field identifier << 3) | wire type.
+        template<class ProtoEncoder>
+        inline void encodeProto(ProtoEncoder &encoder) const {
+            (void)encoder; // Prevent warnings from empty messages.
+            
+            encoder.encodeField(8u, m_seconds);
+            
+            encoder.encodeField(16u, m_microseconds);
+            
+        }
+
+        template<class ProtoDecoder>
+        inline void decodeProto(ProtoDecoder &decoder) {
+            while (decoder.nextField()) {
+                switch (decoder.fieldTag()) {
+                    
+                    case 8u: decoder.decodeField(m_seconds); break;
+                    
+                    case 16u: decoder.decodeField(m_microseconds); break;
+                    
+                    default: break;
+                }
+            }
+        }
+
     private:
         
         int32_t m_seconds{ 0 }; // field identifier = 1.
@@ -4502,6 +4579,10 @@ template<>
 struct isTripletForwardVisitable<cluon::data::TimeStamp> {
     static const bool value = true;
 };
+template<>
+struct isProtoCodec<cluon::data::TimeStamp> {
+    static const bool value = true;
+};
 #endif
 
 
@@ -4581,6 +4662,37 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_CODEC_TYPE_TRAIT
+#define PROTO_CODEC_TYPE_TRAIT
+// Types providing encodeProto/decodeProto are (de)serialized without visiting each field by name.
+template<typename T>
+struct isProtoCodec {
+    static const bool value = false;
+};
+#endif
+
+#ifndef SHARED_BYTES_TYPE
+#define SHARED_BYTES_TYPE
+#include <memory>
+#include <string>
+
+// Fields of type bytes are held in a buffer that is shared between copies of a
+// message; a shared buffer is never modified but copied before being modified.
+inline const std::string &emptySharedBytes() noexcept {
+    static const std::string EMPTY;
+    return EMPTY;
+}
+
+inline std::string &mutableSharedBytes(std::shared_ptr<std::string> &v) noexcept {
+    if (!v) {
+        v = std::make_shared<std::string>();
+    } else if (1 < v.use_count()) {
+        v = std::make_shared<std::string>(*v);
+    }
+    return *v;
+}
+#endif
+
 
 #ifndef CLUON_DATA_ENVELOPE_HPP
 #define CLUON_DATA_ENVELOPE_HPP
@@ -4602,6 +4714,7 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <memory>
 #include <string>
 #include <utility>
 namespace cluon { namespace data {
@@ -4641,10 +4754,21 @@ class LIB_API Envelope {
         }
         
         inline Envelope& serializedData(const std::string &v) noexcept {
-            m_serializedData = v;
+            m_serializedData = std::make_shared<std::string>(v);
+            return *this;
+        }
+        inline Envelope& serializedData(std::string &&v) noexcept {
+            m_serializedData = std::make_shared<std::string>(std::move(v));
+            return *this;
+        }
+        inline Envelope& serializedData(const std::shared_ptr<const std::string> &v) noexcept {
+            m_serializedData = std::const_pointer_cast<std::string>(v); // NOLINT: Shared buffers are copied by mutableSharedBytes before being modified.
             return *this;
         }
-        inline std::string serializedData() const noexcept {
+        inline const std::string &serializedData() const noexcept {
+            return (m_serializedData ? *m_serializedData : emptySharedBytes());
+        }
+        inline std::shared_ptr<const std::string> sharedSerializedData() const noexcept {
             return m_serializedData;
         }
         
@@ -4694,7 +4818,7 @@ class LIB_API Envelope {
             }
             
             if (2 == fieldId) {
-                doVisit(2, std::move("std::string"s), std::move("serializedData"s), m_serializedData, visitor);
+                doVisit(2, std::move("std::string"s), std::move("serializedData"s), mutableSharedBytes(m_serializedData), visitor);
                 return;
             }
             
@@ -4727,7 +4851,7 @@ class LIB_API Envelope {
             
             doVisit(1, std::move("int32_t"s), std::move("dataType"s), m_dataType, visitor);
             
-            doVisit(2, std::move("std::string"s), std::move("serializedData"s), m_serializedData, visitor);
+            doVisit(2, std::move("std::string"s), std::move("serializedData"s), mutableSharedBytes(m_serializedData), visitor);
             
             doVisit(3, std::move("cluon::data::TimeStamp"s), std::move("sent"s), m_sent, visitor);
             
@@ -4747,7 +4871,7 @@ class LIB_API Envelope {
             
             doTripletForwardVisit(1, std::move("int32_t"s), std::move("dataType"s), m_dataType, preVisit, visit, postVisit);
             
-            doTripletForwardVisit(2, std::move("std::string"s), std::move("serializedData"s), m_serializedData, preVisit, visit, postVisit);
+            doTripletForwardVisit(2, std::move("std::string"s), std::move("serializedData"s), mutableSharedBytes(m_serializedData), preVisit, visit, postVisit);
             
             doTripletForwardVisit(3, std::move("cluon::data::TimeStamp"s), std::move("sent"s), m_sent, preVisit, visit, postVisit);
             
@@ -4760,11 +4884,53 @@ class LIB_API Envelope {
             std::forward<PostVisitor>(postVisit)();
         }
 
+    public:
+        // Proto tags are (field identifier << 3) | wire type.
+        template<class ProtoEncoder>
+        inline void encodeProto(ProtoEncoder &encoder) const {
+            (void)encoder; // Prevent warnings from empty messages.
+            
+            encoder.encodeField(8u, m_dataType);
+            
+            encoder.encodeField(18u, serializedData());
+            
+            encoder.encodeField(26u, m_sent);
+            
+            encoder.encodeField(34u, m_received);
+            
+            encoder.encodeField(42u, m_sampleTimeStamp);
+            
+            encoder.encodeField(48u, m_senderStamp);
+            
+        }
+
+        template<class ProtoDecoder>
+        inline void decodeProto(ProtoDecoder &decoder) {
+            while (decoder.nextField()) {
+                switch (decoder.fieldTag()) {
+                    
+                    case 8u: decoder.decodeField(m_dataType); break;
+                    
+                    case 18u: decoder.decodeField(mutableSharedBytes(m_serializedData)); break;
+                    
+                    case 26u: decoder.decodeField(m_sent); break;
+                    
+                    case 34u: decoder.decodeField(m_received); break;
+                    
+                    case 42u: decoder.decodeField(m_sampleTimeStamp); break;
+                    
+                    case 48u: decoder.decodeField(m_senderStamp); break;
+                    
+                    default: break;
+                }
+            }
+        }
+
     private:
         
         int32_t m_dataType{ 0 }; // field identifier = 1.
         
-        std::string m_serializedData{ ""s }; // field identifier = 2.
+        std::shared_ptr<std::string> m_serializedData{  }; // field identifier = 2.
         
         cluon::data::TimeStamp m_sent{  }; // field identifier = 3.
         
@@ -4785,6 +4951,10 @@ template<>
 struct isTripletForwardVisitable<cluon::data::Envelope> {
     static const bool value = true;
 };
+template<>
+struct isProtoCodec<cluon::data::Envelope> {
+    static const bool value = true;
+};
 #endif
 
 
@@ -4864,6 +5034,37 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_CODEC_TYPE_TRAIT
+#define PROTO_CODEC_TYPE_TRAIT
+// Types providing encodeProto/decodeProto are (de)serialized without visiting each field by name.
+template<typename T>
+struct isProtoCodec {
+    static const bool value = false;
+};
+#endif
+
+#ifndef SHARED_BYTES_TYPE
+#define SHARED_BYTES_TYPE
+#include <memory>
+#include <string>
+
+// Fields of type bytes are held in a buffer that is shared between copies of a
+// message; a shared buffer is never modified but copied before being modified.
+inline const std::string &emptySharedBytes() noexcept {
+    static const std::string EMPTY;
+    return EMPTY;
+}
+
+inline std::string &mutableSharedBytes(std::shared_ptr<std::string> &v) noexcept {
+    if (!v) {
+        v = std::make_shared<std::string>();
+    } else if (1 < v.use_count()) {
+        v = std::make_shared<std::string>(*v);
+    }
+    return *v;
+}
+#endif
+
 
 #ifndef CLUON_DATA_PLAYERCOMMAND_HPP
 #define CLUON_DATA_PLAYERCOMMAND_HPP
@@ -4885,6 +5086,7 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <memory>
 #include <string>
 #include <utility>
 namespace cluon { namespace data {
@@ -4975,6 +5177,32 @@ class LIB_API PlayerCommand {
             std::forward<PostVisitor>(postVisit)();
         }
 
+    public:
+        // Proto tags are (field identifier << 3) | wire type.
+        template<class ProtoEncoder>
+        inline void encodeProto(ProtoEncoder &encoder) const {
+            (void)encoder; // Prevent warnings from empty messages.
+            
+            encoder.encodeField(8u, m_command);
+            
+            encoder.encodeField(21u, m_seekTo);
+            
+        }
+
+        template<class ProtoDecoder>
+        inline void decodeProto(ProtoDecoder &decoder) {
+            while (decoder.nextField()) {
+                switch (decoder.fieldTag()) {
+                    
+                    case 8u: decoder.decodeField(m_command); break;
+                    
+                    case 21u: decoder.decodeField(m_seekTo); break;
+                    
+                    default: break;
+                }
+            }
+        }
+
     private:
         
         uint8_t m_command{ 0 }; // field identifier = 1.
@@ -4992,6 +5220,10 @@ template<>
 struct isTripletForwardVisitable<cluon::data::PlayerCommand> {
     static const bool value = true;
 };
+template<>
+struct isProtoCodec<cluon::data::PlayerCommand> {
+    static const bool value = true;
+};
 #endif
 
 
@@ -5071,6 +5303,37 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_CODEC_TYPE_TRAIT
+#define PROTO_CODEC_TYPE_TRAIT
+// Types providing encodeProto/decodeProto are (de)serialized without visiting each field by name.
+template<typename T>
+struct isProtoCodec {
+    static const bool value = false;
+};
+#endif
+
+#ifndef SHARED_BYTES_TYPE
+#define SHARED_BYTES_TYPE
+#include <memory>
+#include <string>
+
+// Fields of type bytes are held in a buffer that is shared between copies of a
+// message; a shared buffer is never modified but copied before being modified.
+inline const std::string &emptySharedBytes() noexcept {
+    static const std::string EMPTY;
+    return EMPTY;
+}
+
+inline std::string &mutableSharedBytes(std::shared_ptr<std::string> &v) noexcept {
+    if (!v) {
+        v = std::make_shared<std::string>();
+    } else if (1 < v.use_count()) {
+        v = std::make_shared<std::string>(*v);
+    }
+    return *v;
+}
+#endif
+
 
 #ifndef CLUON_DATA_PLAYERSTATUS_HPP
 #define CLUON_DATA_PLAYERSTATUS_HPP
@@ -5092,6 +5355,7 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <memory>
 #include <string>
 #include <utility>
 namespace cluon { namespace data {
@@ -5199,6 +5463,36 @@ class LIB_API PlayerStatus {
             std::forward<PostVisitor>(postVisit)();
         }
 
+    public:
+        // Proto tags are (field identifier << 3) | wire type.
+        template<class ProtoEncoder>
+        inline void encodeProto(ProtoEncoder &encoder) const {
+            (void)encoder; // Prevent warnings from empty messages.
+            
+            encoder.encodeField(8u, m_state);
+            
+            encoder.encodeField(16u, m_numberOfEntries);
+            
+            encoder.encodeField(24u, m_currentEntryForPlayback);
+            
+        }
+
+        template<class ProtoDecoder>
+        inline void decodeProto(ProtoDecoder &decoder) {
+            while (decoder.nextField()) {
+                switch (decoder.fieldTag()) {
+                    
+                    case 8u: decoder.decodeField(m_state); break;
+                    
+                    case 16u: decoder.decodeField(m_numberOfEntries); break;
+                    
+                    case 24u: decoder.decodeField(m_currentEntryForPlayback); break;
+                    
+                    default: break;
+                }
+            }
+        }
+
     private:
         
         uint8_t m_state{ 0 }; // field identifier = 1.
@@ -5218,6 +5512,10 @@ template<>
 struct isTripletForwardVisitable<cluon::data::PlayerStatus> {
     static const bool value = true;
 };
+template<>
+struct isProtoCodec<cluon::data::PlayerStatus> {
+    static const bool value = true;
+};
 #endif
 
 
@@ -5297,6 +5595,37 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_CODEC_TYPE_TRAIT
+#define PROTO_CODEC_TYPE_TRAIT
+// Types providing encodeProto/decodeProto are (de)serialized without visiting each field by name.
+template<typename T>
+struct isProtoCodec {
+    static const bool value = false;
+};
+#endif
+
+#ifndef SHARED_BYTES_TYPE
+#define SHARED_BYTES_TYPE
+#include <memory>
+#include <string>
+
+// Fields of type bytes are held in a buffer that is shared between copies of a
+// message; a shared buffer is never modified but copied before being modified.
+inline const std::string &emptySharedBytes() noexcept {
+    static const std::string EMPTY;
+    return EMPTY;
+}
+
+inline std::string &mutableSharedBytes(std::shared_ptr<std::string> &v) noexcept {
+    if (!v) {
+        v = std::make_shared<std::string>();
+    } else if (1 < v.use_count()) {
+        v = std::make_shared<std::string>(*v);
+    }
+    return *v;
+}
+#endif
+
 
 #ifndef CLUON_DATA_RECORDERCOMMAND_HPP
 #define CLUON_DATA_RECORDERCOMMAND_HPP
@@ -5318,6 +5647,7 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <memory>
 #include <string>
 #include <utility>
 namespace cluon { namespace data {
@@ -5391,6 +5721,28 @@ class LIB_API RecorderCommand {
             std::forward<PostVisitor>(postVisit)();
         }
 
+    public:
+        // Proto tags are (field identifier << 3) | wire type.
+        template<class ProtoEncoder>
+        inline void encodeProto(ProtoEncoder &encoder) const {
+            (void)encoder; // Prevent warnings from empty messages.
+            
+            encoder.encodeField(8u, m_command);
+            
+        }
+
+        template<class ProtoDecoder>
+        inline void decodeProto(ProtoDecoder &decoder) {
+            while (decoder.nextField()) {
+                switch (decoder.fieldTag()) {
+                    
+                    case 8u: decoder.decodeField(m_command); break;
+                    
+                    default: break;
+                }
+            }
+        }
+
     private:
         
         uint8_t m_command{ 0 }; // field identifier = 1.
@@ -5406,6 +5758,10 @@ template<>
 struct isTripletForwardVisitable<cluon::data::RecorderCommand> {
     static const bool value = true;
 };
+template<>
+struct isProtoCodec<cluon::data::RecorderCommand> {
+    static const bool value = true;
+};
 #endif
 
 /*
@@ -5968,6 +6324,7 @@ class LIBCLUON_API MetaMessage {
 //#include "cluon/MetaMessage.hpp"
 //#include "cluon/cluon.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -6021,7 +6378,9 @@ class LIBCLUON_API MessageParser {
     MessageParser() = default;
 
     /**
-     * This method tries to parse the given message specification.
+     * This method tries to parse the given message specification. The input
+     * can also be a compiled message specification created by compile(...),
+     * which is loaded without running the grammar.
      *
      * @param input Message specification.
      * @return Pair: List of cluon::MetaMessages describing the specified messages and error code:
@@ -6030,6 +6389,30 @@ class LIBCLUON_API MessageParser {
      *         DUPLICATE_IDENTIFIERS: The given specification contains ambiguous names or identifiers (list is empty).
      */
     std::pair<std::vector<MetaMessage>, MessageParserErrorCodes> parse(const std::string &input);
+
+    /**
+     * This method tries to parse the message specification from the given
+     * file in .odvd format or as compiled message specification; the file is
+     * memory-mapped so that a compiled message specification is loaded
+     * directly from the page cache.
+     *
+     * @param filename File containing the message specification.
+     * @return Pair as returned by parse(...); SYNTAX_ERROR if the file could not be read.
+     */
+    std::pair<std::vector<MetaMessage>, MessageParserErrorCodes> parseFile(const std::string &filename);
+
+    /**
+     * This method compiles the given list of MetaMessages into a compact,
+     * binary message specification that can be loaded by parse(...) and
+     * parseFile(...) without running the grammar again.
+     *
+     * @param listOfMetaMessages List of MetaMessages as returned by parse(...).
+     * @return Compiled message specification.
+     */
+    static std::string compile(const std::vector<MetaMessage> &listOfMetaMessages) noexcept;
+
+   private:
+    std::pair<std::vector<MetaMessage>, MessageParserErrorCodes> parseCompiled(const char *data, std::size_t size) noexcept;
 };
 } // namespace cluon
 
@@ -6103,6 +6486,7 @@ class LIBCLUON_API TerminateHandler {
 #include <functional>
 #include <mutex>
 #include <thread>
+#include <utility>
 
 namespace cluon {
 
@@ -6141,7 +6525,7 @@ class LIBCLUON_API NotifyingPipeline {
    public:
     inline void add(T &&entry) noexcept {
         std::unique_lock<std::mutex> lck(m_pipelineMutex);
-        m_pipeline.emplace_back(entry);
+        m_pipeline.emplace_back(std::move(entry));
     }
 
     inline void notifyAll() noexcept { m_pipelineCondition.notify_all(); }
@@ -6172,7 +6556,7 @@ class LIBCLUON_API NotifyingPipeline {
                 T entry;
                 {
                     lck.lock();
-                    entry = m_pipeline.front();
+                    entry = std::move(m_pipeline.front());
                     lck.unlock();
                 }
 
@@ -6243,6 +6627,7 @@ namespace cluon {
     enum class UDPPacketSizeConstraints : uint16_t {
         SIZE_IPv4_HEADER    = 20,
         SIZE_UDP_HEADER     = 8,
+        SIZE_ETHERNET_MTU   = 1500,
         MAX_SIZE_UDP_PACKET = 0xFFFF, };
 }
 // clang-format on
@@ -6274,6 +6659,7 @@ namespace cluon {
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 /**
@@ -6300,6 +6686,11 @@ std::pair<ssize_t, int32_t> retVal = sender.send(std::move("Hello World!"));
 std::cout << "Send " << retVal.first << " bytes, error code = " << retVal.second << std::endl;
 \endcode
 
+Several packets can be handed over at once by calling the method `send`
+with a `std::vector<std::string>`; every entry is sent as a separate UDP
+packet. On Linux, all packets are passed to the kernel using a single call
+to `sendmmsg`.
+
 A complete example is available
 [here](https://github.com/chrberger/libcluon/blob/master/libcluon/examples/cluon-UDPSender.cpp).
 */
@@ -6328,6 +6719,14 @@ class LIBCLUON_API UDPSender {
      */
     std::pair<ssize_t, int32_t> send(std::string &&data) const noexcept;
 
+    /**
+     * Send a given list of strings; each entry is sent as a separate UDP packet.
+     *
+     * @param data List of data to send.
+     * @return Pair: Number of bytes sent in total and errno of the first failing packet.
+     */
+    std::pair<ssize_t, int32_t> send(std::vector<std::string> &&data) const noexcept;
+
    public:
     /**
      * @return Port that this UDP sender will use for sending or 0 if no information available.
@@ -6342,6 +6741,164 @@ class LIBCLUON_API UDPSender {
 };
 } // namespace cluon
 
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_RECEIVEBUFFERPOOL_HPP
+#define CLUON_RECEIVEBUFFERPOOL_HPP
+
+//#include "cluon/cluon.hpp"
+
+// clang-format off
+#ifdef WIN32
+    #include <Winsock2.h> // for WSAStartUp
+    #include <ws2tcpip.h> // for SOCKET
+#else
+    #include <netinet/in.h>
+#endif
+// clang-format on
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cluon {
+
+class ReceiveBufferPool;
+
+/**
+This class is a reference-counted handle to a received UDP packet whose memory
+is owned by a cluon::ReceiveBufferPool. Copying a ReceiveBuffer only increments
+the reference count; when the last handle is destroyed, the memory is returned
+to its pool to be reused for the next UDP packet.
+
+The human-readable representation of the sender (X.Y.Z.W:ABCD) is only
+formatted when requested by calling the method `from()`.
+*/
+class LIBCLUON_API ReceiveBuffer {
+   private:
+    friend class ReceiveBufferPool;
+
+    struct Block {
+        std::atomic<uint32_t> m_referenceCount{0};
+        std::shared_ptr<ReceiveBufferPool> m_pool{nullptr};
+        std::vector<char> m_data{};
+        struct sockaddr_in m_from {};
+        bool m_fromLocalHost{false};
+        std::chrono::system_clock::time_point m_sampleTime{};
+    };
+
+   public:
+    ReceiveBuffer() = default;
+    ReceiveBuffer(const ReceiveBuffer &other) noexcept;
+    ReceiveBuffer(ReceiveBuffer &&other) noexcept;
+    ReceiveBuffer &operator=(const ReceiveBuffer &other) noexcept;
+    ReceiveBuffer &operator=(ReceiveBuffer &&other) noexcept;
+    ~ReceiveBuffer() noexcept;
+
+    /**
+     * @return true if this handle refers to received data.
+     */
+    bool valid() const noexcept;
+
+    /**
+     * @return Pointer to the received bytes or nullptr.
+     */
+    const char *data() const noexcept;
+
+    /**
+     * @return Number of received bytes.
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @return Human-readable representation of the sender (X.Y.Z.W:ABCD).
+     */
+    std::string from() const noexcept;
+
+    /**
+     * @return Sender of the data.
+     */
+    struct sockaddr_in fromAddress() const noexcept;
+
+    /**
+     * @return true if the data was sent from one of the IP addresses of this host.
+     */
+    bool fromLocalHost() const noexcept;
+
+    /**
+     * @return Time stamp when the data has been received.
+     */
+    std::chrono::system_clock::time_point sampleTime() const noexcept;
+
+   private:
+    explicit ReceiveBuffer(Block *block) noexcept;
+    void release() noexcept;
+
+   private:
+    Block *m_block{nullptr};
+};
+
+/**
+This class manages the memory for cluon::ReceiveBuffers that are handed over
+between the thread reading from a socket and the thread processing the data.
+Released buffers are kept in the pool (up to the given capacity) and reused so
+that no memory is allocated per packet in steady state.
+*/
+class LIBCLUON_API ReceiveBufferPool : public std::enable_shared_from_this<ReceiveBufferPool> {
+   private:
+    ReceiveBufferPool(const ReceiveBufferPool &) = delete;
+    ReceiveBufferPool(ReceiveBufferPool &&)      = delete;
+    ReceiveBufferPool &operator=(const ReceiveBufferPool &) = delete;
+    ReceiveBufferPool &operator=(ReceiveBufferPool &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param capacity Maximum number of unused buffers to keep for reuse.
+     */
+    explicit ReceiveBufferPool(std::size_t capacity = 1024) noexcept;
+    ~ReceiveBufferPool() noexcept;
+
+    /**
+     * This method copies the given data into a buffer from this pool.
+     *
+     * @param data Received bytes.
+     * @param size Number of received bytes.
+     * @param from Sender of the data.
+     * @param sampleTime Time stamp when the data has been received.
+     * @param fromLocalHost true if the data was sent from this host.
+     * @return ReceiveBuffer holding the given data or an invalid ReceiveBuffer if no memory is available.
+     */
+    ReceiveBuffer acquire(const char *data,
+                          std::size_t size,
+                          const struct sockaddr_in &from,
+                          const std::chrono::system_clock::time_point &sampleTime,
+                          bool fromLocalHost = false) noexcept;
+
+   private:
+    friend class ReceiveBuffer;
+    void release(ReceiveBuffer::Block *block) noexcept;
+
+   private:
+    std::mutex m_freeBlocksMutex{};
+    std::size_t m_capacity;
+    std::vector<ReceiveBuffer::Block *> m_freeBlocks{};
+};
+} // namespace cluon
+
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -6355,6 +6912,7 @@ class LIBCLUON_API UDPSender {
 #define CLUON_UDPRECEIVER_HPP
 
 //#include "cluon/NotifyingPipeline.hpp"
+//#include "cluon/ReceiveBufferPool.hpp"
 //#include "cluon/cluon.hpp"
 
 // clang-format off
@@ -6408,7 +6966,20 @@ cluon::UDPReceiver receiver("127.0.0.1", 1234,
     });
 \endcode
 
-After creating an instance of class `cluon::UDPReceiver`, it is immediately
+To avoid copying the received bytes and formatting the sender for every UDP
+packet, a delegate of type `std::function<void(cluon::ReceiveBuffer &&)>` can be
+passed instead. The received bytes are then handed over in a reference-counted
+buffer that is reused for subsequent UDP packets once it is released; the
+sender is only formatted when calling `from()`:
+
+\code{.cpp}
+cluon::UDPReceiver receiver("127.0.0.1", 1234,
+    [](cluon::ReceiveBuffer &&buffer) noexcept {
+        std::cout << "Received " << buffer.size() << " bytes from " << buffer.from() << std::endl;
+    });
+\endcode
+
+After creating an instance of class `cluon::UDPReceiver`, it is immediately
 activated and concurrently waiting for data in a separate thread. To check
 whether the instance was created successfully and running, the method
 `isRunning()` should be called.
@@ -6436,6 +7007,19 @@ class LIBCLUON_API UDPReceiver {
                 uint16_t receiveFromPort,
                 std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
                 uint16_t localSendFromPort = 0) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param receiveFromAddress Numerical IPv4 address to receive UDP packets from.
+     * @param receiveFromPort Port to receive UDP packets from.
+     * @param delegate Functional (noexcept) to handle received bytes passed as pooled cluon::ReceiveBuffer.
+     * @param localSendFromPort Port that an application is using to send data. This port (> 0) is ignored when data is received.
+     */
+    UDPReceiver(const std::string &receiveFromAddress,
+                uint16_t receiveFromPort,
+                std::function<void(cluon::ReceiveBuffer &&)> delegate,
+                uint16_t localSendFromPort = 0) noexcept;
     ~UDPReceiver() noexcept;
 
     /**
@@ -6453,6 +7037,8 @@ class LIBCLUON_API UDPReceiver {
 
     void readFromSocket() noexcept;
 
+    void setUp(const std::string &receiveFromAddress, uint16_t receiveFromPort) noexcept;
+
    private:
     int32_t m_socket{-1};
     bool m_isBlockingSocket{true};
@@ -6467,16 +7053,11 @@ class LIBCLUON_API UDPReceiver {
 
    private:
     std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point)> m_delegate{};
+    std::function<void(cluon::ReceiveBuffer &&)> m_receiveBufferDelegate{};
 
    private:
-    class PipelineEntry {
-       public:
-        std::string m_data;
-        std::string m_from;
-        std::chrono::system_clock::time_point m_sampleTime;
-    };
-
-    std::shared_ptr<cluon::NotifyingPipeline<PipelineEntry>> m_pipeline{};
+    std::shared_ptr<cluon::ReceiveBufferPool> m_receiveBufferPool{};
+    std::shared_ptr<cluon::NotifyingPipeline<cluon::ReceiveBuffer>> m_pipeline{};
 };
 } // namespace cluon
 
@@ -6766,13 +7347,32 @@ namespace cluon {
 //#include "cluon/ProtoConstants.hpp"
 //#include "cluon/cluon.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace cluon {
 /**
-This class encodes a given message in Proto format.
+This class encodes a given message in Proto format into a contiguous buffer
+in a single pass. Nested messages are encoded in place: one byte is reserved
+for their length and the nested message is only moved when its length needs
+more than one byte as VarInt.
+
+The encoded data can be appended to a caller-supplied buffer to avoid any
+intermediate copy; the buffer can be reserved upfront to avoid reallocations:
+
+\code{.cpp}
+std::string buffer;
+buffer.reserve(1024);
+cluon::ToProtoVisitor protoEncoder{buffer};
+protoEncoder.encodeFrom(msg);
+// buffer holds msg in Proto format.
+\endcode
+
+Messages generated by cluon-msc provide encodeProto, which is used by
+encodeFrom to encode all fields with precomputed Proto tags instead of
+visiting them by name.
 */
 class LIBCLUON_API ToProtoVisitor {
    private:
@@ -6782,7 +7382,14 @@ class LIBCLUON_API ToProtoVisitor {
     ToProtoVisitor &operator=(ToProtoVisitor &&) = delete;
 
    public:
-    ToProtoVisitor()  = default;
+    ToProtoVisitor() noexcept;
+
+    /**
+     * Constructor to append the encoded data to a caller-supplied buffer.
+     *
+     * @param buffer Buffer to append to; it must outlive this visitor.
+     */
+    explicit ToProtoVisitor(std::string &buffer) noexcept;
     ~ToProtoVisitor() = default;
 
     /**
@@ -6790,6 +7397,47 @@ class LIBCLUON_API ToProtoVisitor {
      */
     std::string encodedData() const noexcept;
 
+    /**
+     * @return Number of bytes encoded so far.
+     */
+    std::size_t encodedSize() const noexcept;
+
+    /**
+     * This method encodes the given message in Proto format.
+     *
+     * @param v Message to encode.
+     */
+    template <typename T>
+    void encodeFrom(T &v) noexcept {
+        encodeMessage(v, std::integral_constant<bool, isProtoCodec<typename std::remove_cv<T>::type>::value>{});
+    }
+
+   public:
+    // The following methods are provided to allow messages generated by cluon-msc
+    // to encode their fields with precomputed Proto tags from encodeProto.
+
+    void encodeField(uint64_t tag, bool v) noexcept;
+    void encodeField(uint64_t tag, char v) noexcept;
+    void encodeField(uint64_t tag, int8_t v) noexcept;
+    void encodeField(uint64_t tag, uint8_t v) noexcept;
+    void encodeField(uint64_t tag, int16_t v) noexcept;
+    void encodeField(uint64_t tag, uint16_t v) noexcept;
+    void encodeField(uint64_t tag, int32_t v) noexcept;
+    void encodeField(uint64_t tag, uint32_t v) noexcept;
+    void encodeField(uint64_t tag, int64_t v) noexcept;
+    void encodeField(uint64_t tag, uint64_t v) noexcept;
+    void encodeField(uint64_t tag, float v) noexcept;
+    void encodeField(uint64_t tag, double v) noexcept;
+    void encodeField(uint64_t tag, const std::string &v) noexcept;
+
+    template <typename T>
+    void encodeField(uint64_t tag, const T &value) noexcept {
+        toVarInt(tag);
+        const std::size_t POSITION_OF_LENGTH{beginLengthDelimited()};
+        value.encodeProto(*this);
+        endLengthDelimited(POSITION_OF_LENGTH);
+    }
+
    public:
     // The following methods are provided to allow an instance of this class to
     // be used as visitor for an instance with the method signature void accept<T>(T&);
@@ -6816,25 +7464,53 @@ class LIBCLUON_API ToProtoVisitor {
         (void)typeName;
         (void)name;
 
-        toVarInt(m_buffer, std::move(encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED))));
-        cluon::ToProtoVisitor nestedProtoEncoder;
-        value.accept(nestedProtoEncoder);
-        encode(m_buffer, std::move(nestedProtoEncoder.encodedData()));
+        toVarInt(encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED)));
+        const std::size_t POSITION_OF_LENGTH{beginLengthDelimited()};
+        encodeMessage(value, std::integral_constant<bool, isProtoCodec<T>::value>{});
+        endLengthDelimited(POSITION_OF_LENGTH);
+    }
+
+   private:
+    template <typename T>
+    void encodeMessage(T &v, std::true_type) noexcept {
+        v.encodeProto(*this);
+    }
+
+    template <typename T>
+    void encodeMessage(T &v, std::false_type) noexcept {
+        v.accept(*this);
     }
 
    private:
-    std::size_t encode(std::ostream &o, bool &v) noexcept;
-    std::size_t encode(std::ostream &o, int8_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint8_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int16_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint16_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int32_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint32_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int64_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint64_t &v) noexcept;
-    std::size_t encode(std::ostream &o, float &v) noexcept;
-    std::size_t encode(std::ostream &o, double &v) noexcept;
-    std::size_t encode(std::ostream &o, const std::string &v) noexcept;
+    std::size_t encode(bool &v) noexcept;
+    std::size_t encode(int8_t &v) noexcept;
+    std::size_t encode(uint8_t &v) noexcept;
+    std::size_t encode(int16_t &v) noexcept;
+    std::size_t encode(uint16_t &v) noexcept;
+    std::size_t encode(int32_t &v) noexcept;
+    std::size_t encode(uint32_t &v) noexcept;
+    std::size_t encode(int64_t &v) noexcept;
+    std::size_t encode(uint64_t &v) noexcept;
+    std::size_t encode(float &v) noexcept;
+    std::size_t encode(double &v) noexcept;
+    std::size_t encode(const std::string &v) noexcept;
+
+    /**
+     * This method reserves one byte for the length of a nested message.
+     *
+     * @return Position of the reserved byte.
+     */
+    std::size_t beginLengthDelimited() noexcept;
+
+    /**
+     * This method writes the length of a nested message that was encoded
+     * after the reserved byte at the given position.
+     *
+     * @param positionOfLength Position of the reserved byte.
+     */
+    void endLengthDelimited(std::size_t positionOfLength) noexcept;
+
+    void append(const char *data, std::size_t size) noexcept;
 
    private:
     uint8_t toZigZag8(int8_t v) noexcept;
@@ -6845,11 +7521,19 @@ class LIBCLUON_API ToProtoVisitor {
     /**
      * This method encodes a given value in VarInt.
      *
-     * @param out std::ostream to encode to.
      * @param v Value to encode.
      * @return Bytes written.
      */
-    std::size_t toVarInt(std::ostream &out, uint64_t v) noexcept;
+    std::size_t toVarInt(uint64_t v) noexcept;
+
+    /**
+     * This method encodes a given value in VarInt.
+     *
+     * @param out Buffer with at least 10 bytes to encode to.
+     * @param v Value to encode.
+     * @return Bytes written.
+     */
+    static std::size_t toVarInt(char *out, uint64_t v) noexcept;
 
     /**
      * This method creates a key/value pair encoded in Proto format.
@@ -6862,8 +7546,8 @@ class LIBCLUON_API ToProtoVisitor {
     std::size_t toKeyValue(uint32_t fieldIdentifier, T &v) noexcept {
         std::size_t size{0};
         uint64_t key = encodeKey(fieldIdentifier, static_cast<uint8_t>(ProtoConstants::VARINT));
-        size += toVarInt(m_buffer, key);
-        size += encode(m_buffer, v);
+        size += toVarInt(key);
+        size += encode(v);
         return size;
     }
 
@@ -6877,7 +7561,9 @@ class LIBCLUON_API ToProtoVisitor {
     uint64_t encodeKey(uint32_t fieldIdentifier, uint8_t protoType) noexcept;
 
    private:
-    std::stringstream m_buffer{""};
+    std::string m_ownBuffer{};
+    std::string &m_buffer;
+    std::size_t m_start{0};
 };
 } // namespace cluon
 
@@ -6900,16 +7586,34 @@ class LIBCLUON_API ToProtoVisitor {
 #include <cstdint>
 #include <cstddef>
 #include <array>
-#include <sstream>
+#include <istream>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
-#include <vector>
 
 namespace cluon {
 /**
 This class decodes a given message from Proto format.
+
+Length-delimited fields (strings, bytes, and nested messages) are not copied
+while decoding; instead, they refer to the bytes in the source buffer and are
+only materialized when visiting the receiving data structure. Thus, the buffer
+passed to decodeFrom(const char*, std::size_t) must outlive any subsequent
+visit of this instance.
+
+Messages generated by cluon-msc provide decodeProto, which is used by
+decodeFrom(const char*, std::size_t, T&) to assign the fields by their Proto
+tags instead of visiting them by name.
 */
 class LIBCLUON_API FromProtoVisitor {
+   private:
+    // Non-owning reference to a length-delimited field in the source buffer.
+    struct Bytes {
+        const char *data{nullptr};
+        std::size_t size{0};
+    };
+
    private:
     FromProtoVisitor(const FromProtoVisitor &) = delete;
     FromProtoVisitor(FromProtoVisitor &&)      = delete;
@@ -6929,6 +7633,50 @@ class LIBCLUON_API FromProtoVisitor {
      */
     void decodeFrom(std::istream &in) noexcept;
 
+    /**
+     * This method decodes Proto-encoded bytes from memory without copying them.
+     *
+     * @param data Pointer to the Proto-encoded bytes; must outlive the visit.
+     * @param size Number of bytes available at data.
+     */
+    void decodeFrom(const char *data, std::size_t size) noexcept;
+
+   public:
+    // The following methods are provided to allow messages generated by cluon-msc
+    // to decode their fields by Proto tag from decodeProto.
+
+    /**
+     * This method decodes the next field from the buffer passed to decodeFrom.
+     *
+     * @return true if a field was decoded; its value is assigned by decodeField.
+     */
+    bool nextField() noexcept;
+
+    /**
+     * @return Proto tag ((field identifier << 3) | wire type) of the current field.
+     */
+    uint64_t fieldTag() const noexcept;
+
+    void decodeField(bool &v) noexcept;
+    void decodeField(char &v) noexcept;
+    void decodeField(int8_t &v) noexcept;
+    void decodeField(uint8_t &v) noexcept;
+    void decodeField(int16_t &v) noexcept;
+    void decodeField(uint16_t &v) noexcept;
+    void decodeField(int32_t &v) noexcept;
+    void decodeField(uint32_t &v) noexcept;
+    void decodeField(int64_t &v) noexcept;
+    void decodeField(uint64_t &v) noexcept;
+    void decodeField(float &v) noexcept;
+    void decodeField(double &v) noexcept;
+    void decodeField(std::string &v) noexcept;
+
+    template <typename T>
+    void decodeField(T &v) noexcept {
+        cluon::FromProtoVisitor nestedProtoDecoder;
+        nestedProtoDecoder.decodeFrom(m_bytes.data, m_bytes.size, v);
+    }
+
    public:
     // The following methods are provided to allow an instance of this class to
     // be used as visitor for an instance with the method signature void accept<T>(T&);
@@ -6956,15 +7704,13 @@ class LIBCLUON_API FromProtoVisitor {
         (void)name;
 
         if (m_callToDecodeFromWithDirectVisit) {
-            std::stringstream sstr{std::move(std::string(m_stringValue.data(), static_cast<std::size_t>(m_value)))};
-            cluon::FromProtoVisitor nestedProtoDecoder;
-            nestedProtoDecoder.decodeFrom(sstr, v);
+            decodeField(v);
         }
         else if (0 < m_mapOfKeyValues.count(id)) {
             try {
-                std::stringstream sstr{linb::any_cast<std::string>(m_mapOfKeyValues[id])};
+                const Bytes bytes{linb::any_cast<Bytes>(m_mapOfKeyValues[id])};
                 cluon::FromProtoVisitor nestedProtoDecoder;
-                nestedProtoDecoder.decodeFrom(sstr);
+                nestedProtoDecoder.decodeFrom(bytes.data, bytes.size);
                 v.accept(nestedProtoDecoder);
             } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
             }
@@ -6980,48 +7726,38 @@ class LIBCLUON_API FromProtoVisitor {
      */
     template<typename T>
     void decodeFrom(std::istream &in, T &v) noexcept {
+        readFromStream(in);
+        if (m_ownedData) {
+            decodeFrom(m_ownedData->data(), m_ownedData->size(), v);
+        }
+    }
+
+    /**
+     * This method decodes Proto-encoded bytes from memory into corresponding
+     * fields of v without copying them to an intermediate buffer.
+     *
+     * @param data Pointer to the Proto-encoded bytes.
+     * @param size Number of bytes available at data.
+     * @param v Data structure to receive the decoded values.
+     */
+    template<typename T>
+    void decodeFrom(const char *data, std::size_t size, T &v) noexcept {
+        m_position = data;
+        m_end      = (nullptr != data) ? data + size : data;
+        decodeMessage(v, std::integral_constant<bool, isProtoCodec<T>::value>{});
+    }
+
+   private:
+    template <typename T>
+    void decodeMessage(T &v, std::true_type) noexcept {
+        v.decodeProto(*this);
+    }
+
+    template <typename T>
+    void decodeMessage(T &v, std::false_type) noexcept {
         m_callToDecodeFromWithDirectVisit = true;
-        while (in.good()) {
-            // First stage: Read keyFieldType (encoded as VarInt).
-            if (0 < fromVarInt(in, m_keyFieldType)) {
-                // Succeeded to read keyFieldType entry; extract information.
-                m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
-                m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
-                switch (m_protoType) {
-                    case ProtoConstants::VARINT:
-                    {
-                        // Directly decode VarInt value.
-                        fromVarInt(in, m_value);
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                    case ProtoConstants::EIGHT_BYTES:
-                    {
-                        readBytesFromStream(in, sizeof(double), m_doubleValue.buffer.data());
-                        m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                    case ProtoConstants::FOUR_BYTES:
-                    {
-                        readBytesFromStream(in, sizeof(float), m_floatValue.buffer.data());
-                        m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                    case ProtoConstants::LENGTH_DELIMITED:
-                    {
-                        fromVarInt(in, m_value);
-                        const std::size_t BYTES_TO_READ_FROM_STREAM{static_cast<std::size_t>(m_value)};
-                        if (m_stringValue.capacity() < BYTES_TO_READ_FROM_STREAM) {
-                            m_stringValue.reserve(BYTES_TO_READ_FROM_STREAM);
-                        }
-                        readBytesFromStream(in, BYTES_TO_READ_FROM_STREAM, m_stringValue.data());
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                }
-            }
+        while (nextField()) {
+            v.accept(m_fieldId, *this);
         }
         m_callToDecodeFromWithDirectVisit = false;
     }
@@ -7032,9 +7768,17 @@ class LIBCLUON_API FromProtoVisitor {
     int32_t fromZigZag32(uint32_t v) noexcept;
     int64_t fromZigZag64(uint64_t v) noexcept;
 
-    std::size_t fromVarInt(std::istream &in, uint64_t &value) noexcept;
+    /**
+     * This method decodes the next key/value pair between position and end
+     * into m_fieldId, m_protoType, and the corresponding value member.
+     *
+     * @return true if a complete field was decoded; false on truncated or malformed data.
+     */
+    bool readField(const char *&position, const char *end) noexcept;
+    std::size_t fromVarInt(const char *&position, const char *end, uint64_t &value) noexcept;
+    void decode(const char *data, std::size_t size) noexcept;
+    void readFromStream(std::istream &in) noexcept;
 
-    void readBytesFromStream(std::istream &in, std::size_t bytesToReadFromStream, char *buffer) noexcept;
 
    private:
     // This Boolean flag indicates whether we consecutively decode from istream
@@ -7042,6 +7786,9 @@ class LIBCLUON_API FromProtoVisitor {
     bool m_callToDecodeFromWithDirectVisit{false};
     std::unordered_map<uint32_t, linb::any, UseUInt32ValueAsHashKey> m_mapOfKeyValues{};
 
+    // Bytes read from an istream that are referred to from m_mapOfKeyValues.
+    std::shared_ptr<const std::string> m_ownedData{nullptr};
+
    private:
     // Fields necessary to decode from an istream.
     uint64_t m_value{0};
@@ -7060,8 +7807,12 @@ class LIBCLUON_API FromProtoVisitor {
         float floatValue{0};
     } m_floatValue;
 
-    // Buffer for strings.
-    std::vector<char> m_stringValue;
+    // Length-delimited value referring into the source buffer.
+    Bytes m_bytes{};
+
+    // Remaining bytes to decode with nextField.
+    const char *m_position{nullptr};
+    const char *m_end{nullptr};
 
     uint64_t m_keyFieldType{0};
     ProtoConstants m_protoType{ProtoConstants::VARINT};
@@ -7503,7 +8254,6 @@ class LIBCLUON_API FromJSONVisitor {
 
 #include <cstdint>
 #include <map>
-#include <sstream>
 #include <string>
 
 namespace cluon {
@@ -7519,6 +8269,22 @@ msg.accept(j);
 
 std::cout << j.json() << std::endl;
 \endcode
+
+To stream many messages without intermediate copies, the JSON representation
+can be appended directly to a caller-provided buffer, which can be flushed to
+a file whenever it has grown large enough:
+
+\code{.cpp}
+std::string buffer;
+for (auto &msg : messages) {
+    cluon::ToJSONVisitor j{buffer};
+    msg.accept(j);
+    buffer += '\n';
+}
+\endcode
+
+Floating point values are rendered with the shortest representation that
+reads back into the identical float or double, respectively.
 */
 class LIBCLUON_API ToJSONVisitor {
    private:
@@ -7538,6 +8304,20 @@ class LIBCLUON_API ToJSONVisitor {
      */
     ToJSONVisitor(bool withOuterCurlyBraces = true, const std::map<uint32_t, bool> &mask = {}) noexcept;
 
+    /**
+     * Constructor to append the JSON representation of the visited message
+     * to the given buffer; the representation is completed when the visited
+     * message calls postVisit() at the end of its accept method. Without
+     * outer curly braces, a message without fields appends nothing.
+     *
+     * @param buffer to append the JSON-encoded data to.
+     * @param withOuterCurlyBraces Include the outer curly braces.
+     * @param mask Map describing which fields to render. If empty, all
+     *             fields will be emitted; individual field identifiers
+     *             can be masked setting them to false.
+     */
+    explicit ToJSONVisitor(std::string &buffer, bool withOuterCurlyBraces = true, const std::map<uint32_t, bool> &mask = {}) noexcept;
+
     /**
      * @return JSON-encoded data.
      */
@@ -7567,12 +8347,21 @@ class LIBCLUON_API ToJSONVisitor {
     template <typename T>
     void visit(uint32_t &id, std::string &&typeName, std::string &&name, T &value) noexcept {
         (void)typeName;
-        if ((0 == m_mask.count(id)) || m_mask[id]) {
+        if (isRendered(id)) {
+            const std::size_t BEFORE{m_buffer.size()};
             try {
-                ToJSONVisitor jsonVisitor;
-                value.accept(jsonVisitor);
-                m_buffer << '\"' << name << '\"' << ':' << jsonVisitor.json() << ',' << '\n';
+                // Render the nested message in place; masks apply to the outermost message only.
+                appendKey(name);
+                m_buffer += '{';
+                const std::size_t BEGIN{m_buffer.size()};
+                m_nesting++;
+                value.accept(*this);
+                m_nesting--;
+                closeObject(BEGIN);
+                m_buffer += ",\n";
             } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+                m_nesting--;                       // LCOV_EXCL_LINE
+                m_buffer.resize(BEFORE);           // LCOV_EXCL_LINE
             }
         }
     }
@@ -7586,10 +8375,23 @@ class LIBCLUON_API ToJSONVisitor {
      */
     static std::string encodeBase64(const std::string &input) noexcept;
 
+   private:
+    bool isRendered(uint32_t id) noexcept;
+    void appendKey(const std::string &name) noexcept;
+    void appendUnsigned(uint64_t v) noexcept;
+    void appendSigned(int64_t v) noexcept;
+    template <typename T>
+    void appendFloatingPoint(T v) noexcept;
+    void closeObject(std::size_t begin) noexcept;
+
    private:
     bool m_withOuterCurlyBraces{true};
     std::map<uint32_t, bool> m_mask;
-    std::stringstream m_buffer{};
+    std::string m_data{};
+    std::string &m_buffer;
+    bool m_appendToBuffer{false};
+    std::size_t m_begin{0};
+    uint32_t m_nesting{0};
 };
 
 } // namespace cluon
@@ -8012,12 +8814,78 @@ class LIBCLUON_API ToMsgPackVisitor {
 //#include "cluon/ToProtoVisitor.hpp"
 //#include "cluon/cluonDataStructures.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstring>
 #include <istream>
 #include <sstream>
 #include <string>
 #include <utility>
-#include <vector>
+
+namespace cluon {
+/**
+ * This class decodes all fields of a Proto-encoded Envelope besides
+ * serializedData so that the meta data of an Envelope can be read
+ * without copying its payload.
+ */
+class LIBCLUON_API EnvelopeMetaDataDecoder {
+   private:
+    enum : uint64_t { SERIALIZED_DATA_PROTO_TAG = 18u };
+
+   private:
+    EnvelopeMetaDataDecoder(const EnvelopeMetaDataDecoder &) = delete;
+    EnvelopeMetaDataDecoder(EnvelopeMetaDataDecoder &&)      = delete;
+    EnvelopeMetaDataDecoder &operator=(const EnvelopeMetaDataDecoder &) = delete;
+    EnvelopeMetaDataDecoder &operator=(EnvelopeMetaDataDecoder &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param envelope Envelope to receive the decoded fields.
+     */
+    explicit EnvelopeMetaDataDecoder(cluon::data::Envelope &envelope) noexcept
+        : m_envelope(envelope) {}
+
+    /**
+     * This method is called from cluon::FromProtoVisitor::decodeFrom.
+     *
+     * @param decoder Decoder providing the fields of the Envelope.
+     */
+    void decodeProto(cluon::FromProtoVisitor &decoder) noexcept {
+        m_decoder = &decoder;
+        m_envelope.decodeProto(*this);
+        m_decoder = nullptr;
+    }
+
+    bool nextField() noexcept {
+        while (m_decoder->nextField()) {
+            if (SERIALIZED_DATA_PROTO_TAG != m_decoder->fieldTag()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t fieldTag() const noexcept {
+        return m_decoder->fieldTag();
+    }
+
+    template <typename T>
+    void decodeField(T &v) noexcept {
+        m_decoder->decodeField(v);
+    }
+
+   private:
+    cluon::data::Envelope &m_envelope;
+    cluon::FromProtoVisitor *m_decoder{nullptr};
+};
+} // namespace cluon
+
+template <>
+struct isProtoCodec<cluon::EnvelopeMetaDataDecoder> {
+    static const bool value = true;
+};
 
 namespace cluon {
 
@@ -8029,37 +8897,88 @@ namespace cluon {
  * @return String representation of the Envelope to be sent to OpenDaVINCI v4.
  */
 inline std::string serializeEnvelope(cluon::data::Envelope &&envelope) noexcept {
-    std::string dataToSend;
-    {
-        std::stringstream sstr;
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    // Upper bound for the Proto-encoded fields of an Envelope besides the
+    // payload: three TimeStamps (14 bytes each), dataType, senderStamp, and
+    // the key and length of serializedData (6 bytes each).
+    constexpr std::size_t MAX_ENVELOPE_OVERHEAD{3 * 14 + 3 * 6};
 
-        cluon::ToProtoVisitor protoEncoder;
-        envelope.accept(protoEncoder);
+    std::string dataToSend;
+    try {
+        // Encode OD4 header and Envelope into a single allocation.
+        dataToSend.reserve(OD4_HEADER_SIZE + MAX_ENVELOPE_OVERHEAD + envelope.serializedData().size());
+        dataToSend.append(OD4_HEADER_SIZE, '\0');
+        {
+            cluon::ToProtoVisitor protoEncoder{dataToSend};
+            protoEncoder.encodeFrom(envelope);
+        }
 
-        const std::string tmp{protoEncoder.encodedData()};
-        uint32_t length{static_cast<uint32_t>(tmp.size())};
+        uint32_t length{static_cast<uint32_t>(dataToSend.size() - OD4_HEADER_SIZE)};
         length <<= 8;
         length = htole32(length);
 
-        // Add OD4 header.
+        // Add OD4 header in place: 0x0D 0xA4 LEN0 LEN1 LEN2, with 0xA4 overwriting the least significant byte of the shifted length.
         constexpr unsigned char OD4_HEADER_BYTE0 = 0x0D;
         constexpr unsigned char OD4_HEADER_BYTE1 = 0xA4;
-        sstr.put(static_cast<char>(OD4_HEADER_BYTE0));
-        auto posByte1 = sstr.tellp();
-        sstr.write(reinterpret_cast<char *>(&length), static_cast<std::streamsize>(sizeof(uint32_t)));
-        auto posByte5 = sstr.tellp();
-        sstr.seekp(posByte1);
-        sstr.put(static_cast<char>(OD4_HEADER_BYTE1));
-        sstr.seekp(posByte5);
-
-        // Write payload.
-        sstr.write(tmp.data(), static_cast<std::streamsize>(tmp.size()));
-
-        dataToSend = sstr.str();
+        std::memcpy(&dataToSend[1], &length, sizeof(uint32_t));
+        dataToSend[0] = static_cast<char>(OD4_HEADER_BYTE0);
+        dataToSend[1] = static_cast<char>(OD4_HEADER_BYTE1);
+    } catch (...) { // LCOV_EXCL_LINE
+        dataToSend.clear(); // LCOV_EXCL_LINE
     }
     return dataToSend;
 }
 
+/**
+ * This method extracts an Envelope from the given memory that holds bytes in
+ * format:
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * 0xA4 LEN0 LEN1 LEN2 are little Endian. The bytes are decoded in place
+ * without copying them into an intermediate buffer.
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @param consumed Number of bytes that belong to the extracted Envelope.
+ * @return cluon::data::Envelope.
+ */
+inline std::pair<bool, cluon::data::Envelope> extractEnvelope(const char *data, std::size_t size, std::size_t &consumed) noexcept {
+    bool retVal{false};
+    cluon::data::Envelope env;
+    consumed = 0;
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    if ((nullptr != data) && (OD4_HEADER_SIZE <= size)) {
+        if ((0x0D == static_cast<uint8_t>(data[0])) && (0xA4 == static_cast<uint8_t>(data[1]))) {
+            uint32_t length{0};
+            std::memcpy(&length, data + 1, sizeof(uint32_t));
+            const uint32_t LENGTH{le32toh(length) >> 8};
+            if (LENGTH <= (size - OD4_HEADER_SIZE)) {
+                cluon::FromProtoVisitor protoDecoder;
+                protoDecoder.decodeFrom(data + OD4_HEADER_SIZE, LENGTH, env);
+                consumed = OD4_HEADER_SIZE + LENGTH;
+                retVal   = true;
+            }
+        }
+    }
+    return std::make_pair(retVal, env);
+}
+
+/**
+ * This method extracts an Envelope from the given memory that holds bytes in
+ * format:
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @return cluon::data::Envelope.
+ */
+inline std::pair<bool, cluon::data::Envelope> extractEnvelope(const char *data, std::size_t size) noexcept {
+    std::size_t consumed{0};
+    return extractEnvelope(data, size, consumed);
+}
+
 /**
  * This method extracts an Envelope from the given istream that holds bytes in
  * format:
@@ -8076,41 +8995,23 @@ inline std::pair<bool, cluon::data::Envelope> extractEnvelope(std::istream &in)
     cluon::data::Envelope env;
     if (in.good()) {
         constexpr uint8_t OD4_HEADER_SIZE{5};
-        std::vector<char> buffer;
-        buffer.reserve(OD4_HEADER_SIZE);
-#ifdef WIN32                                           // LCOV_EXCL_LINE
-        buffer.clear();                                // LCOV_EXCL_LINE
-        retVal = true;                                 // LCOV_EXCL_LINE
-        for (uint8_t i{0}; i < OD4_HEADER_SIZE; i++) { // LCOV_EXCL_LINE
-            char c;                                    // LCOV_EXCL_LINE
-            in.get(c);                                 // LCOV_EXCL_LINE
-            retVal &= in.good();                       // LCOV_EXCL_LINE
-            buffer.push_back(c);                       // LCOV_EXCL_LINE
-        }
-        if (retVal) { // LCOV_EXCL_LINE
-#else                 // LCOV_EXCL_LINE
-        in.read(&buffer[0], OD4_HEADER_SIZE);
+        std::array<char, OD4_HEADER_SIZE> header;
+        in.read(header.data(), OD4_HEADER_SIZE); // Flawfinder: ignore
         if (OD4_HEADER_SIZE == in.gcount()) {
-#endif
-            if ((0x0D == static_cast<uint8_t>(buffer[0])) && (0xA4 == static_cast<uint8_t>(buffer[1]))) {
-                const uint32_t LENGTH{le32toh(*reinterpret_cast<uint32_t *>(&buffer[1])) >> 8};
-                buffer.reserve(LENGTH);
-#ifdef WIN32                                           // LCOV_EXCL_LINE
-                buffer.clear();                        // LCOV_EXCL_LINE
-                for (uint32_t i{0}; i < LENGTH; i++) { // LCOV_EXCL_LINE
-                    char c;                            // LCOV_EXCL_LINE
-                    in.get(c);                         // LCOV_EXCL_LINE
-                    retVal &= in.good();               // LCOV_EXCL_LINE
-                    buffer.push_back(c);               // LCOV_EXCL_LINE
-                }
-#else // LCOV_EXCL_LINE
-                in.read(&buffer[0], static_cast<std::streamsize>(LENGTH));
-                retVal = static_cast<int32_t>(LENGTH) == in.gcount();
-#endif
-                if (retVal) {
-                    std::stringstream sstr(std::string(buffer.begin(), buffer.begin() + static_cast<std::streamsize>(LENGTH)));
-                    cluon::FromProtoVisitor protoDecoder;
-                    protoDecoder.decodeFrom(sstr, env);
+            if ((0x0D == static_cast<uint8_t>(header[0])) && (0xA4 == static_cast<uint8_t>(header[1]))) {
+                uint32_t length{0};
+                std::memcpy(&length, header.data() + 1, sizeof(uint32_t));
+                const uint32_t LENGTH{le32toh(length) >> 8};
+                try {
+                    std::string buffer(LENGTH, '\0');
+                    in.read(&buffer[0], static_cast<std::streamsize>(LENGTH)); // Flawfinder: ignore
+                    retVal = static_cast<std::streamsize>(LENGTH) == in.gcount();
+                    if (retVal) {
+                        cluon::FromProtoVisitor protoDecoder;
+                        protoDecoder.decodeFrom(buffer.data(), buffer.size(), env);
+                    }
+                } catch (...) { // LCOV_EXCL_LINE
+                    retVal = false; // LCOV_EXCL_LINE
                 }
             }
         }
@@ -8118,121 +9019,54 @@ inline std::pair<bool, cluon::data::Envelope> extractEnvelope(std::istream &in)
     return std::make_pair(retVal, env);
 }
 
+/**
+ * This method extracts an Envelope without its payload from the given memory
+ * that holds bytes in the same format as for extractEnvelope. The payload is
+ * skipped by its length and serializedData of the returned Envelope is empty.
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @param consumed Number of bytes that belong to the Envelope including its payload.
+ * @return cluon::data::Envelope without serializedData.
+ */
+inline std::pair<bool, cluon::data::Envelope> extractEnvelopeMetaData(const char *data, std::size_t size, std::size_t &consumed) noexcept {
+    bool retVal{false};
+    cluon::data::Envelope env;
+    consumed = 0;
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    if ((nullptr != data) && (OD4_HEADER_SIZE <= size)) {
+        if ((0x0D == static_cast<uint8_t>(data[0])) && (0xA4 == static_cast<uint8_t>(data[1]))) {
+            uint32_t length{0};
+            std::memcpy(&length, data + 1, sizeof(uint32_t));
+            const uint32_t LENGTH{le32toh(length) >> 8};
+            if (LENGTH <= (size - OD4_HEADER_SIZE)) {
+                cluon::EnvelopeMetaDataDecoder metaDataDecoder{env};
+                cluon::FromProtoVisitor protoDecoder;
+                protoDecoder.decodeFrom(data + OD4_HEADER_SIZE, LENGTH, metaDataDecoder);
+                consumed = OD4_HEADER_SIZE + LENGTH;
+                retVal   = true;
+            }
+        }
+    }
+    return std::make_pair(retVal, env);
+}
+
 /**
  * @return Extract a given Envelope's payload into the desired type.
  */
 template <typename T>
 inline T extractMessage(cluon::data::Envelope &&envelope) noexcept {
+    T msg;
+
+    const std::string &serializedData{envelope.serializedData()};
     cluon::FromProtoVisitor decoder;
+    decoder.decodeFrom(serializedData.data(), serializedData.size(), msg);
 
-    std::stringstream sstr(envelope.serializedData());
-    decoder.decodeFrom(sstr);
-
-    T msg;
-    msg.accept(decoder);
-
-    return msg;
-}
+    return msg;
+}
 
 } // namespace cluon
 
-#endif
-/*
- * Copyright (C) 2017-2018  Christian Berger
- *
- * This Source Code Form is subject to the terms of the Mozilla Public
- * License, v. 2.0. If a copy of the MPL was not distributed with this
- * file, You can obtain one at http://mozilla.org/MPL/2.0/.
- */
-
-#ifndef CLUON_ENVELOPECONVERTER_HPP
-#define CLUON_ENVELOPECONVERTER_HPP
-
-//#include "cluon/MetaMessage.hpp"
-//#include "cluon/cluon.hpp"
-//#include "cluon/cluonDataStructures.hpp"
-
-#include <cstdint>
-#include <map>
-#include <string>
-#include <vector>
-
-namespace cluon {
-/**
-This class provides various conversion functions to and from Envelope data structures.
-*/
-class LIBCLUON_API EnvelopeConverter {
-   private:
-    EnvelopeConverter(const EnvelopeConverter &) = delete;
-    EnvelopeConverter(EnvelopeConverter &&)      = delete;
-    EnvelopeConverter &operator=(const EnvelopeConverter &) = delete;
-    EnvelopeConverter &operator=(EnvelopeConverter &&) = delete;
-
-   public:
-    EnvelopeConverter() = default;
-
-    /**
-     * This method sets the message specification to be used for
-     * interpreting a given Proto-encoded Envelope.
-     *
-     * @param ms Message specification following the ODVD format.
-     * @return -1 in case of invalid message specification; otherwise, number
-     *         of successfully parsed messages from given message specification.
-     */
-    int32_t setMessageSpecification(const std::string &ms) noexcept;
-
-    /**
-     * This method transforms the given Proto-encoded Envelope to JSON. The
-     * Proto-encoded envelope might be preceded with a 5-bytes OD4-header (optional).
-     *
-     * @param protoEncodedEnvelope Proto-encoded Envelope.
-     * @return JSON representation from given Proto-encoded Envelope using the
-     *         given message specification.
-     */
-    std::string getJSONFromProtoEncodedEnvelope(const std::string &protoEncodedEnvelope) noexcept;
-
-    /**
-     * This method transforms the given Envelope to JSON.
-     *
-     * @param envelope Envelope.
-     * @return JSON representation from given Envelope using the given message specification.
-     */
-    std::string getJSONFromEnvelope(cluon::data::Envelope &envelope) noexcept;
-
-    /**
-     * This method transforms a given JSON representation into a Proto-encoded Envelope
-     * including the prepended OD4-header.
-     *
-     * @param json representation according to the given message specification.
-     * @param messageIdentifier The given JSON representation shall be interpreted
-     *        as the specified message.
-     * @param senderStamp to be used in the Envelope.
-     * @return Proto-encoded Envelope including OD4-header or empty string.
-     */
-    std::string getProtoEncodedEnvelopeFromJSONWithoutTimeStamps(const std::string &json, int32_t messageIdentifier, uint32_t senderStamp) noexcept;
-
-    /**
-     * This method transforms a given JSON representation into a Proto-encoded Envelope
-     * including the prepended OD4-header and setting cluon::time::now() as sampleTimeStamp.
-     *
-     * @param json representation according to the given message specification.
-     * @param messageIdentifier The given JSON representation shall be interpreted
-     *        as the specified message.
-     * @param senderStamp to be used in the Envelope.
-     * @return Proto-encoded Envelope including OD4-header or empty string.
-     */
-    std::string getProtoEncodedEnvelopeFromJSON(const std::string &json, int32_t messageIdentifier, uint32_t senderStamp) noexcept;
-
-   private:
-// clang-format off
-    std::string getProtoEncodedEnvelopeFromJSON(const std::string &json, int32_t messageIdentifier, uint32_t senderStamp, cluon::data::TimeStamp sampleTimeStamp) noexcept;
-// clang-format on
-
-   private:
-    std::vector<cluon::MetaMessage> m_listOfMetaMessages{};
-    std::map<int32_t, cluon::MetaMessage> m_scopeOfMetaMessages{};
-};
-} // namespace cluon
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -8247,11 +9081,12 @@ class LIBCLUON_API EnvelopeConverter {
 
 //#include "cluon/FromProtoVisitor.hpp"
 //#include "cluon/MetaMessage.hpp"
-//#include "cluon/any/any.hpp"
 //#include "cluon/cluon.hpp"
 //#include "cluon/cluonDataStructures.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -8261,8 +9096,9 @@ namespace cluon {
 GenericMessage is providing an abstraction level to work with concrete
 messages. Therefore, it is acting as both, a Visitor to turn concrete
 messages into GenericMessages or as Visitable to access the contained
-data. GenericMessage would use C++'s std::any type; to allow C++14
-compilers, we use the backport from linb::any.
+data. The values are stored in flat arrays per type; the layout of these
+arrays is derived once when creating a GenericMessage and is shared by
+all its copies.
 
 Creating a GenericMessage:
 There are several ways to create a GenericMessage. The first option is to
@@ -8283,9 +9119,8 @@ GenericMessage's actual values.
 \code{.cpp}
 // protoEncodedData is provided from somewhere, i.e., via network for example
 std::string protoEncodedData = <...>
-std::stringstream sstr{protoEncodedData};
 cluon::FromProtoVisitor protoDecoder;
-protoDecoder.decodeFrom(sstr);
+protoDecoder.decodeFrom(protoEncodedData.data(), protoEncodedData.size());
 
 const char *messageSpecification = R"(
 message MyMessage [id = 123] {
@@ -8304,6 +9139,18 @@ if (cluon::MessageParser::MessageParserErrorCodes::NO_MESSAGEPARSER_ERROR == ret
 }
 \endcode
 
+   When decoding many messages of the same type, the GenericMessage should
+   be created only once from its MetaMessage and copied for every message
+   to be decoded; the Proto-encoded data is then decoded directly along the
+   GenericMessage's layout:
+
+\code{.cpp}
+// gm is created from MyMessage's MetaMessage as shown above.
+cluon::GenericMessage msg{gm};
+cluon::FromProtoVisitor protoDecoder;
+protoDecoder.decodeFrom(protoEncodedData.data(), protoEncodedData.size(), msg);
+\endcode
+
 
 2) This example demonstrates how to turn a given concrete message into a
    GenericMessage. Afterwards, the GenericMessage can be post-processed
@@ -8378,9 +9225,8 @@ std::cout << j.json();
 \code{.cpp}
 // protoEncodedData is provided from somewhere, i.e., via network for example
 std::string protoEncodedData = <...>
-std::stringstream sstr{protoEncodedData};
 cluon::FromProtoVisitor protoDecoder;
-protoDecoder.decodeFrom(sstr);
+protoDecoder.decodeFrom(protoEncodedData.data(), protoEncodedData.size());
 
 const char *messageSpecification = R"(
 message MyMessage [id = 123] {
@@ -8405,6 +9251,66 @@ std::cout << j.json();
 */
 class LIBCLUON_API GenericMessage {
    private:
+    /**
+     * Layout is the decode plan that is created once from a MetaMessage and
+     * shared by all copies of a GenericMessage: It maps each field to its
+     * Proto tag and to its slot in the flat arrays holding the values.
+     */
+    struct Layout {
+        struct Field {
+            MetaMessage::MetaField::MetaFieldDataTypes m_fieldDataType{MetaMessage::MetaField::UNDEFINED_T};
+            uint32_t m_fieldIdentifier{0};
+            uint64_t m_protoTag{0};
+            // Position in m_scalars, m_strings, or m_messages depending on m_fieldDataType.
+            std::size_t m_index{0};
+            std::string m_fieldDataTypeName{""};
+            std::string m_fieldName{""};
+        };
+
+        /**
+         * This method adds a field to this layout.
+         *
+         * @param mf Field to add.
+         * @param index Position of the field's value.
+         */
+        void add(const MetaMessage::MetaField &mf, std::size_t index) noexcept;
+
+        /**
+         * @param fieldIdentifier Field identifier to look up.
+         * @return Field for the given identifier or nullptr.
+         */
+        const Field *find(uint32_t fieldIdentifier) const noexcept;
+
+        /**
+         * This method derives the names to be used when visiting this layout.
+         */
+        void updateNames() noexcept;
+
+        MetaMessage m_metaMessage{};
+        std::string m_shortName{""};
+        std::string m_longName{""};
+        // Name as given in the message specification.
+        std::string m_specificationName{""};
+        std::vector<Field> m_fields{};
+        // Position + 1 in m_fields for small field identifiers; 0 if unused.
+        std::vector<std::size_t> m_fieldsByIdentifier{};
+    };
+
+    union Scalar {
+        bool m_bool;
+        char m_char;
+        int8_t m_int8;
+        uint8_t m_uint8;
+        int16_t m_int16;
+        uint16_t m_uint16;
+        int32_t m_int32;
+        uint32_t m_uint32;
+        int64_t m_int64;
+        uint64_t m_uint64;
+        float m_float;
+        double m_double;
+    };
+
     class GenericMessageVisitor {
        private:
         GenericMessageVisitor(const GenericMessageVisitor &) = delete;
@@ -8413,7 +9319,13 @@ class LIBCLUON_API GenericMessage {
         GenericMessageVisitor &operator=(GenericMessageVisitor &&) = delete;
 
        public:
-        GenericMessageVisitor() = default;
+        /**
+         * Constructor.
+         *
+         * @param gm GenericMessage to store the visited values.
+         * @param layout Layout to describe the visited fields.
+         */
+        GenericMessageVisitor(GenericMessage &gm, Layout &layout) noexcept;
 
        public:
         // The following methods are provided to allow an instance of this class to
@@ -8443,24 +9355,17 @@ class LIBCLUON_API GenericMessage {
             GenericMessage gm;
             gm.createFrom<T>(value);
 
-            m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{gm};
-            m_metaMessage.add(std::move(mf));
+            m_layout.add(mf, m_genericMessage.m_messages.size());
+            m_layout.m_metaMessage.add(std::move(mf));
+            m_genericMessage.m_messages.push_back(std::move(gm));
         }
 
-       public:
-        /**
-         * @return MetaMessage for this GenericMessage.
-         */
-        MetaMessage metaMessage() const noexcept;
-
-        /**
-         * @return Intermediate data representation for this GenericMessage.
-         */
-        std::unordered_map<uint32_t, linb::any, UseUInt32ValueAsHashKey> intermediateDataRepresentation() const noexcept;
+       private:
+        Scalar &addScalar(uint32_t id, MetaMessage::MetaField::MetaFieldDataTypes fieldDataType, std::string &&typeName, std::string &&name) noexcept;
 
        private:
-        MetaMessage m_metaMessage{};
-        std::unordered_map<uint32_t, linb::any, UseUInt32ValueAsHashKey> m_intermediateDataRepresentation;
+        GenericMessage &m_genericMessage;
+        Layout &m_layout;
     };
 
    private:
@@ -8485,12 +9390,16 @@ class LIBCLUON_API GenericMessage {
      */
     template <typename T>
     void createFrom(T &msg) {
-        GenericMessageVisitor gmv;
-        msg.accept(gmv);
-
-        m_metaMessage = gmv.metaMessage();
-        m_intermediateDataRepresentation.clear();
-        m_intermediateDataRepresentation = gmv.intermediateDataRepresentation();
+        std::shared_ptr<Layout> layout{std::make_shared<Layout>()};
+        m_scalars.clear();
+        m_strings.clear();
+        m_messages.clear();
+        {
+            GenericMessageVisitor gmv{*this, *layout};
+            msg.accept(gmv);
+        }
+        layout->updateNames();
+        m_layout = layout;
     }
 
     /**
@@ -8526,11 +9435,30 @@ class LIBCLUON_API GenericMessage {
     void visit(uint32_t &id, std::string &&typeName, std::string &&name, T &value) noexcept {
         (void)typeName;
         (void)name;
-        if (0 < m_intermediateDataRepresentation.count(id)) {
-            try {
-                auto &v = linb::any_cast<cluon::GenericMessage &>(m_intermediateDataRepresentation[id]);
-                value.accept(v);
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+        const Layout::Field *f{m_layout->find(id)};
+        if ((nullptr != f) && (MetaMessage::MetaField::MESSAGE_T == f->m_fieldDataType)) {
+            value.accept(m_messages[f->m_index]);
+        }
+    }
+
+   public:
+    // The following methods are provided to allow ToProtoVisitor::encodeFrom and
+    // FromProtoVisitor::decodeFrom to process the fields using the layout.
+
+    template <class ProtoEncoder>
+    void encodeProto(ProtoEncoder &encoder) const {
+        for (const auto &f : m_layout->m_fields) {
+            applyToField(*this, f, [&encoder, &f](const auto &v) { encoder.encodeField(f.m_protoTag, v); });
+        }
+    }
+
+    template <class ProtoDecoder>
+    void decodeProto(ProtoDecoder &decoder) {
+        while (decoder.nextField()) {
+            const uint64_t PROTO_TAG{decoder.fieldTag()};
+            const Layout::Field *f{m_layout->find(static_cast<uint32_t>(PROTO_TAG >> 3))};
+            if ((nullptr != f) && (PROTO_TAG == f->m_protoTag)) {
+                applyToField(*this, *f, [&decoder](auto &v) { decoder.decodeField(v); });
             }
         }
     }
@@ -8572,95 +9500,12 @@ class LIBCLUON_API GenericMessage {
      */
     template <class PreVisitor, class Visitor, class PostVisitor>
     void accept(PreVisitor &&_preVisit, Visitor &&_visit, PostVisitor &&_postVisit) {
-        std::forward<PreVisitor>(_preVisit)(m_metaMessage.messageIdentifier(), m_metaMessage.messageName(), m_longName);
+        std::forward<PreVisitor>(_preVisit)(m_layout->m_metaMessage.messageIdentifier(), m_layout->m_metaMessage.messageName(), m_layout->m_specificationName);
 
-        for (const auto &f : m_metaMessage.listOfMetaFields()) {
-            if (f.fieldDataType() == MetaMessage::MetaField::BOOL_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<bool &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::CHAR_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<char &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::UINT8_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<uint8_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::INT8_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<int8_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::UINT16_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<uint16_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::INT16_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<int16_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::UINT32_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<uint32_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::INT32_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<int32_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::UINT64_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<uint64_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::INT64_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<int64_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::FLOAT_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<float &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::DOUBLE_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<double &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (((f.fieldDataType() == MetaMessage::MetaField::STRING_T) || (f.fieldDataType() == MetaMessage::MetaField::BYTES_T))
-                       && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<std::string &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            } else if (f.fieldDataType() == MetaMessage::MetaField::MESSAGE_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                try {
-                    auto &v = linb::any_cast<cluon::GenericMessage &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                    doTripletForwardVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, _preVisit, _visit, _postVisit);
-                } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                }
-            }
+        for (const auto &f : m_layout->m_fields) {
+            applyToField(*this, f, [&f, &_preVisit, &_visit, &_postVisit](auto &v) {
+                doTripletForwardVisit(f.m_fieldIdentifier, std::string{f.m_fieldDataTypeName}, std::string{f.m_fieldName}, v, _preVisit, _visit, _postVisit);
+            });
         }
 
         std::forward<PostVisitor>(_postVisit)();
@@ -8671,96 +9516,12 @@ class LIBCLUON_API GenericMessage {
     inline void accept(uint32_t fieldId, Visitor &visitor, bool visitAll) {
         visitor.preVisit(ID(), ShortName(), LongName());
 
-        for (const auto &f : m_metaMessage.listOfMetaFields()) {
-            if (visitAll || (fieldId == f.fieldIdentifier())) {
-                if (f.fieldDataType() == MetaMessage::MetaField::BOOL_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<bool &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::CHAR_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<char &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::UINT8_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<uint8_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::INT8_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<int8_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::UINT16_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<uint16_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::INT16_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<int16_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::UINT32_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<uint32_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::INT32_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<int32_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::UINT64_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<uint64_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::INT64_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<int64_t &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::FLOAT_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<float &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::DOUBLE_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<double &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (((f.fieldDataType() == MetaMessage::MetaField::STRING_T) || (f.fieldDataType() == MetaMessage::MetaField::BYTES_T))
-                           && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<std::string &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                } else if (f.fieldDataType() == MetaMessage::MetaField::MESSAGE_T && (0 < m_intermediateDataRepresentation.count(f.fieldIdentifier()))) {
-                    try {
-                        auto &v = linb::any_cast<cluon::GenericMessage &>(m_intermediateDataRepresentation[f.fieldIdentifier()]);
-                        doVisit(f.fieldIdentifier(), std::move(f.fieldDataTypeName()), std::move(f.fieldName()), v, visitor);
-                    } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-                    }
-                }
-                // End processing in case of visiting specific fields.
-                if (!visitAll && (fieldId == f.fieldIdentifier())) {
+        for (const auto &f : m_layout->m_fields) {
+            if (visitAll || (fieldId == f.m_fieldIdentifier)) {
+                applyToField(*this, f, [&f, &visitor](auto &v) {
+                    doVisit(f.m_fieldIdentifier, std::string{f.m_fieldDataTypeName}, std::string{f.m_fieldName}, v, visitor);
+                });
+                if (!visitAll) {
                   break;
                 }
             }
@@ -8769,12 +9530,42 @@ class LIBCLUON_API GenericMessage {
         visitor.postVisit();
     }
 
+    /**
+     * This method calls the given function with the value of the given field.
+     *
+     * @param gm GenericMessage holding the value.
+     * @param f Field from gm's layout.
+     * @param function Function to be called with the field's value.
+     */
+    template <class Message, class Function>
+    static void applyToField(Message &gm, const Layout::Field &f, Function &&function) {
+        switch (f.m_fieldDataType) {
+            case MetaMessage::MetaField::BOOL_T: function(gm.m_scalars[f.m_index].m_bool); break;
+            case MetaMessage::MetaField::CHAR_T: function(gm.m_scalars[f.m_index].m_char); break;
+            case MetaMessage::MetaField::UINT8_T: function(gm.m_scalars[f.m_index].m_uint8); break;
+            case MetaMessage::MetaField::INT8_T: function(gm.m_scalars[f.m_index].m_int8); break;
+            case MetaMessage::MetaField::UINT16_T: function(gm.m_scalars[f.m_index].m_uint16); break;
+            case MetaMessage::MetaField::INT16_T: function(gm.m_scalars[f.m_index].m_int16); break;
+            case MetaMessage::MetaField::UINT32_T: function(gm.m_scalars[f.m_index].m_uint32); break;
+            case MetaMessage::MetaField::INT32_T: function(gm.m_scalars[f.m_index].m_int32); break;
+            case MetaMessage::MetaField::UINT64_T: function(gm.m_scalars[f.m_index].m_uint64); break;
+            case MetaMessage::MetaField::INT64_T: function(gm.m_scalars[f.m_index].m_int64); break;
+            case MetaMessage::MetaField::FLOAT_T: function(gm.m_scalars[f.m_index].m_float); break;
+            case MetaMessage::MetaField::DOUBLE_T: function(gm.m_scalars[f.m_index].m_double); break;
+            case MetaMessage::MetaField::STRING_T:
+            case MetaMessage::MetaField::BYTES_T: function(gm.m_strings[f.m_index]); break;
+            case MetaMessage::MetaField::MESSAGE_T: function(gm.m_messages[f.m_index]); break;
+            default: break;
+        }
+    }
+
+    void createFrom(const MetaMessage &mm, const std::unordered_map<std::string, MetaMessage> &scope) noexcept;
+
    private:
-    MetaMessage m_metaMessage{};
-    std::vector<MetaMessage> m_scopeOfMetaMessages{};
-    std::unordered_map<std::string, MetaMessage> m_mapForScopeOfMetaMessages{};
-    std::string m_longName{""};
-    std::unordered_map<uint32_t, linb::any, UseUInt32ValueAsHashKey> m_intermediateDataRepresentation;
+    std::shared_ptr<const Layout> m_layout{std::make_shared<Layout>()};
+    std::vector<Scalar> m_scalars{};
+    std::vector<std::string> m_strings{};
+    std::vector<GenericMessage> m_messages{};
 };
 } // namespace cluon
 
@@ -8786,6 +9577,10 @@ template <>
 struct isTripletForwardVisitable<cluon::GenericMessage> {
     static const bool value = true;
 };
+template <>
+struct isProtoCodec<cluon::GenericMessage> {
+    static const bool value = true;
+};
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -8795,35 +9590,39 @@ struct isTripletForwardVisitable<cluon::GenericMessage> {
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
-#ifndef CLUON_LCMTOGENERICMESSAGE_HPP
-#define CLUON_LCMTOGENERICMESSAGE_HPP
+#ifndef CLUON_ENVELOPECONVERTER_HPP
+#define CLUON_ENVELOPECONVERTER_HPP
 
 //#include "cluon/GenericMessage.hpp"
 //#include "cluon/MetaMessage.hpp"
 //#include "cluon/cluon.hpp"
+//#include "cluon/cluonDataStructures.hpp"
 
 #include <cstdint>
+#include <functional>
+#include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cluon {
 /**
-This class transforms a given LCM message into a GenericMessage.
+This class provides various conversion functions to and from Envelope data structures.
 */
-class LIBCLUON_API LCMToGenericMessage {
+class LIBCLUON_API EnvelopeConverter {
    private:
-    LCMToGenericMessage(const LCMToGenericMessage &) = delete;
-    LCMToGenericMessage(LCMToGenericMessage &&)      = delete;
-    LCMToGenericMessage &operator=(const LCMToGenericMessage &) = delete;
-    LCMToGenericMessage &operator=(LCMToGenericMessage &&) = delete;
+    EnvelopeConverter(const EnvelopeConverter &) = delete;
+    EnvelopeConverter(EnvelopeConverter &&)      = delete;
+    EnvelopeConverter &operator=(const EnvelopeConverter &) = delete;
+    EnvelopeConverter &operator=(EnvelopeConverter &&) = delete;
 
    public:
-    LCMToGenericMessage() = default;
+    EnvelopeConverter() = default;
 
     /**
      * This method sets the message specification to be used for
-     * interpreting a given LCM-encoded message.
+     * interpreting a given Proto-encoded Envelope.
      *
      * @param ms Message specification following the ODVD format.
      * @return -1 in case of invalid message specification; otherwise, number
@@ -8832,18 +9631,403 @@ class LIBCLUON_API LCMToGenericMessage {
     int32_t setMessageSpecification(const std::string &ms) noexcept;
 
     /**
-     * This method transforms the given LCM payload into a GenericMessage.
+     * This method transforms the given Proto-encoded Envelope to JSON. The
+     * Proto-encoded envelope might be preceded with a 5-bytes OD4-header (optional).
      *
-     * @param data LCM Payload.
-     * @return GenericMessage representation using the given message specification.
+     * @param protoEncodedEnvelope Proto-encoded Envelope.
+     * @return JSON representation from given Proto-encoded Envelope using the
+     *         given message specification.
      */
-    cluon::GenericMessage getGenericMessage(const std::string &data) noexcept;
+    std::string getJSONFromProtoEncodedEnvelope(const std::string &protoEncodedEnvelope) noexcept;
 
-   private:
-    std::vector<cluon::MetaMessage> m_listOfMetaMessages{};
-    std::map<std::string, cluon::MetaMessage> m_scopeOfMetaMessages{};
+    /**
+     * This method transforms the given Envelope to JSON.
+     *
+     * @param envelope Envelope.
+     * @return JSON representation from given Envelope using the given message specification.
+     */
+    std::string getJSONFromEnvelope(cluon::data::Envelope &envelope) noexcept;
+
+    /**
+     * This method transforms all Envelopes from a recording (.rec file) in
+     * one pass into a JSON array that is streamed to the given output;
+     * Envelopes without a matching message specification are skipped.
+     *
+     * @param recFile Stream to read the OD4-encoded Envelopes from.
+     * @param out Stream to write the JSON array to.
+     * @return Number of Envelopes that were transformed to JSON.
+     */
+    uint64_t getJSONFromRecFile(std::istream &recFile, std::ostream &out) noexcept;
+
+    /**
+     * This method transforms all Envelopes returned from the given function
+     * in one pass into a JSON array that is streamed to the given output;
+     * Envelopes without a matching message specification are skipped.
+     *
+     * @param nextEnvelope Function returning the next Envelope; if bool is false, no next Envelope is available.
+     * @param out Stream to write the JSON array to.
+     * @return Number of Envelopes that were transformed to JSON.
+     */
+    uint64_t getJSONFromEnvelopes(const std::function<std::pair<bool, cluon::data::Envelope>()> &nextEnvelope, std::ostream &out) noexcept;
+
+    /**
+     * This method transforms a given JSON representation into a Proto-encoded Envelope
+     * including the prepended OD4-header.
+     *
+     * @param json representation according to the given message specification.
+     * @param messageIdentifier The given JSON representation shall be interpreted
+     *        as the specified message.
+     * @param senderStamp to be used in the Envelope.
+     * @return Proto-encoded Envelope including OD4-header or empty string.
+     */
+    std::string getProtoEncodedEnvelopeFromJSONWithoutTimeStamps(const std::string &json, int32_t messageIdentifier, uint32_t senderStamp) noexcept;
+
+    /**
+     * This method transforms a given JSON representation into a Proto-encoded Envelope
+     * including the prepended OD4-header and setting cluon::time::now() as sampleTimeStamp.
+     *
+     * @param json representation according to the given message specification.
+     * @param messageIdentifier The given JSON representation shall be interpreted
+     *        as the specified message.
+     * @param senderStamp to be used in the Envelope.
+     * @return Proto-encoded Envelope including OD4-header or empty string.
+     */
+    std::string getProtoEncodedEnvelopeFromJSON(const std::string &json, int32_t messageIdentifier, uint32_t senderStamp) noexcept;
+
+   private:
+// clang-format off
+    std::string getProtoEncodedEnvelopeFromJSON(const std::string &json, int32_t messageIdentifier, uint32_t senderStamp, cluon::data::TimeStamp sampleTimeStamp) noexcept;
+// clang-format on
+
+    /**
+     * This method appends the JSON representation of the given Envelope to
+     * the given buffer.
+     *
+     * @param buffer to append to.
+     * @param envelope Envelope.
+     * @return true if the Envelope's payload is known from the message specification.
+     */
+    bool appendJSONFromEnvelope(std::string &buffer, cluon::data::Envelope &envelope) noexcept;
+
+   private:
+    std::vector<cluon::MetaMessage> m_listOfMetaMessages{};
+    std::map<int32_t, cluon::MetaMessage> m_scopeOfMetaMessages{};
+    // "Empty" GenericMessages created once per message identifier.
+    std::map<int32_t, cluon::GenericMessage> m_genericMessages{};
+};
+} // namespace cluon
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_LCMTOGENERICMESSAGE_HPP
+#define CLUON_LCMTOGENERICMESSAGE_HPP
+
+//#include "cluon/GenericMessage.hpp"
+//#include "cluon/MetaMessage.hpp"
+//#include "cluon/cluon.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cluon {
+/**
+This class transforms a given LCM message into a GenericMessage.
+*/
+class LIBCLUON_API LCMToGenericMessage {
+   private:
+    LCMToGenericMessage(const LCMToGenericMessage &) = delete;
+    LCMToGenericMessage(LCMToGenericMessage &&)      = delete;
+    LCMToGenericMessage &operator=(const LCMToGenericMessage &) = delete;
+    LCMToGenericMessage &operator=(LCMToGenericMessage &&) = delete;
+
+   public:
+    LCMToGenericMessage() = default;
+
+    /**
+     * This method sets the message specification to be used for
+     * interpreting a given LCM-encoded message.
+     *
+     * @param ms Message specification following the ODVD format.
+     * @return -1 in case of invalid message specification; otherwise, number
+     *         of successfully parsed messages from given message specification.
+     */
+    int32_t setMessageSpecification(const std::string &ms) noexcept;
+
+    /**
+     * This method transforms the given LCM payload into a GenericMessage.
+     *
+     * @param data LCM Payload.
+     * @return GenericMessage representation using the given message specification.
+     */
+    cluon::GenericMessage getGenericMessage(const std::string &data) noexcept;
+
+   private:
+    std::vector<cluon::MetaMessage> m_listOfMetaMessages{};
+    std::map<std::string, cluon::MetaMessage> m_scopeOfMetaMessages{};
+};
+} // namespace cluon
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_OD4FRAGMENTATION_HPP
+#define CLUON_OD4FRAGMENTATION_HPP
+
+//#include "cluon/cluon.hpp"
+//#include "cluon/UDPPacketSizeConstraints.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cluon {
+
+/**
+ * OD4-framed Envelopes that do not fit into a single UDP packet are split
+ * into fragments, each of which is sent as a separate UDP packet in format:
+ *
+ *    0x0D 0xA5 SEQ0 SEQ1 SEQ2 SEQ3 IDX0 IDX1 CNT0 CNT1 LEN0 LEN1 LEN2 LEN3 OFF0 OFF1 OFF2 OFF3 Fragment
+ *
+ * SEQ is a per-sender sequence number of the fragmented OD4 frame, IDX is the
+ * index of this fragment, CNT is the number of fragments, LEN is the length of
+ * the complete OD4 frame, and OFF is the position of this fragment within the
+ * OD4 frame. All values are little Endian.
+ */
+constexpr uint8_t OD4_FRAGMENT_HEADER_SIZE{18};
+
+/**
+ * Fragments including their header fit into the payload of one UDP packet in
+ * one Ethernet frame (1472 bytes) so that they are not fragmented again by IP;
+ * a lost IP fragment would otherwise discard the complete UDP packet.
+ */
+constexpr std::size_t OD4_MAX_FRAGMENT_SIZE{static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_ETHERNET_MTU)
+                                            - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                            - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER)};
+
+/**
+ * OD4 frames are limited to 5 bytes header and 2^24 - 1 bytes payload.
+ */
+constexpr uint32_t OD4_MAX_FRAME_SIZE{5 + 0xFFFFFF};
+
+/**
+ * @param data Bytes to check.
+ * @param size Number of bytes.
+ * @return true if the given bytes carry a fragment of an OD4 frame.
+ */
+bool isOD4Fragment(const char *data, std::size_t size) noexcept;
+
+/**
+ * This method splits a given OD4 frame into fragments.
+ *
+ * @param frame OD4-framed Envelope to split.
+ * @param sequenceNumber Sequence number to identify the fragments belonging to this OD4 frame.
+ * @param maxFragmentSize Maximum size of a fragment including its header.
+ * @return List of fragments or empty list if the frame could not be split.
+ */
+std::vector<std::string> fragmentOD4Frame(const std::string &frame, uint32_t sequenceNumber, std::size_t maxFragmentSize) noexcept;
+
+/**
+This class reassembles OD4 frames from fragments created by cluon::fragmentOD4Frame.
+Fragments may arrive in any order. Incomplete OD4 frames are dropped when not
+completed within the given timeout or when the bounded reassembly buffer
+needs to make room for newer OD4 frames.
+*/
+class LIBCLUON_API OD4FragmentAssembler {
+   private:
+    OD4FragmentAssembler(const OD4FragmentAssembler &) = delete;
+    OD4FragmentAssembler(OD4FragmentAssembler &&)      = delete;
+    OD4FragmentAssembler &operator=(const OD4FragmentAssembler &) = delete;
+    OD4FragmentAssembler &operator=(OD4FragmentAssembler &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param maxBufferedBytes Maximum number of bytes held by incomplete OD4 frames.
+     * @param timeout Duration after which an incomplete OD4 frame is dropped.
+     */
+    OD4FragmentAssembler(std::size_t maxBufferedBytes = 64 * 1024 * 1024, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) noexcept;
+
+    /**
+     * This method adds a fragment.
+     *
+     * @param sender Identifier of the sender of this fragment.
+     * @param data Bytes of the fragment including its header.
+     * @param size Number of bytes.
+     * @param receivedAt Time point when the fragment was received.
+     * @return Pair: true and the complete OD4 frame when the given fragment completed an OD4 frame.
+     */
+    std::pair<bool, std::string> add(uint64_t sender, const char *data, std::size_t size, const std::chrono::system_clock::time_point &receivedAt) noexcept;
+
+    /**
+     * @return Number of OD4 frames that were successfully reassembled.
+     */
+    uint64_t numberOfCompletedFrames() const noexcept;
+
+    /**
+     * @return Number of incomplete OD4 frames that were dropped.
+     */
+    uint64_t numberOfDroppedFrames() const noexcept;
+
+   private:
+    void dropExpiredFrames(const std::chrono::system_clock::time_point &now) noexcept;
+    void dropOldestFrame() noexcept;
+
+   private:
+    class PendingFrame {
+       public:
+        std::string m_data{};
+        std::vector<bool> m_receivedFragments{};
+        uint16_t m_missingFragments{0};
+        std::chrono::system_clock::time_point m_firstFragmentReceivedAt{};
+    };
+
+    std::size_t m_maxBufferedBytes;
+    std::chrono::milliseconds m_timeout;
+    std::size_t m_bufferedBytes{0};
+    std::map<std::pair<uint64_t, uint32_t>, PendingFrame> m_pendingFrames{};
+
+    uint64_t m_numberOfCompletedFrames{0};
+    uint64_t m_numberOfDroppedFrames{0};
+};
+
+} // namespace cluon
+
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_TIMETRIGGER_HPP
+#define CLUON_TIMETRIGGER_HPP
+
+//#include "cluon/cluon.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace cluon {
+namespace time {
+
+/**
+ * @return Time elapsed on the monotonic clock (CLOCK_MONOTONIC) that does not jump with the wall clock.
+ */
+std::chrono::nanoseconds monotonicNow() noexcept;
+
+/**
+ * This method sleeps until the given deadline on the monotonic clock.
+ *
+ * @param deadline Absolute time point as returned from monotonicNow.
+ * @param busyWait Duration before the deadline to busy-wait instead of sleeping.
+ */
+void sleepUntil(std::chrono::nanoseconds deadline, std::chrono::microseconds busyWait = std::chrono::microseconds(0)) noexcept;
+
+} // namespace time
+
+/**
+ * Options for OD4Session::timeTrigger.
+ */
+struct LIBCLUON_API TimeTriggerOptions {
+    /**
+     * Duration before a deadline that is spent busy-waiting instead of
+     * sleeping to compensate for the wake-up latency of the scheduler.
+     */
+    std::chrono::microseconds busyWait{0};
+
+    /**
+     * Real-time priority [1 .. 99] to run the time-triggered delegate with
+     * using SCHED_FIFO; 0 keeps the current scheduling policy (Linux only).
+     */
+    int32_t realtimePriority{0};
+
+    /**
+     * CPU core to pin the time-triggered delegate to; -1 keeps the current
+     * CPU affinity (Linux only).
+     */
+    int32_t cpuAffinity{-1};
 };
+
+/**
+This class collects the timing of a time-triggered delegate: the jitter is the
+delay of starting the delegate after its deadline and an overrun happens when
+the delegate returns after the deadline of the next cycle; the cycles whose
+deadlines have passed during an overrun are skipped. Both are recorded in
+histograms with logarithmic buckets: bucket 0 counts values below 1us and
+bucket i counts values in [2^(i-1)us, 2^i us); the last bucket counts all
+larger values.
+*/
+class LIBCLUON_API TimeTriggerStatistics {
+   public:
+    enum : uint8_t { NUMBER_OF_BUCKETS = 24 };
+
+   public:
+    /**
+     * This method records one cycle.
+     *
+     * @param jitter Delay of starting the delegate after its deadline.
+     * @param overrun Delay of returning from the delegate after the next deadline or 0.
+     * @param skippedCycles Number of cycles skipped due to the overrun.
+     */
+    void add(std::chrono::nanoseconds jitter, std::chrono::nanoseconds overrun, uint64_t skippedCycles) noexcept;
+
+    /**
+     * This method resets all statistics.
+     */
+    void clear() noexcept;
+
+    uint64_t numberOfCycles() const noexcept;
+    uint64_t numberOfOverruns() const noexcept;
+    uint64_t numberOfSkippedCycles() const noexcept;
+    std::chrono::nanoseconds meanJitter() const noexcept;
+    std::chrono::nanoseconds maxJitter() const noexcept;
+    std::chrono::nanoseconds maxOverrun() const noexcept;
+    const std::array<uint64_t, NUMBER_OF_BUCKETS> &jitterHistogram() const noexcept;
+    const std::array<uint64_t, NUMBER_OF_BUCKETS> &overrunHistogram() const noexcept;
+
+    /**
+     * @return Human-readable summary including the non-empty buckets of both histograms.
+     */
+    std::string toString() const noexcept;
+
+   private:
+    static uint8_t bucket(std::chrono::nanoseconds duration) noexcept;
+
+   private:
+    uint64_t m_numberOfCycles{0};
+    uint64_t m_numberOfOverruns{0};
+    uint64_t m_numberOfSkippedCycles{0};
+    std::chrono::nanoseconds m_sumOfJitter{0};
+    std::chrono::nanoseconds m_maxJitter{0};
+    std::chrono::nanoseconds m_maxOverrun{0};
+    std::array<uint64_t, NUMBER_OF_BUCKETS> m_jitterHistogram{};
+    std::array<uint64_t, NUMBER_OF_BUCKETS> m_overrunHistogram{};
+};
+
 } // namespace cluon
+
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -8856,23 +10040,31 @@ class LIBCLUON_API LCMToGenericMessage {
 #ifndef CLUON_OD4SESSION_HPP
 #define CLUON_OD4SESSION_HPP
 
+//#include "cluon/OD4Fragmentation.hpp"
 //#include "cluon/Time.hpp"
+//#include "cluon/TimeTrigger.hpp"
 //#include "cluon/ToProtoVisitor.hpp"
 //#include "cluon/UDPReceiver.hpp"
 //#include "cluon/UDPSender.hpp"
 //#include "cluon/cluon.hpp"
 //#include "cluon/cluonDataStructures.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace cluon {
+class SharedMemoryRing;
+
 /**
 This class provides an interface to an OpenDaVINCI v4 session. An OpenDaVINCI
 v4 session allows the automatic exchange of time-stamped Envelopes carrying
@@ -8906,6 +10098,40 @@ MyMessage msg;
 od4.send(msg);
 \endcode
 
+Producers that emit many small messages per cycle can send them as a batch
+that is handed over to the kernel at once:
+
+\code{.cpp}
+std::vector<MyMessage> msgs{...};
+od4.send(msgs);
+\endcode
+
+By default, every Envelope of a batch is sent in its own UDP packet. When all
+microservices of a session use this version of OD4Session, consecutive
+Envelopes of a batch can additionally be packed into as few UDP packets as
+possible (bounded by the Ethernet MTU) by listing the CIDs in the environment
+variable CLUON_OD4SESSION_BATCHING (e.g., CLUON_OD4SESSION_BATCHING=111,112);
+the receiving OD4Session unpacks such UDP packets transparently while older
+versions only decode the first Envelope of every UDP packet.
+
+Envelopes that exceed the maximum size of a UDP packet (e.g., uncompressed
+images) are split into fragments that fit into one Ethernet frame each on
+sending and transparently reassembled by the receiving OD4Session; incomplete
+Envelopes are dropped after one second. Envelopes that fit into a UDP packet
+are still sent in one UDP packet as before to remain readable by older versions.
+
+Microservices running on the same host (e.g., in containers started with
+--net=host --ipc=host) can additionally exchange Envelopes via a shared memory
+ring buffer as a fast path. The shared memory transport is selected per CID by
+listing the CIDs in the environment variable CLUON_OD4SESSION_SHAREDMEMORY
+(e.g., CLUON_OD4SESSION_SHAREDMEMORY=111,112). The ring buffer takes about
+32 MB per CID so that every Envelope fits into it. Envelopes are still sent
+using UDP multicast to reach microservices without shared memory and on other
+hosts; OD4Sessions using shared memory ignore these UDP packets from the other
+OD4Sessions on the same host that use shared memory. When an OD4Session cannot
+read from the ring buffer as fast as Envelopes are written and misses some of
+them, it reports this and receives all Envelopes via UDP multicast from then on.
+
 Next to receive Envelopes, OD4Session can call a user-supplied lambda in a time-triggered
 way. The lambda is executed as long as it does not return false or throws an exception
 that is then caught in the method timeTrigger and the method is exited:
@@ -8919,6 +10145,25 @@ od4.timeTrigger(FREQ, [](){
   return false;
 }); // This call blocks until the lambda returns false.
 \endcode
+
+The lambda is started at absolute deadlines on the monotonic clock so that the
+time spent in the lambda does not let the frequency drift. Precise control loops
+can additionally busy-wait for the last microseconds before a deadline and run
+with real-time priority pinned to a CPU core; the jitter and overruns of the
+cycles are available as cluon::TimeTriggerStatistics:
+
+\code{.cpp}
+cluon::TimeTriggerOptions options;
+options.busyWait = std::chrono::microseconds(100);
+options.realtimePriority = 50; // SCHED_FIFO; requires CAP_SYS_NICE.
+options.cpuAffinity = 2;
+
+od4.timeTrigger(100, [&od4](){
+  // Do something time-triggered.
+  return true;
+}, options);
+std::cout << od4.timeTriggerStatistics().toString();
+\endcode
 */
 class LIBCLUON_API OD4Session {
    private:
@@ -8938,6 +10183,7 @@ class LIBCLUON_API OD4Session {
      *        to have both: a delegate for "catch-all" and the data-triggered ones.
      */
     OD4Session(uint16_t CID, std::function<void(cluon::data::Envelope &&envelope)> delegate = nullptr) noexcept;
+    ~OD4Session() noexcept;
 
     /**
      * This method will send a given Envelope to this OpenDaVINCI v4 session.
@@ -8946,6 +10192,24 @@ class LIBCLUON_API OD4Session {
      */
     void send(cluon::data::Envelope &&envelope) noexcept;
 
+    /**
+     * This method will send the given Envelopes to this OpenDaVINCI v4 session
+     * as a batch; if batching is enabled for this session, consecutive OD4-framed
+     * Envelopes are packed into one UDP packet as long as it does not exceed the
+     * Ethernet MTU.
+     *
+     * @param envelopes to be sent.
+     */
+    void send(std::vector<cluon::data::Envelope> &&envelopes) noexcept;
+
+    /**
+     * This method will send copies of the given Envelopes to this OpenDaVINCI
+     * v4 session as a batch.
+     *
+     * @param envelopes to be sent.
+     */
+    void send(std::vector<cluon::data::Envelope> &envelopes) noexcept;
+
     /**
      * This method sets a delegate to be called data-triggered on arrival
      * of a new Envelope for a given message identifier.
@@ -8965,8 +10229,14 @@ class LIBCLUON_API OD4Session {
      *
      * @param freq Frequency in Hertz to run the given delegate.
      * @param delegate Function to call according to the given frequency.
+     * @param options Options to improve the timing precision.
+     */
+    void timeTrigger(float freq, std::function<bool()> delegate, const cluon::TimeTriggerOptions &options = cluon::TimeTriggerOptions()) noexcept;
+
+    /**
+     * @return Timing of the cycles of the current or last call of timeTrigger.
      */
-    void timeTrigger(float freq, std::function<bool()> delegate) noexcept;
+    cluon::TimeTriggerStatistics timeTriggerStatistics() noexcept;
 
     /**
      * This method will send a given message to this OpenDaVINCI v4 session.
@@ -8979,35 +10249,81 @@ class LIBCLUON_API OD4Session {
     void send(T &message, const cluon::data::TimeStamp &sampleTimeStamp = cluon::data::TimeStamp(), uint32_t senderStamp = 0) noexcept {
         try {
             std::lock_guard<std::mutex> lck(m_senderMutex);
-            cluon::ToProtoVisitor protoEncoder;
+            send(createEnvelope(message, sampleTimeStamp, senderStamp));
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
 
-            cluon::data::Envelope envelope;
-            {
-                envelope.dataType(static_cast<int32_t>(message.ID()));
-                message.accept(protoEncoder);
-                envelope.serializedData(protoEncoder.encodedData());
-                envelope.sent(cluon::time::now());
-                envelope.sampleTimeStamp((0 == (sampleTimeStamp.seconds() + sampleTimeStamp.microseconds())) ? envelope.sent() : sampleTimeStamp);
-                envelope.senderStamp(senderStamp);
+    /**
+     * This method will send the given messages as a batch to this OpenDaVINCI v4 session.
+     *
+     * @param messages Messages to be sent; cluon::data::Envelopes are sent as they are.
+     * @param sampleTimeStamp Time point when these samples to be sent were captured (default = sent time point).
+     * @param senderStamp Optional sender stamp (default = 0).
+     */
+    template <typename T, typename = typename std::enable_if<!std::is_same<T, cluon::data::Envelope>::value>::type>
+    void send(std::vector<T> &messages, const cluon::data::TimeStamp &sampleTimeStamp = cluon::data::TimeStamp(), uint32_t senderStamp = 0) noexcept {
+        try {
+            std::lock_guard<std::mutex> lck(m_senderMutex);
+            std::vector<cluon::data::Envelope> envelopes;
+            envelopes.reserve(messages.size());
+            for (auto &message : messages) {
+                envelopes.emplace_back(createEnvelope(message, sampleTimeStamp, senderStamp));
             }
-
-            send(std::move(envelope));
+            send(std::move(envelopes));
         } catch (...) {} // LCOV_EXCL_LINE
     }
 
    public:
     bool isRunning() noexcept;
 
+    /**
+     * @return true if this OD4Session exchanges Envelopes via shared memory.
+     */
+    bool isUsingSharedMemory() const noexcept;
+
    private:
-    void callback(std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) noexcept;
+    template <typename T>
+    cluon::data::Envelope createEnvelope(T &message, const cluon::data::TimeStamp &sampleTimeStamp, uint32_t senderStamp) {
+        std::string serializedData;
+        cluon::ToProtoVisitor protoEncoder{serializedData};
+
+        cluon::data::Envelope envelope;
+        {
+            envelope.dataType(static_cast<int32_t>(message.ID()));
+            protoEncoder.encodeFrom(message);
+            envelope.serializedData(std::move(serializedData));
+            envelope.sent(cluon::time::now());
+            envelope.sampleTimeStamp((0 == (sampleTimeStamp.seconds() + sampleTimeStamp.microseconds())) ? envelope.sent() : sampleTimeStamp);
+            envelope.senderStamp(senderStamp);
+        }
+        return envelope;
+    }
+
+   private:
+    void callback(cluon::ReceiveBuffer &&buffer) noexcept;
+    void dispatch(const char *data, std::size_t size, const cluon::data::TimeStamp &received) noexcept;
+    bool hasDelegates() noexcept;
     void sendInternal(std::string &&dataToSend) noexcept;
 
    private:
     std::unique_ptr<cluon::UDPReceiver> m_receiver;
     cluon::UDPSender m_sender;
 
+    bool m_batching{false};
+
+    std::unique_ptr<cluon::SharedMemoryRing> m_sharedMemoryRing{nullptr};
+    std::atomic<bool> m_sharedMemoryReaderRunning{false};
+    std::thread m_sharedMemoryReader{};
+
     std::mutex m_senderMutex{};
 
+    std::atomic<uint32_t> m_fragmentSequenceNumber{0};
+    cluon::OD4FragmentAssembler m_fragmentAssembler{};
+
+    std::mutex m_timeTriggerStatisticsMutex{};
+    cluon::TimeTriggerStatistics m_timeTriggerStatistics{};
+
+    std::mutex m_dispatchMutex{};
     std::function<void(cluon::data::Envelope &&envelope)> m_delegate{nullptr};
 
     std::mutex m_mapOfDataTriggeredDelegatesMutex{};
@@ -9015,6 +10331,54 @@ class LIBCLUON_API OD4Session {
 };
 
 } // namespace cluon
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_COMPRESSION_HPP
+#define CLUON_COMPRESSION_HPP
+
+//#include "cluon/cluon.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace cluon {
+namespace compression {
+
+/**
+ * This function compresses the given bytes with a fast LZ77-based block
+ * compressor. The compressed block is a sequence of tokens, each followed
+ * by the literal bytes to be copied and the offset and length of a match
+ * to be copied from the already decompressed bytes. It is not compressing
+ * as well as general purpose compressors but its throughput is suitable
+ * for recording.
+ *
+ * @param data Bytes to be compressed.
+ * @param size Number of bytes to be compressed.
+ * @param compressed String to which the compressed bytes are appended.
+ */
+void compress(const char *data, std::size_t size, std::string &compressed) noexcept;
+
+/**
+ * This function decompresses a block created by compress.
+ *
+ * @param data Compressed bytes.
+ * @param size Number of compressed bytes.
+ * @param decompressedSize Number of bytes when decompressed.
+ * @param decompressed String to hold the decompressed bytes.
+ * @return true if the block was decompressed to exactly decompressedSize bytes.
+ */
+bool decompress(const char *data, std::size_t size, std::size_t decompressedSize, std::string &decompressed) noexcept;
+
+} // namespace compression
+} // namespace cluon
+
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -9030,28 +10394,70 @@ class LIBCLUON_API OD4Session {
 //#include "cluon/cluon.hpp"
 //#include "cluon/cluonDataStructures.hpp"
 
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 
 class LIBCLUON_API IndexEntry {
    public:
-    IndexEntry() = default;
-    IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept;
+    IndexEntry() = default;
+    IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept;
+    IndexEntry(const int64_t &sampleTimeStamp,
+               const uint64_t &filePosition,
+               const int32_t &dataType,
+               const uint32_t &senderStamp,
+               const uint32_t &size) noexcept;
+
+   public:
+    int64_t m_sampleTimeStamp{0};
+    uint64_t m_filePosition{0};
+    int32_t m_dataType{0};
+    uint32_t m_senderStamp{0};
+    uint32_t m_size{0};
+    bool m_available{0};
+};
+
+/**
+ * This class identifies the state of a .rec file that an index sidecar file
+ * was created for: besides size and modification time in nanoseconds, a hash
+ * over the first and last bytes of the .rec file detects rewritten files
+ * whose size and modification time are unchanged.
+ */
+class LIBCLUON_API RecFileFingerprint {
+   public:
+    uint64_t m_size{0};
+    int64_t m_modificationTime{0};
+    uint64_t m_contentHash{0};
+};
 
+/**
+ * This class describes a chunk of consecutive OD4-framed cluon::data::Envelopes
+ * in a chunked .rec file; positions of Envelopes in a chunked .rec file refer
+ * to the concatenation of all decompressed chunks.
+ */
+class LIBCLUON_API ChunkEntry {
    public:
-    int64_t m_sampleTimeStamp{0};
     uint64_t m_filePosition{0};
-    bool m_available{0};
+    uint32_t m_compressedSize{0};
+    uint32_t m_uncompressedSize{0};
+    int64_t m_minSampleTimeStamp{0};
+    int64_t m_maxSampleTimeStamp{0};
+    uint32_t m_numberOfEnvelopes{0};
+    uint64_t m_dataPosition{0};
 };
 
 class LIBCLUON_API Player {
@@ -9060,8 +10466,9 @@ class LIBCLUON_API Player {
         ONE_MILLISECOND_IN_MICROSECONDS = 1000,
         ONE_SECOND_IN_MICROSECONDS      = 1000 * ONE_MILLISECOND_IN_MICROSECONDS,
         MAX_DELAY_IN_MICROSECONDS       = 1 * ONE_SECOND_IN_MICROSECONDS,
-        LOOK_AHEAD_IN_S                 = 30,
-        MIN_ENTRIES_FOR_LOOK_AHEAD      = 5000,
+        LOOK_AHEAD_IN_BYTES             = 16 * 1024 * 1024,
+        MAPPED_BYTES_TO_RELEASE         = 16 * 1024 * 1024,
+        CHUNKS_TO_PREFETCH              = 4,
     };
 
    private:
@@ -9074,11 +10481,25 @@ class LIBCLUON_API Player {
     /**
      * Constructor.
      *
-     * @param file File to play.
+     * @param file File to play; both, plain and chunked .rec files as written by cluon::Recorder are supported.
      * @param autoRewind True if the file should be rewind at EOF.
      * @param threading If set to true, player will load new envelopes from the files in background.
+     * @param memoryMapped If set to true, the rec file is memory-mapped and envelopes are decoded
+     *                     on demand instead of being cached; chunked .rec files are always cached.
+     * @param allowList If not empty, only envelopes whose dataType is a key in this map are replayed;
+     *                  if the corresponding set of senderStamps is not empty, the envelope's senderStamp
+     *                  must be contained as well. Other envelopes are never read from the rec file.
+     *
+     * The index of the rec file is loaded from the sidecar file <file>.idx written by
+     * cluon::Recorder if it matches the rec file; otherwise, the rec file is scanned.
+     * The scanned index is only stored in <file>.idx if the environment variable
+     * CLUON_PLAYER_INDEXFILE is set to 1; failing to store it is not an error.
      */
-    Player(const std::string &file, const bool &autoRewind, const bool &threading) noexcept;
+    Player(const std::string &file,
+           const bool &autoRewind,
+           const bool &threading,
+           const bool &memoryMapped                             = false,
+           const std::map<int32_t, std::set<uint32_t>> &allowList = {}) noexcept;
     ~Player();
 
     /**
@@ -9087,6 +10508,17 @@ class LIBCLUON_API Player {
      */
     std::pair<bool, cluon::data::Envelope> getNextEnvelopeToBeReplayed() noexcept;
 
+    /**
+     * This method is only available when the rec file is memory-mapped and
+     * returns the next Envelope to be replayed without decoding or copying it.
+     *
+     * @return Pointer to and length of the bytes of the next Envelope to be replayed
+     *         in the memory-mapped rec file (0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded
+     *         cluon::data::Envelope); the bytes are valid as long as this Player exists.
+     *         The pointer is nullptr if no next Envelope is available.
+     */
+    std::pair<const char *, std::size_t> getNextSerializedEnvelopeToBeReplayed() noexcept;
+
     /**
      * @return real delay in microseconds to be waited before the next cluon::data::Envelope should be delivered.
      */
@@ -9105,7 +10537,15 @@ class LIBCLUON_API Player {
     void seekTo(float ratio) noexcept;
 
     /**
-     * @return total amount of cluon::data::Envelopes in the .rec file.
+     * This method seeks to the first cluon::data::Envelope in the .rec file
+     * whose sample time stamp is not before the given one.
+     *
+     * @param sampleTimeStamp Sample time stamp in microseconds.
+     */
+    void seekToTimestamp(int64_t sampleTimeStamp) noexcept;
+
+    /**
+     * @return total amount of cluon::data::Envelopes in the .rec file to be replayed.
      */
     uint32_t totalNumberOfEnvelopesInRecFile() const noexcept;
 
@@ -9121,8 +10561,107 @@ class LIBCLUON_API Player {
     void initializeIndex() noexcept;
 
     /**
-     * This method computes the initially required amount of
-     * cluon::data::Envelope in the cache and fill the cache accordingly.
+     * This method tries to load the index from the sidecar file next
+     * to the rec file. The sidecar is only accepted when it was written
+     * for a rec file with the same fingerprint.
+     *
+     * @param fingerprint Fingerprint of the rec file.
+     * @return true if the index was loaded from the sidecar file.
+     */
+    bool loadIndexFile(const RecFileFingerprint &fingerprint) noexcept;
+
+    /**
+     * This method writes the index to the sidecar file next to the rec file
+     * so that subsequent runs do not have to scan the rec file again.
+     *
+     * @param fingerprint Fingerprint of the rec file.
+     */
+    void storeIndexFile(const RecFileFingerprint &fingerprint) noexcept;
+
+    /**
+     * This method memory-maps the rec file for replaying envelopes from it.
+     *
+     * @param recFileSize Size of the rec file in bytes.
+     * @return true if the rec file could be memory-mapped.
+     */
+    bool mapRecFile(const uint64_t &recFileSize) noexcept;
+
+    /**
+     * This method reads the table of chunks from the end of a chunked rec file.
+     *
+     * @param recFileSize Size of the rec file in bytes.
+     * @return true if the table of chunks is valid.
+     */
+    bool readChunkTable(const uint64_t &recFileSize) noexcept;
+
+    /**
+     * This method creates the index entries for a chunked rec file by
+     * decompressing its chunks in parallel.
+     *
+     * @param entries Index entries in the order of the rec file.
+     * @return Number of bytes of all decompressed chunks.
+     * @throws The first exception from any of the threads after all threads were joined.
+     */
+    uint64_t indexChunks(std::vector<IndexEntry> &entries);
+
+    /**
+     * This method reads the compressed bytes of a chunk from the rec file.
+     *
+     * @param in Stream to read from.
+     * @param chunk Chunk to read.
+     * @return Compressed bytes.
+     */
+    std::string readChunk(std::fstream &in, std::size_t chunk);
+
+    /**
+     * This method decompresses the given chunk.
+     *
+     * @param compressed Compressed bytes of the chunk.
+     * @param uncompressedSize Size of the chunk when decompressed.
+     * @return Decompressed bytes or an empty string in case of an error.
+     */
+    static std::string decompressChunk(std::string &&compressed, uint32_t uncompressedSize) noexcept;
+
+    /**
+     * This method extracts an Envelope from a chunked rec file and starts to
+     * decompress the subsequent chunks in the background.
+     *
+     * @param position Position of the Envelope in the decompressed chunks.
+     * @return Pair of bool and the extracted cluon::data::Envelope.
+     */
+    std::pair<bool, cluon::data::Envelope> extractEnvelopeFromChunk(const uint64_t &position) noexcept;
+
+    /**
+     * This method appends an entry to the global index.
+     *
+     * @param entry Entry to be appended in chronological order.
+     */
+    void appendToIndex(const IndexEntry &entry);
+
+    /**
+     * This method clears the global index.
+     */
+    void clearIndex() noexcept;
+
+    /**
+     * This method removes all entries from the global index
+     * that are not matching the allow list.
+     */
+    void applyAllowList() noexcept;
+
+    /**
+     * This method moves the iterators to the given entry in the global index
+     * and refills the cache from there.
+     *
+     * @param entry Position in the global index.
+     * @param skipEntry True if the entry itself shall be skipped.
+     */
+    void seekToEntry(std::size_t entry, bool skipEntry) noexcept;
+
+    /**
+     * This method computes the capacity of the cache from the average size
+     * of a cluon::data::Envelope so that the look-ahead is bounded in bytes,
+     * and fills the cache accordingly.
      */
     void computeInitialCacheLevelAndFillCache() noexcept;
 
@@ -9138,7 +10677,8 @@ class LIBCLUON_API Player {
 
     /**
      * This method fills the cache by trying to read up
-     * to maxNumberOfEntriesToReadFromFile from the rec file.
+     * to maxNumberOfEntriesToReadFromFile from the rec file
+     * as long as there is room left in the cache.
      *
      * @param maxNumberOfEntriesToReadFromFile Maximum number of entries to be read from file.
      * @return Number of entries read from file.
@@ -9146,38 +10686,59 @@ class LIBCLUON_API Player {
     uint32_t fillEnvelopeCache(const uint32_t &maxNumberOfEntriesToReadFromFile) noexcept;
 
     /**
-     * This method checks the availability of the next cluon::data::Envelope
-     * to be replayed from the cache.
+     * This method must be called with m_indexMutex being locked.
+     *
+     * @return true if the next entry from the rec file fits into the cache.
      */
-    inline void checkAvailabilityOfNextEnvelopeToBeReplayed() noexcept;
+    bool hasRoomInEnvelopeCache() const noexcept;
 
    private: // Data for the Player.
     bool m_threading;
 
     std::string m_file;
+    std::string m_indexFile;
+    std::map<int32_t, std::set<uint32_t>> m_allowList;
 
     // Handle to .rec file.
     std::fstream m_recFile;
     bool m_recFileValid;
 
+    // Memory-mapped .rec file.
+    bool m_memoryMapped;
+    const char *m_mappedRecFile{nullptr};
+    std::size_t m_mappedRecFileSize{0};
+    std::size_t m_mappedRecFileReleased{0};
+
+    // Chunked .rec file: the current chunk is decompressed and the subsequent
+    // ones are decompressed concurrently; only used while filling the cache.
+    bool m_chunked{false};
+    std::vector<ChunkEntry> m_chunks{};
+    std::size_t m_currentChunk{0};
+    std::string m_currentChunkData{};
+    std::deque<std::pair<std::size_t, std::future<std::string>>> m_prefetchedChunks{};
+
    private: // Player states.
     bool m_autoRewind;
 
    private: // Index and cache management.
-    // Global index: Mapping SampleTimeStamp --> cache entry (holding the actual content from .rec file).
+    // Global index: Entries sorted chronologically by their sample time stamps
+    // and stored as structure of arrays; entry i describes the cluon::data::Envelope
+    // at file position m_indexFilePositions[i] in the .rec file.
     mutable std::mutex m_indexMutex;
-    std::multimap<int64_t, IndexEntry> m_index;
-
-    // Pointers to the current envelope to be replayed and the
-    // envelope that has be replayed from the global index.
-    std::multimap<int64_t, IndexEntry>::iterator m_previousPreviousEnvelopeAlreadyReplayed;
-    std::multimap<int64_t, IndexEntry>::iterator m_previousEnvelopeAlreadyReplayed;
-    std::multimap<int64_t, IndexEntry>::iterator m_currentEnvelopeToReplay;
+    std::vector<int64_t> m_indexSampleTimeStamps;
+    std::vector<uint64_t> m_indexFilePositions;
+    std::vector<int32_t> m_indexDataTypes;
+    std::vector<uint32_t> m_indexSenderStamps;
+    std::vector<uint32_t> m_indexSizes;
+
+    // Positions in the global index of the current envelope to be replayed
+    // and the envelope that has been replayed; the size of the global index
+    // marks the end.
+    std::size_t m_previousEnvelopeAlreadyReplayed;
+    std::size_t m_currentEnvelopeToReplay;
 
     // Information about the index.
-    std::multimap<int64_t, IndexEntry>::iterator m_nextEntryToReadFromRecFile;
-
-    uint32_t m_desiredInitialLevel;
+    std::size_t m_nextEntryToReadFromRecFile;
 
     // Fields to compute replay throughput for cache management.
     cluon::data::TimeStamp m_firstTimePointReturningAEnvelope;
@@ -9199,22 +10760,21 @@ class LIBCLUON_API Player {
      */
     void manageCache() noexcept;
 
-    /**
-     * This method checks whether the cache needs to be refilled.
-     *
-     * @param numberOfEntries Number of entries in cache.
-     * @param refillMultiplicator Multiplicator to modify the amount of envelopes to be refilled.
-     * @return Modified refillMultiplicator recommedned to be used next time
-     */
-    float checkRefillingCache(const uint32_t &numberOfEntries, float refillMultiplicator) noexcept;
-
    private:
     mutable std::mutex m_envelopeCacheFillingThreadIsRunningMutex;
     bool m_envelopeCacheFillingThreadIsRunning;
     std::thread m_envelopeCacheFillingThread;
 
-    // Mapping of pos_type (within .rec file) --> cluon::data::Envelope (read from .rec file).
-    std::map<uint64_t, cluon::data::Envelope> m_envelopeCache;
+    // Ring buffer of fixed capacity holding the next cluon::data::Envelopes
+    // to be replayed in the order of the global index; the oldest entry at
+    // m_envelopeCacheHead corresponds to m_currentEnvelopeToReplay. It is
+    // protected by m_indexMutex.
+    std::vector<cluon::data::Envelope> m_envelopeCache;
+    std::size_t m_envelopeCacheHead;
+    std::size_t m_envelopeCacheEntries;
+    uint64_t m_envelopeCacheBytes;
+    std::condition_variable m_envelopeCacheNotEmpty;
+    std::condition_variable m_envelopeCacheNotFull;
 
    public:
     void setPlayerListener(std::function<void(cluon::data::PlayerStatus playerStatus)> playerListener) noexcept;
@@ -9226,6 +10786,193 @@ class LIBCLUON_API Player {
 
 } // namespace cluon
 
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_RECORDER_HPP
+#define CLUON_RECORDER_HPP
+
+//#include "cluon/cluon.hpp"
+//#include "cluon/cluonDataStructures.hpp"
+//#include "cluon/Player.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cluon {
+/**
+This class records cluon::data::Envelopes into a .rec file. Envelopes are
+collected in memory and written in large blocks by a dedicated I/O thread
+so that the thread delivering them is never blocked by the disk; while one
+buffer is written, the next one is filled. The file is synchronized to disk
+in batches and the index sidecar file for cluon::Player is created from the
+Envelopes as they are written.
+
+Optionally, the Envelopes are written as chunked .rec file: Consecutive
+Envelopes are grouped into chunks of at least 4 MiB that are compressed
+individually; a table with the position and the range of sample time stamps
+of all chunks is appended when the recording is finished. Pending Envelopes
+are then written once a chunk is complete.
+
+To record all Envelopes from an OD4Session, use the Recorder as "catch-all"
+delegate:
+
+\code{.cpp}
+cluon::Recorder recorder("recording.rec");
+cluon::OD4Session od4(111, [&recorder](cluon::data::Envelope &&envelope){
+  recorder.record(std::move(envelope));
+});
+\endcode
+*/
+class LIBCLUON_API Recorder {
+   private:
+    enum {
+        WRITE_SIZE_IN_BYTES            = 4 * 1024 * 1024,
+        CHUNK_SIZE_IN_BYTES            = 4 * 1024 * 1024,
+        SYNC_SIZE_IN_BYTES             = 64 * 1024 * 1024,
+        WRITE_INTERVAL_IN_MILLISECONDS = 100,
+    };
+
+   private:
+    Recorder(const Recorder &) = delete;
+    Recorder(Recorder &&)      = delete;
+    Recorder &operator=(Recorder &&) = delete;
+    Recorder &operator=(const Recorder &other) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param file File to record to; an existing file will be overwritten.
+     * @param chunked If set to true, a chunked .rec file with compressed chunks is written.
+     */
+    explicit Recorder(const std::string &file, const bool &chunked = false) noexcept;
+
+    /**
+     * Destructor: Writes all pending Envelopes, synchronizes the file
+     * to disk, and stores the index sidecar file.
+     */
+    ~Recorder();
+
+    /**
+     * This method records the given Envelope; it only copies the
+     * Envelope's bytes into memory and returns without waiting for
+     * them to be written to disk.
+     *
+     * @param envelope Envelope to record.
+     */
+    void record(cluon::data::Envelope &&envelope) noexcept;
+
+    /**
+     * @return true if the .rec file could be opened and no write error occurred.
+     */
+    bool isRecording() const noexcept;
+
+    /**
+     * @return Number of recorded Envelopes.
+     */
+    uint64_t numberOfEnvelopes() const noexcept;
+
+    /**
+     * @return Number of bytes of recorded Envelopes written to the .rec file;
+     *         for a chunked .rec file, this includes the incomplete chunk.
+     */
+    uint64_t bytesWritten() const noexcept;
+
+    /**
+     * @return Number of bytes of recorded Envelopes that are not written yet.
+     */
+    uint64_t backlog() const noexcept;
+
+    /**
+     * @return Bytes per second written to the .rec file during the last second.
+     */
+    float writeRate() const noexcept;
+
+   private:
+    /**
+     * This method writes the recorded Envelopes to disk.
+     */
+    void writeRecFile() noexcept;
+
+    /**
+     * This method writes the given bytes to the .rec file.
+     *
+     * @param data Bytes to be written.
+     * @return true if all bytes were written.
+     */
+    bool writeBuffer(const char *data, std::size_t size) noexcept;
+
+    /**
+     * This method compresses and writes the pending Envelopes as one chunk.
+     *
+     * @return true if the chunk was written.
+     */
+    bool writeChunk() noexcept;
+
+    /**
+     * This method writes the table of chunks at the end of a chunked .rec file.
+     *
+     * @return true if the table was written.
+     */
+    bool writeChunkTable() noexcept;
+
+    /**
+     * This method synchronizes the written data to disk.
+     */
+    void sync() noexcept;
+
+    /**
+     * This method stores the index sidecar file for the closed .rec file.
+     */
+    void storeIndexFile() noexcept;
+
+   private:
+    std::string m_file;
+    std::FILE *m_recFile{nullptr};
+    bool m_chunked{false};
+
+    // All fields are protected by m_mutex.
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_bufferReady{};
+    bool m_running{false};
+    bool m_recording{false};
+
+    // Envelopes are appended to the front buffer while the back
+    // buffer is written to disk by m_writer.
+    std::string m_frontBuffer{};
+    std::string m_backBuffer{};
+
+    // Index entries in the order the Envelopes were recorded.
+    std::vector<IndexEntry> m_index{};
+
+    uint64_t m_bytesRecorded{0};
+    uint64_t m_bytesWritten{0};
+    float m_writeRate{0.0f};
+
+    // Only used by m_writer.
+    uint64_t m_bytesSynced{0};
+    uint64_t m_recFileSize{0};
+    std::string m_chunk{};
+    std::size_t m_nextIndexEntryForChunk{0};
+    std::vector<ChunkEntry> m_chunks{};
+
+    std::thread m_writer{};
+};
+
+} // namespace cluon
+
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -9414,6 +11161,165 @@ class LIBCLUON_API SharedMemory {
 };
 } // namespace cluon
 
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_SHAREDMEMORYRING_HPP
+#define CLUON_SHAREDMEMORYRING_HPP
+
+//#include "cluon/cluon.hpp"
+//#include "cluon/SharedMemory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cluon {
+/**
+This class provides a multi-producer/multi-consumer ring buffer for
+variable-sized entries residing in a cluon::SharedMemory area that is shared
+among processes on the same host. Every SharedMemoryRing attached to the same
+name receives all entries written by the other attached SharedMemoryRings since
+it has attached but not the ones it has written itself.
+
+Producers are serialized by the lock of the shared memory area while consumers
+read without locking; every consumer maintains its own read position. Hence, a
+slow consumer does not block any producer but loses the entries that were
+overwritten before it could read them.
+
+The first SharedMemoryRing creates the shared memory area; subsequent ones
+attach to it. When the creating SharedMemoryRing is destroyed, the remaining
+ones transparently move on to a newly created shared memory area.
+
+Every SharedMemoryRing can announce an identifier (e.g., the port it uses to
+send the same entries via UDP) to the others as long as it exists.
+
+\code{.cpp}
+cluon::SharedMemoryRing ring{"MyRing"};
+ring.write("Hello World", 11);
+
+// In another process:
+cluon::SharedMemoryRing ring{"MyRing"};
+ring.read([](std::string &&entry){ std::cout << entry << std::endl; }, std::chrono::milliseconds(100));
+\endcode
+*/
+class LIBCLUON_API SharedMemoryRing {
+   private:
+    SharedMemoryRing(const SharedMemoryRing &) = delete;
+    SharedMemoryRing(SharedMemoryRing &&)      = delete;
+    SharedMemoryRing &operator=(const SharedMemoryRing &) = delete;
+    SharedMemoryRing &operator=(SharedMemoryRing &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param name Name of the shared memory area to create or to attach to.
+     * @param capacity Number of bytes to hold entries when creating the shared memory area.
+     */
+    SharedMemoryRing(const std::string &name, uint32_t capacity = DEFAULT_CAPACITY) noexcept;
+    ~SharedMemoryRing() noexcept;
+
+    /**
+     * @return true if the shared memory area is usable.
+     */
+    bool valid() noexcept;
+
+    /**
+     * This method appends an entry to the ring buffer and wakes up waiting consumers.
+     *
+     * @param data Bytes to write.
+     * @param size Number of bytes.
+     * @return true if the entry was written; false if it is too large or the ring buffer is not usable.
+     */
+    bool write(const char *data, std::size_t size) noexcept;
+
+    /**
+     * This method waits for new entries and passes all entries written by
+     * other producers since the last call to the given delegate. This method
+     * must not be called concurrently for the same SharedMemoryRing.
+     *
+     * @param delegate Function to call for every new entry.
+     * @param timeout Maximum duration to wait for new entries.
+     * @return Number of entries passed to the delegate.
+     */
+    std::size_t read(std::function<void(std::string &&entry)> delegate, std::chrono::milliseconds timeout) noexcept;
+
+    /**
+     * This method wakes up all consumers waiting in read.
+     */
+    void notifyAll() noexcept;
+
+    /**
+     * @return Maximum size of an entry.
+     */
+    std::size_t maxEntrySize() noexcept;
+
+    /**
+     * @return Number of times this consumer was overrun by producers and lost entries.
+     */
+    uint64_t numberOfOverruns() const noexcept;
+
+    /**
+     * This method announces an identifier to all attached SharedMemoryRings
+     * until this SharedMemoryRing is destroyed.
+     *
+     * @param identifier Identifier to announce.
+     * @return true if the identifier was announced.
+     */
+    bool addParticipant(uint32_t identifier) noexcept;
+
+    /**
+     * @param identifier Identifier to check.
+     * @return true if the given identifier was announced by an attached SharedMemoryRing.
+     */
+    bool hasParticipant(uint32_t identifier) noexcept;
+
+    /**
+     * @param maxEntrySize Size of the largest entry to be written.
+     * @return Capacity to be passed to the constructor to hold entries of the given size.
+     */
+    static uint32_t capacityFor(uint32_t maxEntrySize) noexcept;
+
+   public:
+    static constexpr uint32_t DEFAULT_CAPACITY{8 * 1024 * 1024};
+
+   private:
+    struct Segment;
+    std::shared_ptr<Segment> segment() noexcept;
+    std::shared_ptr<Segment> reconnect(const std::shared_ptr<Segment> &closedSegment) noexcept;
+    std::shared_ptr<Segment> attachOrCreate() noexcept;
+    int32_t lockName() noexcept;
+    void unlockName(int32_t fd) noexcept;
+
+   private:
+    std::string m_name;
+    uint32_t m_capacity;
+    uint64_t m_producerID;
+
+    std::mutex m_segmentMutex{};
+    std::shared_ptr<Segment> m_segment{nullptr};
+
+    std::shared_ptr<Segment> m_readSegment{nullptr};
+    uint64_t m_readPosition{0};
+    std::atomic<uint64_t> m_numberOfOverruns{0};
+
+    // Announced identifier stored as PID << 32 | identifier; 0 if unused.
+    uint64_t m_participant{0};
+};
+} // namespace cluon
+
 #endif
 #ifndef BEGIN_HEADER_ONLY_IMPLEMENTATION
 #define BEGIN_HEADER_ONLY_IMPLEMENTATION
@@ -9555,11 +11461,26 @@ inline void MetaMessage::accept(const std::function<void(const MetaMessage &)> &
  */
 
 //#include "cluon/MessageParser.hpp"
+//#include "cluon/PortableEndian.hpp"
 //#include "cluon/stringtoolbox.hpp"
 
 //#include "cpp-peglib/peglib.h"
 
+// clang-format off
+#ifdef WIN32
+    #include <fstream>
+    #include <sstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -9569,7 +11490,16 @@ inline void MetaMessage::accept(const std::function<void(const MetaMessage &)> &
 
 namespace cluon {
 
+// Compiled message specifications start with these bytes followed by a little endian uint32_t version.
+static constexpr char COMPILED_MESSAGE_SPECIFICATION_MAGIC[4]{'\x89', 'O', 'D', 'V'};
+static constexpr uint32_t COMPILED_MESSAGE_SPECIFICATION_VERSION{1};
+
 inline std::pair<std::vector<MetaMessage>, MessageParser::MessageParserErrorCodes> MessageParser::parse(const std::string &input) {
+    if ((sizeof(COMPILED_MESSAGE_SPECIFICATION_MAGIC) <= input.size())
+        && (0 == std::memcmp(input.data(), COMPILED_MESSAGE_SPECIFICATION_MAGIC, sizeof(COMPILED_MESSAGE_SPECIFICATION_MAGIC)))) {
+        return parseCompiled(input.data(), input.size());
+    }
+
     const char *grammarMessageSpecificationLanguage = R"(
         MESSAGES_SPECIFICATION      <- PACKAGE_DECLARATION? MESSAGE_DECLARATION*
         PACKAGE_DECLARATION         <- 'package' PACKAGE_IDENTIFIER ';'
@@ -9889,6 +11819,142 @@ inline std::pair<std::vector<MetaMessage>, MessageParser::MessageParserErrorCode
     }
     return retVal;
 }
+
+inline std::pair<std::vector<MetaMessage>, MessageParser::MessageParserErrorCodes> MessageParser::parseFile(const std::string &filename) {
+    std::pair<std::vector<MetaMessage>, MessageParserErrorCodes> retVal{{}, MessageParserErrorCodes::SYNTAX_ERROR};
+#ifdef WIN32
+    std::ifstream fin(filename, std::ios::in | std::ios::binary);
+    if (fin.good()) {
+        const std::string input{static_cast<std::stringstream const &>(std::stringstream() << fin.rdbuf()).str()}; // NOLINT
+        retVal = parse(input);
+    }
+#else
+    const int fd{::open(filename.c_str(), O_RDONLY)};
+    if (-1 < fd) {
+        struct stat fileStatus {};
+        if ((0 == ::fstat(fd, &fileStatus)) && (0 < fileStatus.st_size)) {
+            const std::size_t SIZE{static_cast<std::size_t>(fileStatus.st_size)};
+            void *mapped{::mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, fd, 0)};
+            if (MAP_FAILED != mapped) {
+                const char *data{static_cast<const char *>(mapped)};
+                if ((sizeof(COMPILED_MESSAGE_SPECIFICATION_MAGIC) <= SIZE)
+                    && (0 == std::memcmp(data, COMPILED_MESSAGE_SPECIFICATION_MAGIC, sizeof(COMPILED_MESSAGE_SPECIFICATION_MAGIC)))) {
+                    retVal = parseCompiled(data, SIZE);
+                } else {
+                    retVal = parse(std::string(data, SIZE));
+                }
+                ::munmap(mapped, SIZE);
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    return retVal;
+}
+
+inline std::string MessageParser::compile(const std::vector<MetaMessage> &listOfMetaMessages) noexcept {
+    // Layout (all numbers little endian):
+    //   magic version:uint32 numberOfMessages:uint32
+    //   per message: identifier:int32 packageName messageName numberOfFields:uint32
+    //   per field:   dataType:uint16 identifier:uint32 dataTypeName fieldName defaultInitializationValue
+    // with strings stored as length:uint32 followed by the characters.
+    std::string retVal;
+    try {
+        auto appendUInt32 = [&retVal](uint32_t v) {
+            v = htole32(v);
+            retVal.append(reinterpret_cast<const char *>(&v), sizeof(uint32_t));
+        };
+        auto appendString = [&retVal, &appendUInt32](const std::string &s) {
+            appendUInt32(static_cast<uint32_t>(s.size()));
+            retVal.append(s);
+        };
+
+        retVal.append(COMPILED_MESSAGE_SPECIFICATION_MAGIC, sizeof(COMPILED_MESSAGE_SPECIFICATION_MAGIC));
+        appendUInt32(COMPILED_MESSAGE_SPECIFICATION_VERSION);
+        appendUInt32(static_cast<uint32_t>(listOfMetaMessages.size()));
+        for (const auto &mm : listOfMetaMessages) {
+            appendUInt32(static_cast<uint32_t>(mm.messageIdentifier()));
+            appendString(mm.packageName());
+            appendString(mm.messageName());
+            appendUInt32(static_cast<uint32_t>(mm.listOfMetaFields().size()));
+            for (const auto &mf : mm.listOfMetaFields()) {
+                uint16_t dataType{htole16(static_cast<uint16_t>(mf.fieldDataType()))};
+                retVal.append(reinterpret_cast<const char *>(&dataType), sizeof(uint16_t));
+                appendUInt32(mf.fieldIdentifier());
+                appendString(mf.fieldDataTypeName());
+                appendString(mf.fieldName());
+                appendString(mf.defaultInitializationValue());
+            }
+        }
+    } catch (...) { // LCOV_EXCL_LINE
+        retVal.clear(); // LCOV_EXCL_LINE
+    }
+    return retVal;
+}
+
+inline std::pair<std::vector<MetaMessage>, MessageParser::MessageParserErrorCodes> MessageParser::parseCompiled(const char *data,
+                                                                                                                std::size_t size) noexcept {
+    std::pair<std::vector<MetaMessage>, MessageParserErrorCodes> retVal{{}, MessageParserErrorCodes::SYNTAX_ERROR};
+    try {
+        std::size_t position{sizeof(COMPILED_MESSAGE_SPECIFICATION_MAGIC)};
+        bool valid{true};
+        auto readUInt32 = [data, size, &position, &valid]() {
+            uint32_t v{0};
+            if (valid && (sizeof(uint32_t) <= size - position)) {
+                std::memcpy(&v, data + position, sizeof(uint32_t));
+                position += sizeof(uint32_t);
+            } else {
+                valid = false;
+            }
+            return le32toh(v);
+        };
+        auto readString = [data, size, &position, &valid, &readUInt32]() {
+            std::string s;
+            const uint32_t LENGTH{readUInt32()};
+            if (valid && (LENGTH <= size - position)) {
+                s.assign(data + position, LENGTH);
+                position += LENGTH;
+            } else {
+                valid = false;
+            }
+            return s;
+        };
+
+        std::vector<MetaMessage> listOfMetaMessages{};
+        if (COMPILED_MESSAGE_SPECIFICATION_VERSION == readUInt32()) {
+            const uint32_t NUMBER_OF_MESSAGES{readUInt32()};
+            for (uint32_t i{0}; valid && (i < NUMBER_OF_MESSAGES); i++) {
+                MetaMessage mm;
+                mm.messageIdentifier(static_cast<int32_t>(readUInt32()));
+                mm.packageName(readString());
+                mm.messageName(readString());
+                const uint32_t NUMBER_OF_FIELDS{readUInt32()};
+                for (uint32_t j{0}; valid && (j < NUMBER_OF_FIELDS); j++) {
+                    uint16_t dataType{0};
+                    if (sizeof(uint16_t) <= size - position) {
+                        std::memcpy(&dataType, data + position, sizeof(uint16_t));
+                        position += sizeof(uint16_t);
+                    } else {
+                        valid = false;
+                    }
+                    MetaMessage::MetaField mf;
+                    mf.fieldDataType(static_cast<MetaMessage::MetaField::MetaFieldDataTypes>(le16toh(dataType)));
+                    mf.fieldIdentifier(readUInt32());
+                    mf.fieldDataTypeName(readString());
+                    mf.fieldName(readString());
+                    mf.defaultInitializationValue(readString());
+                    mm.add(std::move(mf));
+                }
+                listOfMetaMessages.emplace_back(std::move(mm));
+            }
+            if (valid && (position == size)) {
+                retVal = {std::move(listOfMetaMessages), MessageParserErrorCodes::NO_MESSAGEPARSER_ERROR};
+            }
+        }
+    } catch (...) { // LCOV_EXCL_LINE
+    }
+    return retVal;
+}
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -10040,6 +12106,7 @@ inline std::string getIPv4FromHostname(const std::string &hostname) noexcept {
     #include <arpa/inet.h>
     #include <sys/socket.h>
     #include <sys/types.h>
+    #include <sys/uio.h>
     #include <unistd.h>
 #endif
 // clang-format on
@@ -10150,6 +12217,247 @@ inline std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noe
 
     return {bytesSent, (0 > bytesSent ? errno : 0)};
 }
+
+inline std::pair<ssize_t, int32_t> UDPSender::send(std::vector<std::string> &&data) const noexcept {
+    if (-1 == m_socket) {
+        return {-1, EBADF};
+    }
+
+    constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    for (const auto &d : data) {
+        if (MAX_LENGTH < d.size()) {
+            return {-1, E2BIG};
+        }
+    }
+
+    // Skip empty entries as they would result in empty UDP packets.
+    data.erase(std::remove_if(data.begin(), data.end(), [](const std::string &d) { return d.empty(); }), data.end());
+    if (data.empty()) {
+        return {0, 0};
+    }
+
+    ssize_t totalBytesSent{0};
+    int32_t errorCode{0};
+
+    std::lock_guard<std::mutex> lck(m_socketMutex);
+#ifdef __linux__
+    std::vector<struct mmsghdr> messages(data.size());
+    std::vector<struct iovec> chunks(data.size());
+    for (std::size_t i{0}; i < data.size(); i++) {
+        chunks[i].iov_base              = const_cast<char *>(data[i].data());                 // NOLINT
+        chunks[i].iov_len               = data[i].size();
+        messages[i].msg_hdr.msg_name    = const_cast<struct sockaddr_in *>(&m_sendToAddress); // NOLINT
+        messages[i].msg_hdr.msg_namelen = sizeof(m_sendToAddress);
+        messages[i].msg_hdr.msg_iov     = &chunks[i];
+        messages[i].msg_hdr.msg_iovlen  = 1;
+    }
+
+    // sendmmsg might return before all packets were handed over to the kernel.
+    std::size_t packetsSent{0};
+    while (packetsSent < messages.size()) {
+        const int32_t retVal = ::sendmmsg(m_socket, &messages[packetsSent], static_cast<unsigned int>(messages.size() - packetsSent), 0);
+        if (0 > retVal) {
+            errorCode = errno;
+            break;
+        }
+        for (int32_t i{0}; i < retVal; i++) {
+            totalBytesSent += static_cast<ssize_t>(messages[packetsSent + static_cast<std::size_t>(i)].msg_len);
+        }
+        packetsSent += static_cast<std::size_t>(retVal);
+    }
+#else
+    for (const auto &d : data) {
+        ssize_t bytesSent = ::sendto(m_socket,
+                                     d.c_str(),
+                                     d.length(),
+                                     0,
+                                     reinterpret_cast<const struct sockaddr *>(&m_sendToAddress), // NOLINT
+                                     sizeof(m_sendToAddress));
+        if (0 > bytesSent) {
+            errorCode = errno;
+            break;
+        }
+        totalBytesSent += bytesSent;
+    }
+#endif
+
+    return {(0 != errorCode) && (0 == totalBytesSent) ? -1 : totalBytesSent, errorCode};
+}
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/ReceiveBufferPool.hpp"
+
+// clang-format off
+#ifdef WIN32
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+#endif
+// clang-format on
+
+#include <array>
+#include <new>
+#include <utility>
+
+namespace cluon {
+
+inline ReceiveBuffer::ReceiveBuffer(Block *block) noexcept
+    : m_block(block) {}
+
+inline ReceiveBuffer::ReceiveBuffer(const ReceiveBuffer &other) noexcept
+    : m_block(other.m_block) {
+    if (nullptr != m_block) {
+        m_block->m_referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline ReceiveBuffer::ReceiveBuffer(ReceiveBuffer &&other) noexcept
+    : m_block(other.m_block) {
+    other.m_block = nullptr;
+}
+
+inline ReceiveBuffer &ReceiveBuffer::operator=(const ReceiveBuffer &other) noexcept {
+    if (this != &other) {
+        if (nullptr != other.m_block) {
+            other.m_block->m_referenceCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        release();
+        m_block = other.m_block;
+    }
+    return *this;
+}
+
+inline ReceiveBuffer &ReceiveBuffer::operator=(ReceiveBuffer &&other) noexcept {
+    if (this != &other) {
+        release();
+        m_block       = other.m_block;
+        other.m_block = nullptr;
+    }
+    return *this;
+}
+
+inline ReceiveBuffer::~ReceiveBuffer() noexcept {
+    release();
+}
+
+inline void ReceiveBuffer::release() noexcept {
+    if ((nullptr != m_block) && (1 == m_block->m_referenceCount.fetch_sub(1, std::memory_order_acq_rel))) {
+        // The pool might only be kept alive by this block.
+        std::shared_ptr<ReceiveBufferPool> pool{std::move(m_block->m_pool)};
+        if (pool) {
+            pool->release(m_block);
+        } else {
+            delete m_block; // LCOV_EXCL_LINE
+        }
+    }
+    m_block = nullptr;
+}
+
+inline bool ReceiveBuffer::valid() const noexcept {
+    return (nullptr != m_block);
+}
+
+inline const char *ReceiveBuffer::data() const noexcept {
+    return (nullptr != m_block) ? m_block->m_data.data() : nullptr;
+}
+
+inline std::size_t ReceiveBuffer::size() const noexcept {
+    return (nullptr != m_block) ? m_block->m_data.size() : 0;
+}
+
+inline std::string ReceiveBuffer::from() const noexcept {
+    std::string retVal;
+    if (nullptr != m_block) {
+        std::array<char, INET_ADDRSTRLEN> remoteAddress{};
+        ::inet_ntop(AF_INET, &(m_block->m_from.sin_addr), remoteAddress.data(), remoteAddress.max_size());
+        retVal = std::string(remoteAddress.data()) + ':' + std::to_string(ntohs(m_block->m_from.sin_port));
+    }
+    return retVal;
+}
+
+inline struct sockaddr_in ReceiveBuffer::fromAddress() const noexcept {
+    return (nullptr != m_block) ? m_block->m_from : sockaddr_in{};
+}
+
+inline bool ReceiveBuffer::fromLocalHost() const noexcept {
+    return (nullptr != m_block) && m_block->m_fromLocalHost;
+}
+
+inline std::chrono::system_clock::time_point ReceiveBuffer::sampleTime() const noexcept {
+    return (nullptr != m_block) ? m_block->m_sampleTime : std::chrono::system_clock::time_point{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline ReceiveBufferPool::ReceiveBufferPool(std::size_t capacity) noexcept
+    : m_capacity(capacity) {
+    try {
+        m_freeBlocks.reserve(m_capacity);
+    } catch (...) { m_capacity = 0; } // LCOV_EXCL_LINE
+}
+
+inline ReceiveBufferPool::~ReceiveBufferPool() noexcept {
+    for (auto block : m_freeBlocks) {
+        delete block;
+    }
+    m_freeBlocks.clear();
+}
+
+inline ReceiveBuffer ReceiveBufferPool::acquire(const char *data,
+                                                std::size_t size,
+                                                const struct sockaddr_in &from,
+                                                const std::chrono::system_clock::time_point &sampleTime,
+                                                bool fromLocalHost) noexcept {
+    ReceiveBuffer::Block *block{nullptr};
+    {
+        std::lock_guard<std::mutex> lck(m_freeBlocksMutex);
+        if (!m_freeBlocks.empty()) {
+            block = m_freeBlocks.back();
+            m_freeBlocks.pop_back();
+        }
+    }
+    if (nullptr == block) {
+        block = new (std::nothrow) ReceiveBuffer::Block();
+    }
+
+    ReceiveBuffer retVal;
+    if (nullptr != block) {
+        try {
+            // Reusing a block only allocates when its capacity is exceeded.
+            block->m_data.assign(data, data + size);
+            block->m_from          = from;
+            block->m_fromLocalHost = fromLocalHost;
+            block->m_sampleTime    = sampleTime;
+            block->m_pool          = shared_from_this();
+            block->m_referenceCount.store(1, std::memory_order_relaxed);
+            retVal = ReceiveBuffer(block);
+        } catch (...) { delete block; } // LCOV_EXCL_LINE
+    }
+    return retVal;
+}
+
+inline void ReceiveBufferPool::release(ReceiveBuffer::Block *block) noexcept {
+    bool keepForReuse{false};
+    {
+        std::lock_guard<std::mutex> lck(m_freeBlocksMutex);
+        if (m_freeBlocks.size() < m_capacity) {
+            m_freeBlocks.push_back(block);
+            keepForReuse = true;
+        }
+    }
+    if (!keepForReuse) {
+        delete block;
+    }
+}
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -10213,6 +12521,22 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
     , m_mreq()
     , m_readFromSocketThread()
     , m_delegate(std::move(delegate)) {
+    setUp(receiveFromAddress, receiveFromPort);
+}
+
+inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
+                         uint16_t receiveFromPort,
+                         std::function<void(cluon::ReceiveBuffer &&)> delegate,
+                         uint16_t localSendFromPort) noexcept
+    : m_localSendFromPort(localSendFromPort)
+    , m_receiveFromAddress()
+    , m_mreq()
+    , m_readFromSocketThread()
+    , m_receiveBufferDelegate(std::move(delegate)) {
+    setUp(receiveFromAddress, receiveFromPort);
+}
+
+inline void UDPReceiver::setUp(const std::string &receiveFromAddress, uint16_t receiveFromPort) noexcept {
     // Decompose given address string to check validity with numerical IPv4 address.
     std::string tmp{cluon::getIPv4FromHostname(receiveFromAddress)};
     std::replace(tmp.begin(), tmp.end(), '.', ' ');
@@ -10387,6 +12711,25 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
 #endif
         }
 
+        if (!(m_socket < 0)) {
+            // The pool and the pipeline are used by the receiving thread and must exist before it is started.
+            try {
+                m_receiveBufferPool = std::make_shared<cluon::ReceiveBufferPool>();
+                m_pipeline          = std::make_shared<cluon::NotifyingPipeline<cluon::ReceiveBuffer>>([this](cluon::ReceiveBuffer &&entry) {
+                    if (nullptr != this->m_receiveBufferDelegate) {
+                        this->m_receiveBufferDelegate(std::move(entry));
+                    } else {
+                        this->m_delegate(std::string(entry.data(), entry.size()), entry.from(), entry.sampleTime());
+                    }
+                });
+                if (m_pipeline) {
+                    // Let the operating system spawn the thread.
+                    using namespace std::literals::chrono_literals; // NOLINT
+                    do { std::this_thread::sleep_for(1ms); } while (!m_pipeline->isRunning());
+                }
+            } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
+        }
+
         if (!(m_socket < 0)) {
             // Constructing the receiving thread could fail.
             try {
@@ -10396,16 +12739,6 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
                 using namespace std::literals::chrono_literals; // NOLINT
                 do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
             } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
-
-            try {
-                m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(
-                    [this](PipelineEntry &&entry) { this->m_delegate(std::move(entry.m_data), std::move(entry.m_from), std::move(entry.m_sampleTime)); });
-                if (m_pipeline) {
-                    // Let the operating system spawn the thread.
-                    using namespace std::literals::chrono_literals; // NOLINT
-                    do { std::this_thread::sleep_for(1ms); } while (!m_pipeline->isRunning());
-                }
-            } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
         }
     }
 }
@@ -10476,9 +12809,6 @@ inline void UDPReceiver::readFromSocket() noexcept {
     fd_set setOfFiledescriptorsToReadFrom{};
 
     // Sender address and port.
-    constexpr uint16_t MAX_ADDR_SIZE{1024};
-    std::array<char, MAX_ADDR_SIZE> remoteAddress{};
-
     struct sockaddr_storage remote {};
     socklen_t addrLength{sizeof(remote)};
 
@@ -10507,7 +12837,7 @@ inline void UDPReceiver::readFromSocket() noexcept {
                                        reinterpret_cast<struct sockaddr *>(&remote), // NOLINT
                                        reinterpret_cast<socklen_t *>(&addrLength));  // NOLINT
 
-                if ((0 < bytesRead) && (nullptr != m_delegate)) {
+                if ((0 < bytesRead) && ((nullptr != m_delegate) || (nullptr != m_receiveBufferDelegate))) {
 #ifdef __linux__
                     std::chrono::system_clock::time_point timestamp;
                     struct timeval receivedTimeStamp {};
@@ -10524,32 +12854,25 @@ inline void UDPReceiver::readFromSocket() noexcept {
                     std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
 #endif
 
-                    // Transform sender address to C-string.
-                    ::inet_ntop(remote.ss_family,
-                                &((reinterpret_cast<struct sockaddr_in *>(&remote))->sin_addr), // NOLINT
-                                remoteAddress.data(),
-                                remoteAddress.max_size());
                     const unsigned long RECVFROM_IP{reinterpret_cast<struct sockaddr_in *>(&remote)->sin_addr.s_addr}; // NOLINT
                     const uint16_t RECVFROM_PORT{ntohs(reinterpret_cast<struct sockaddr_in *>(&remote)->sin_port)};    // NOLINT
 
                     // Check if the bytes actually came from us.
-                    bool sentFromUs{false};
-                    {
-                        auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
-                        const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
-                        sentFromUs                 = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
-                    }
-
-                    // Create a pipeline entry to be processed concurrently.
-                    if (!sentFromUs) {
-                        PipelineEntry pe;
-                        pe.m_data       = std::string(buffer.data(), static_cast<size_t>(bytesRead));
-                        pe.m_from       = std::string(remoteAddress.data()) + ':' + std::to_string(RECVFROM_PORT);
-                        pe.m_sampleTime = timestamp;
+                    auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
+                    const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
+                    const bool sentFromUs      = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
+
+                    // Create a pipeline entry from the pool to be processed concurrently; the sender is only formatted on demand.
+                    if (!sentFromUs && m_receiveBufferPool) {
+                        cluon::ReceiveBuffer entry{m_receiveBufferPool->acquire(buffer.data(),
+                                                                                static_cast<size_t>(bytesRead),
+                                                                                *reinterpret_cast<struct sockaddr_in *>(&remote), // NOLINT
+                                                                                timestamp,
+                                                                                sentFromLocalIP)};
 
                         // Store entry in queue.
-                        if (m_pipeline) {
-                            m_pipeline->add(std::move(pe));
+                        if (m_pipeline && entry.valid()) {
+                            m_pipeline->add(std::move(entry));
                         }
                     }
                     totalBytesRead += bytesRead;
@@ -11052,11 +13375,25 @@ inline void TCPServer::readFromSocket() noexcept {
 
 namespace cluon {
 
+inline ToProtoVisitor::ToProtoVisitor() noexcept
+    : m_buffer{m_ownBuffer} {}
+
+inline ToProtoVisitor::ToProtoVisitor(std::string &buffer) noexcept
+    : m_buffer{buffer}
+    , m_start{buffer.size()} {}
+
 inline std::string ToProtoVisitor::encodedData() const noexcept {
-    std::string s{m_buffer.str()};
+    std::string s;
+    try {
+        s = m_buffer.substr(m_start);
+    } catch (...) {} // LCOV_EXCL_LINE
     return s;
 }
 
+inline std::size_t ToProtoVisitor::encodedSize() const noexcept {
+    return m_buffer.size() - m_start;
+}
+
 inline void ToProtoVisitor::preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept {
     (void)id;
     (void)shortName;
@@ -11130,97 +13467,191 @@ inline void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::stri
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::FOUR_BYTES));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(key);
+    encode(v);
 }
 
 inline void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::EIGHT_BYTES));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(key);
+    encode(v);
 }
 
 inline void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(key);
+    encode(v);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, bool v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, char v) noexcept {
+    toVarInt(tag);
+    uint8_t _v = static_cast<uint8_t>(v); // NOLINT
+    encode(_v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, int8_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, uint8_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, int16_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, uint16_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, int32_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, uint32_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, int64_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, uint64_t v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, float v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, double v) noexcept {
+    toVarInt(tag);
+    encode(v);
+}
+
+inline void ToProtoVisitor::encodeField(uint64_t tag, const std::string &v) noexcept {
+    toVarInt(tag);
+    encode(v);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, bool &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(bool &v) noexcept {
     uint64_t _v{(v ? 1u : 0u)};
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int8_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int8_t &v) noexcept {
     uint64_t _v = toZigZag8(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint8_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(uint8_t &v) noexcept {
     uint64_t _v = v;
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int16_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int16_t &v) noexcept {
     uint64_t _v = toZigZag16(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint16_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(uint16_t &v) noexcept {
     uint64_t _v = v;
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int32_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int32_t &v) noexcept {
     uint64_t _v = toZigZag32(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint32_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(uint32_t &v) noexcept {
     uint64_t _v = v;
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int64_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int64_t &v) noexcept {
     uint64_t _v = toZigZag64(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint64_t &v) noexcept {
-    return toVarInt(o, v);
+inline std::size_t ToProtoVisitor::encode(uint64_t &v) noexcept {
+    return toVarInt(v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, float &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(float &v) noexcept {
     // Store 4 bytes as little endian encoding.
     uint32_t _v{0};
     std::memmove(&_v, &v, sizeof(float));
     _v = htole32(_v);
-    o.write(reinterpret_cast<const char *>(&_v), sizeof(uint32_t)); // NOLINT
+    append(reinterpret_cast<const char *>(&_v), sizeof(uint32_t)); // NOLINT
     return sizeof(uint32_t);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, double &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(double &v) noexcept {
     // Store 8 bytes as little endian encoding.
     uint64_t _v{0};
     std::memmove(&_v, &v, sizeof(double));
     _v = htole64(_v);
-    o.write(reinterpret_cast<const char *>(&_v), sizeof(uint64_t)); // NOLINT
+    append(reinterpret_cast<const char *>(&_v), sizeof(uint64_t)); // NOLINT
     return sizeof(uint64_t);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, const std::string &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(const std::string &v) noexcept {
     const std::size_t LENGTH = v.length();
-    std::size_t size         = toVarInt(o, LENGTH);
-    o.write(v.c_str(), static_cast<std::streamsize>(LENGTH)); // LENGTH won't be negative.
+    std::size_t size         = toVarInt(LENGTH);
+    append(v.data(), LENGTH);
     return size + LENGTH;
 }
 
+inline std::size_t ToProtoVisitor::beginLengthDelimited() noexcept {
+    const std::size_t POSITION{m_buffer.size()};
+    append("\0", 1);
+    return POSITION;
+}
+
+inline void ToProtoVisitor::endLengthDelimited(std::size_t positionOfLength) noexcept {
+    if (positionOfLength < m_buffer.size()) {
+        char length[10];
+        const std::size_t SIZE{toVarInt(length, m_buffer.size() - positionOfLength - 1)};
+        try {
+            if (1 < SIZE) {
+                // The nested message is longer than 127 bytes and needs to be moved.
+                m_buffer.insert(positionOfLength + 1, SIZE - 1, '\0');
+            }
+            m_buffer.replace(positionOfLength, SIZE, length, SIZE);
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+}
+
+inline void ToProtoVisitor::append(const char *data, std::size_t size) noexcept {
+    try {
+        m_buffer.append(data, size);
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
 inline uint8_t ToProtoVisitor::toZigZag8(int8_t v) noexcept {
     return static_cast<uint8_t>((v << 1) ^ (v >> ((sizeof(v) * 8) - 1)));
 }
@@ -11241,20 +13672,27 @@ inline uint64_t ToProtoVisitor::encodeKey(uint32_t fieldIdentifier, uint8_t prot
     return (fieldIdentifier << 0x3) | protoType;
 }
 
-inline std::size_t ToProtoVisitor::toVarInt(std::ostream &out, uint64_t v) noexcept {
+inline std::size_t ToProtoVisitor::toVarInt(uint64_t v) noexcept {
+    char buffer[10];
+    const std::size_t SIZE{toVarInt(buffer, v)};
+    append(buffer, SIZE);
+    return SIZE;
+}
+
+inline std::size_t ToProtoVisitor::toVarInt(char *out, uint64_t v) noexcept {
     // Minimum size is of the encoded data.
     std::size_t size{1};
     uint8_t b{0};
     while (0x7f < v) {
         // Use the MSB to indicate value overflow for more bytes to come.
-        b = (static_cast<uint8_t>(v & 0x7f)) | 0x80;
-        out.put(static_cast<char>(b));
+        b        = (static_cast<uint8_t>(v & 0x7f)) | 0x80;
+        *(out++) = static_cast<char>(b);
         v >>= 7;
         size++;
     }
     // Write final byte.
-    b = (static_cast<uint8_t>(v)) & 0x7f;
-    out.put(static_cast<char>(b));
+    b      = (static_cast<uint8_t>(v)) & 0x7f;
+    *(out) = static_cast<char>(b);
 
     return size;
 }
@@ -11275,75 +13713,170 @@ inline std::size_t ToProtoVisitor::toVarInt(std::ostream &out, uint64_t v) noexc
 
 namespace cluon {
 
-inline void FromProtoVisitor::readBytesFromStream(std::istream &in, std::size_t bytesToReadFromStream, char *buffer) noexcept {
-    if (nullptr != buffer) {
-        const constexpr std::size_t CHUNK_SIZE{1024};
-        std::streamsize bufferPosition{0};
-        std::streamsize extractedBytes{0};
-
-        while ((0 < bytesToReadFromStream) && in.good()) {
-            // clang-format off
-            in.read(&buffer[static_cast<std::size_t>(bufferPosition)], /* Flawfinder: ignore */ /* Cf. buffer.reserve(...) above.  */
-                    (bytesToReadFromStream > CHUNK_SIZE) ? CHUNK_SIZE : static_cast<std::streamsize>(bytesToReadFromStream));
-            // clang-format on
-            extractedBytes = in.gcount();
-            bufferPosition += extractedBytes;
-            bytesToReadFromStream -= static_cast<std::size_t>(extractedBytes);
+inline void FromProtoVisitor::readFromStream(std::istream &in) noexcept {
+    m_ownedData.reset();
+    try {
+        auto buffer = std::make_shared<std::string>();
+        constexpr std::size_t CHUNK_SIZE{4096};
+        std::array<char, CHUNK_SIZE> chunk;
+        while (in.good()) {
+            in.read(chunk.data(), static_cast<std::streamsize>(CHUNK_SIZE)); // Flawfinder: ignore
+            buffer->append(chunk.data(), static_cast<std::size_t>(in.gcount()));
         }
+        m_ownedData = buffer;
+    } catch (...) { // LCOV_EXCL_LINE
     }
 }
 
 inline void FromProtoVisitor::decodeFrom(std::istream &in) noexcept {
     // Reset internal states as this deserializer could be reused.
     m_mapOfKeyValues.clear();
-    while (in.good()) {
-        // First stage: Read keyFieldType (encoded as VarInt).
-        if (0 < fromVarInt(in, m_keyFieldType)) {
-            // Succeeded to read keyFieldType entry; extract information.
-            m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
-            m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
-            switch (m_protoType) {
-                case ProtoConstants::VARINT:
-                {
-                    // Directly decode VarInt value.
-                    fromVarInt(in, m_value);
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_value));
-                }
+    readFromStream(in);
+    if (m_ownedData) {
+        decode(m_ownedData->data(), m_ownedData->size());
+    }
+}
+
+inline void FromProtoVisitor::decodeFrom(const char *data, std::size_t size) noexcept {
+    // Reset internal states as this deserializer could be reused.
+    m_mapOfKeyValues.clear();
+    m_ownedData.reset();
+    decode(data, size);
+}
+
+inline void FromProtoVisitor::decode(const char *data, std::size_t size) noexcept {
+    if (nullptr == data) {
+        return;
+    }
+    const char *position{data};
+    const char *end{data + size};
+    while ((position < end) && readField(position, end)) {
+        switch (m_protoType) {
+            case ProtoConstants::VARINT:
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_value));
                 break;
-                case ProtoConstants::EIGHT_BYTES:
-                {
-                    readBytesFromStream(in, sizeof(double), m_doubleValue.buffer.data());
-                    m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_doubleValue.doubleValue));
-                }
+            case ProtoConstants::EIGHT_BYTES:
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_doubleValue.doubleValue));
                 break;
-                case ProtoConstants::FOUR_BYTES:
-                {
-                    readBytesFromStream(in, sizeof(float), m_floatValue.buffer.data());
-                    m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_floatValue.floatValue));
-                }
+            case ProtoConstants::FOUR_BYTES:
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_floatValue.floatValue));
                 break;
-                case ProtoConstants::LENGTH_DELIMITED:
-                {
-                    fromVarInt(in, m_value);
-                    const std::size_t BYTES_TO_READ_FROM_STREAM{static_cast<std::size_t>(m_value)};
-                    if (m_stringValue.capacity() < BYTES_TO_READ_FROM_STREAM) {
-                        m_stringValue.reserve(BYTES_TO_READ_FROM_STREAM);
-                    }
-                    readBytesFromStream(in, BYTES_TO_READ_FROM_STREAM, m_stringValue.data());
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(std::string(m_stringValue.data(), static_cast<std::size_t>(m_value))));
-                }
+            case ProtoConstants::LENGTH_DELIMITED:
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_bytes));
                 break;
-            }
         }
     }
 }
 
+inline bool FromProtoVisitor::nextField() noexcept {
+    return (m_position < m_end) && readField(m_position, m_end);
+}
+
+inline uint64_t FromProtoVisitor::fieldTag() const noexcept {
+    return m_keyFieldType;
+}
+
+inline bool FromProtoVisitor::readField(const char *&position, const char *end) noexcept {
+    // First stage: Read keyFieldType (encoded as VarInt).
+    if (0 == fromVarInt(position, end, m_keyFieldType)) {
+        return false;
+    }
+
+    // Succeeded to read keyFieldType entry; extract information.
+    m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
+    m_fieldId   = static_cast<uint32_t>(m_keyFieldType >> 3);
+    switch (m_protoType) {
+        case ProtoConstants::VARINT:
+            return (0 < fromVarInt(position, end, m_value));
+        case ProtoConstants::EIGHT_BYTES:
+            if (static_cast<std::size_t>(end - position) < sizeof(double)) {
+                return false;
+            }
+            std::memcpy(m_doubleValue.buffer.data(), position, sizeof(double));
+            m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
+            position += sizeof(double);
+            return true;
+        case ProtoConstants::FOUR_BYTES:
+            if (static_cast<std::size_t>(end - position) < sizeof(float)) {
+                return false;
+            }
+            std::memcpy(m_floatValue.buffer.data(), position, sizeof(float));
+            m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
+            position += sizeof(float);
+            return true;
+        case ProtoConstants::LENGTH_DELIMITED:
+            if ((0 == fromVarInt(position, end, m_value)) || (static_cast<uint64_t>(end - position) < m_value)) {
+                return false;
+            }
+            m_bytes.data = position;
+            m_bytes.size = static_cast<std::size_t>(m_value);
+            position += m_bytes.size;
+            return true;
+    }
+    // Unsupported wire type; the remaining bytes cannot be interpreted.
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void FromProtoVisitor::decodeField(bool &v) noexcept {
+    v = (0 != m_value);
+}
+
+inline void FromProtoVisitor::decodeField(char &v) noexcept {
+    v = static_cast<char>(m_value);
+}
+
+inline void FromProtoVisitor::decodeField(int8_t &v) noexcept {
+    v = static_cast<int8_t>(fromZigZag8(static_cast<uint8_t>(m_value)));
+}
+
+inline void FromProtoVisitor::decodeField(uint8_t &v) noexcept {
+    v = static_cast<uint8_t>(m_value);
+}
+
+inline void FromProtoVisitor::decodeField(int16_t &v) noexcept {
+    v = static_cast<int16_t>(fromZigZag16(static_cast<uint16_t>(m_value)));
+}
+
+inline void FromProtoVisitor::decodeField(uint16_t &v) noexcept {
+    v = static_cast<uint16_t>(m_value);
+}
+
+inline void FromProtoVisitor::decodeField(int32_t &v) noexcept {
+    v = static_cast<int32_t>(fromZigZag32(static_cast<uint32_t>(m_value)));
+}
+
+inline void FromProtoVisitor::decodeField(uint32_t &v) noexcept {
+    v = static_cast<uint32_t>(m_value);
+}
+
+inline void FromProtoVisitor::decodeField(int64_t &v) noexcept {
+    v = static_cast<int64_t>(fromZigZag64(static_cast<uint64_t>(m_value)));
+}
+
+inline void FromProtoVisitor::decodeField(uint64_t &v) noexcept {
+    v = m_value;
+}
+
+inline void FromProtoVisitor::decodeField(float &v) noexcept {
+    v = m_floatValue.floatValue;
+}
+
+inline void FromProtoVisitor::decodeField(double &v) noexcept {
+    v = m_doubleValue.doubleValue;
+}
+
+inline void FromProtoVisitor::decodeField(std::string &v) noexcept {
+    v.assign(m_bytes.data, m_bytes.size);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 inline FromProtoVisitor &FromProtoVisitor::operator=(const FromProtoVisitor &other) noexcept {
     m_mapOfKeyValues = other.m_mapOfKeyValues;
+    // Keep the bytes alive that length-delimited fields refer to.
+    m_ownedData = other.m_ownedData;
     return *this;
 }
 
@@ -11361,7 +13894,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = (0 != m_value);
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11375,7 +13908,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<char>(m_value);
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11390,7 +13923,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<int8_t>(fromZigZag8(static_cast<uint8_t>(m_value)));
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11405,7 +13938,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<uint8_t>(m_value);
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11420,7 +13953,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<int16_t>(fromZigZag16(static_cast<uint16_t>(m_value)));
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11435,7 +13968,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<uint16_t>(m_value);
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11450,7 +13983,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<int32_t>(fromZigZag32(static_cast<uint32_t>(m_value)));
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11465,7 +13998,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<uint32_t>(m_value);
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11480,7 +14013,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = static_cast<int64_t>(fromZigZag64(static_cast<uint64_t>(m_value)));
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11495,7 +14028,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = m_value;
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11509,7 +14042,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = m_floatValue.floatValue;
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11523,7 +14056,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = m_doubleValue.doubleValue;
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11537,11 +14070,12 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = std::string(m_stringValue.data(), static_cast<std::size_t>(m_value));
+        decodeField(v);
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
-            v = linb::any_cast<std::string>(m_mapOfKeyValues[id]);
+            const Bytes bytes{linb::any_cast<Bytes>(m_mapOfKeyValues[id])};
+            v.assign(bytes.data, bytes.size);
         } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
         }
     }
@@ -11565,25 +14099,63 @@ inline int64_t FromProtoVisitor::fromZigZag64(uint64_t v) noexcept {
     return static_cast<int64_t>((v >> 1) ^ -(v & 1));
 }
 
-inline std::size_t FromProtoVisitor::fromVarInt(std::istream &in, uint64_t &value) noexcept {
+inline std::size_t FromProtoVisitor::fromVarInt(const char *&position, const char *end, uint64_t &value) noexcept {
+    const std::size_t AVAILABLE{static_cast<std::size_t>(end - position)};
+
+    // Single-byte VarInts (field keys, small values) are the most frequent ones.
+    if ((0 < AVAILABLE) && (0 == (static_cast<uint8_t>(*position) & 0x80))) {
+        value = static_cast<uint8_t>(*position++);
+        return 1;
+    }
+
+    // VarInts of up to 8 bytes are decoded from one 64-bit word without a loop:
+    // the first byte with cleared MSB terminates the VarInt and the 7-bit groups
+    // of the bytes up to it are compacted in three shift-and-mask steps.
+    if (sizeof(uint64_t) <= AVAILABLE) {
+        uint64_t word{0};
+        std::memcpy(&word, position, sizeof(uint64_t));
+        word = le64toh(word);
+        const uint64_t TERMINATORS{~word & 0x8080808080808080ull};
+        if (0 != TERMINATORS) {
+            // All bits up to and including the lowest terminating MSB.
+            const uint64_t VARINT_BYTES{TERMINATORS ^ (TERMINATORS - 1)};
+            // Count the bytes of the VarInt by summing one bit per byte into the topmost byte.
+            const std::size_t SIZE{static_cast<std::size_t>(((VARINT_BYTES & 0x0101010101010101ull) * 0x0101010101010101ull) >> 56)};
+
+            uint64_t v{word & VARINT_BYTES & 0x7f7f7f7f7f7f7f7full};
+            v = (v & 0x007f007f007f007full) | ((v & 0x7f007f007f007f00ull) >> 1);
+            v = (v & 0x00003fff00003fffull) | ((v & 0x3fff00003fff0000ull) >> 2);
+            v = (v & 0x000000000fffffffull) | ((v & 0x0fffffff00000000ull) >> 4);
+
+            value = v;
+            position += SIZE;
+            return SIZE;
+        }
+    }
+
+    // Byte-wise decoding close to the end of the buffer and for VarInts longer than 8 bytes.
     value = 0;
 
     constexpr uint64_t MASK  = 0x7f;
     constexpr uint64_t SHIFT = 0x7;
     constexpr uint64_t MSB   = 0x80;
+    // A 64-bit value is encoded in at most 10 bytes.
+    constexpr std::size_t MAX_SIZE{10};
 
     std::size_t size = 0;
     uint64_t C{0};
-    while (in.good()) {
-        auto x = in.get();
-        C = static_cast<uint64_t>(x);
+    const char *p{position};
+    while ((p < end) && (size < MAX_SIZE)) {
+        C = static_cast<uint8_t>(*p++);
         value |= (C & MASK) << (SHIFT * size++);
         if (!(C & MSB)) { // NOLINT
-            break;
+            position = p;
+            return size;
         }
     }
 
-    return size;
+    // Truncated or overlong VarInt.
+    return 0;
 }
 } // namespace cluon
 /*
@@ -12595,142 +15167,165 @@ inline void FromJSONVisitor::visit(uint32_t id, std::string &&typeName, std::str
  */
 
 //#include "cluon/GenericMessage.hpp"
+//#include "cluon/ProtoConstants.hpp"
 
-#include <istream>
-#include <iterator>
-#include <regex>
+#include <memory>
+#include <utility>
 
 namespace cluon {
 
+inline void GenericMessage::Layout::add(const MetaMessage::MetaField &mf, std::size_t index) noexcept {
+    Field f;
+    f.m_fieldDataType     = mf.fieldDataType();
+    f.m_fieldIdentifier   = mf.fieldIdentifier();
+    f.m_index             = index;
+    f.m_fieldDataTypeName = mf.fieldDataTypeName();
+    f.m_fieldName         = mf.fieldName();
+
+    // All other types are encoded as VarInt.
+    ProtoConstants wireType{ProtoConstants::VARINT};
+    if (MetaMessage::MetaField::FLOAT_T == f.m_fieldDataType) {
+        wireType = ProtoConstants::FOUR_BYTES;
+    } else if (MetaMessage::MetaField::DOUBLE_T == f.m_fieldDataType) {
+        wireType = ProtoConstants::EIGHT_BYTES;
+    } else if ((MetaMessage::MetaField::STRING_T == f.m_fieldDataType) || (MetaMessage::MetaField::BYTES_T == f.m_fieldDataType)
+               || (MetaMessage::MetaField::MESSAGE_T == f.m_fieldDataType)) {
+        wireType = ProtoConstants::LENGTH_DELIMITED;
+    }
+    f.m_protoTag = (static_cast<uint64_t>(f.m_fieldIdentifier) << 3) | static_cast<uint8_t>(wireType);
+
+    // Larger field identifiers are looked up linearly.
+    constexpr uint32_t MAX_INDEXED_FIELD_IDENTIFIER{256};
+    if (f.m_fieldIdentifier < MAX_INDEXED_FIELD_IDENTIFIER) {
+        if (m_fieldsByIdentifier.size() <= f.m_fieldIdentifier) {
+            m_fieldsByIdentifier.resize(f.m_fieldIdentifier + 1, 0);
+        }
+        m_fieldsByIdentifier[f.m_fieldIdentifier] = m_fields.size() + 1;
+    }
+    m_fields.push_back(std::move(f));
+}
+
+inline const GenericMessage::Layout::Field *GenericMessage::Layout::find(uint32_t fieldIdentifier) const noexcept {
+    const Field *retVal{nullptr};
+    if (fieldIdentifier < m_fieldsByIdentifier.size()) {
+        const std::size_t POSITION{m_fieldsByIdentifier[fieldIdentifier]};
+        retVal = ((0 < POSITION) ? &m_fields[POSITION - 1] : nullptr);
+    } else {
+        for (const auto &f : m_fields) {
+            if (fieldIdentifier == f.m_fieldIdentifier) {
+                retVal = &f;
+            }
+        }
+    }
+    return retVal;
+}
+
+inline void GenericMessage::Layout::updateNames() noexcept {
+    m_longName = m_metaMessage.packageName() + (!m_metaMessage.packageName().empty() ? "." : "") + m_metaMessage.messageName();
+
+    const auto pos = m_longName.find_last_of('.');
+    m_shortName    = ((std::string::npos != pos) ? m_longName.substr(pos + 1) : m_longName);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline GenericMessage::GenericMessageVisitor::GenericMessageVisitor(GenericMessage &gm, Layout &layout) noexcept
+    : m_genericMessage(gm)
+    , m_layout(layout) {}
+
 inline void GenericMessage::GenericMessageVisitor::preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept {
     (void)longName;
-    m_metaMessage.messageIdentifier(id).messageName(shortName);
+    m_layout.m_metaMessage.messageIdentifier(id).messageName(shortName);
     if (!longName.empty()) {
         const auto pos = longName.rfind(shortName);
         if (std::string::npos != pos) {
-            m_metaMessage.packageName(longName.substr(0, pos - 1));
+            m_layout.m_metaMessage.packageName(longName.substr(0, pos - 1));
         }
     }
 }
 
 inline void GenericMessage::GenericMessageVisitor::postVisit() noexcept {}
 
-inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, bool &v) noexcept {
+inline GenericMessage::Scalar &GenericMessage::GenericMessageVisitor::addScalar(uint32_t id,
+                                                                                 MetaMessage::MetaField::MetaFieldDataTypes fieldDataType,
+                                                                                 std::string &&typeName,
+                                                                                 std::string &&name) noexcept {
     cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::BOOL_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    mf.fieldIdentifier(id).fieldDataType(fieldDataType).fieldDataTypeName(typeName).fieldName(name);
+    m_layout.add(mf, m_genericMessage.m_scalars.size());
+    m_layout.m_metaMessage.add(std::move(mf));
+    m_genericMessage.m_scalars.push_back(Scalar{});
+    return m_genericMessage.m_scalars.back();
+}
+
+inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, bool &v) noexcept {
+    addScalar(id, cluon::MetaMessage::MetaField::BOOL_T, std::move(typeName), std::move(name)).m_bool = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, char &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::CHAR_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::CHAR_T, std::move(typeName), std::move(name)).m_char = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int8_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::INT8_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::INT8_T, std::move(typeName), std::move(name)).m_int8 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint8_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::UINT8_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::UINT8_T, std::move(typeName), std::move(name)).m_uint8 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int16_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::INT16_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::INT16_T, std::move(typeName), std::move(name)).m_int16 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint16_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::UINT16_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::UINT16_T, std::move(typeName), std::move(name)).m_uint16 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int32_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::INT32_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::INT32_T, std::move(typeName), std::move(name)).m_int32 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint32_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::UINT32_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::UINT32_T, std::move(typeName), std::move(name)).m_uint32 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int64_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::INT64_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::INT64_T, std::move(typeName), std::move(name)).m_int64 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint64_t &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::UINT64_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::UINT64_T, std::move(typeName), std::move(name)).m_uint64 = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, float &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::FLOAT_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::FLOAT_T, std::move(typeName), std::move(name)).m_float = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
-    cluon::MetaMessage::MetaField mf;
-    mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::DOUBLE_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
+    addScalar(id, cluon::MetaMessage::MetaField::DOUBLE_T, std::move(typeName), std::move(name)).m_double = v;
 }
 
 inline void GenericMessage::GenericMessageVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
     cluon::MetaMessage::MetaField mf;
     mf.fieldIdentifier(id).fieldDataType(cluon::MetaMessage::MetaField::STRING_T).fieldDataTypeName(typeName).fieldName(name);
-    m_intermediateDataRepresentation[mf.fieldIdentifier()] = linb::any{v};
-    m_metaMessage.add(std::move(mf));
-}
-
-inline MetaMessage GenericMessage::GenericMessageVisitor::metaMessage() const noexcept {
-    return m_metaMessage;
-}
-
-inline std::unordered_map<uint32_t, linb::any, UseUInt32ValueAsHashKey> GenericMessage::GenericMessageVisitor::intermediateDataRepresentation() const noexcept {
-    return m_intermediateDataRepresentation;
+    m_layout.add(mf, m_genericMessage.m_strings.size());
+    m_layout.m_metaMessage.add(std::move(mf));
+    m_genericMessage.m_strings.push_back(v);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 inline int32_t GenericMessage::ID() {
-    return m_metaMessage.messageIdentifier();
+    return m_layout->m_metaMessage.messageIdentifier();
 }
 
 inline const std::string GenericMessage::ShortName() {
-    std::string tmp{LongName()};
-    std::replace(tmp.begin(), tmp.end(), '.', ' ');
-    std::istringstream sstr{tmp};
-    std::vector<std::string> tokens{std::istream_iterator<std::string>(sstr), std::istream_iterator<std::string>()};
-
-    return tokens.back();
+    return m_layout->m_shortName;
 }
 
 inline const std::string GenericMessage::LongName() {
-    return m_metaMessage.packageName() + (!m_metaMessage.packageName().empty() ? "." : "") + m_metaMessage.messageName();
+    return m_layout->m_longName;
 }
 
 inline void GenericMessage::preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept {
@@ -12744,248 +15339,176 @@ inline void GenericMessage::postVisit() noexcept {}
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, bool &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<bool>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::BOOL_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_bool;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, char &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<char>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::CHAR_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_char;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, int8_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<int8_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::INT8_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_int8;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, uint8_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<uint8_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::UINT8_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_uint8;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, int16_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<int16_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::INT16_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_int16;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, uint16_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<uint16_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::UINT16_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_uint16;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, int32_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<int32_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::INT32_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_int32;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, uint32_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<uint32_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::UINT32_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_uint32;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, int64_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<int64_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::INT64_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_int64;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, uint64_t &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<uint64_t>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::UINT64_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_uint64;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, float &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<float>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::FLOAT_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_float;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<double>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && (MetaMessage::MetaField::DOUBLE_T == f->m_fieldDataType)) {
+        v = m_scalars[f->m_index].m_double;
     }
 }
 
 inline void GenericMessage::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
     (void)typeName;
     (void)name;
-    if (0 < m_intermediateDataRepresentation.count(id)) {
-        try {
-            v = linb::any_cast<std::string>(m_intermediateDataRepresentation[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-        }
+    const Layout::Field *f{m_layout->find(id)};
+    if ((nullptr != f) && ((MetaMessage::MetaField::STRING_T == f->m_fieldDataType) || (MetaMessage::MetaField::BYTES_T == f->m_fieldDataType))) {
+        v = m_strings[f->m_index];
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 inline void GenericMessage::createFrom(const MetaMessage &mm, const std::vector<MetaMessage> &mms) noexcept {
-    m_metaMessage = mm;
-    m_longName    = m_metaMessage.messageName();
+    std::unordered_map<std::string, MetaMessage> scope;
+    for (const auto &e : mms) { scope[e.messageName()] = e; }
 
-    m_scopeOfMetaMessages.clear();
-    m_scopeOfMetaMessages = mms;
-
-    m_mapForScopeOfMetaMessages.clear();
-    for (const auto &e : m_scopeOfMetaMessages) { m_mapForScopeOfMetaMessages[e.messageName()] = e; }
+    createFrom(mm, scope);
+}
 
-    m_intermediateDataRepresentation.clear();
-    for (const auto &f : m_metaMessage.listOfMetaFields()) {
-        if (f.fieldDataType() == MetaMessage::MetaField::BOOL_T) {
-            try {
-                linb::any _v{false};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::CHAR_T) {
-            try {
-                linb::any _v{static_cast<char>('\0')};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::UINT8_T) {
-            try {
-                linb::any _v{static_cast<uint8_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::INT8_T) {
-            try {
-                linb::any _v{static_cast<int8_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::UINT16_T) {
-            try {
-                linb::any _v{static_cast<uint16_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::INT16_T) {
-            try {
-                linb::any _v{static_cast<int16_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::UINT32_T) {
-            try {
-                linb::any _v{static_cast<uint32_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::INT32_T) {
-            try {
-                linb::any _v{static_cast<int32_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::UINT64_T) {
-            try {
-                linb::any _v{static_cast<uint64_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::INT64_T) {
-            try {
-                linb::any _v{static_cast<int64_t>(0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::FLOAT_T) {
-            try {
-                linb::any _v{static_cast<float>(0.0f)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::DOUBLE_T) {
-            try {
-                linb::any _v{static_cast<double>(0.0)};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if ((f.fieldDataType() == MetaMessage::MetaField::STRING_T) || (f.fieldDataType() == MetaMessage::MetaField::BYTES_T)) {
-            try {
-                linb::any _v                                          = std::string{};
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = _v;
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
-            }
-        } else if (f.fieldDataType() == MetaMessage::MetaField::MESSAGE_T) {
-            if (0 < m_mapForScopeOfMetaMessages.count(f.fieldDataTypeName())) {
-                // Create a GenericMessage from the decoded Proto-data.
-                cluon::GenericMessage gm;
-                gm.createFrom(m_mapForScopeOfMetaMessages[f.fieldDataTypeName()], m_scopeOfMetaMessages);
+inline void GenericMessage::createFrom(const MetaMessage &mm, const std::unordered_map<std::string, MetaMessage> &scope) noexcept {
+    std::shared_ptr<Layout> layout{std::make_shared<Layout>()};
+    layout->m_metaMessage       = mm;
+    layout->m_specificationName = mm.messageName();
 
-                m_intermediateDataRepresentation[f.fieldIdentifier()] = linb::any{gm};
+    m_scalars.clear();
+    m_strings.clear();
+    m_messages.clear();
+    for (const auto &f : mm.listOfMetaFields()) {
+        switch (f.fieldDataType()) {
+            case MetaMessage::MetaField::BOOL_T:
+            case MetaMessage::MetaField::CHAR_T:
+            case MetaMessage::MetaField::UINT8_T:
+            case MetaMessage::MetaField::INT8_T:
+            case MetaMessage::MetaField::UINT16_T:
+            case MetaMessage::MetaField::INT16_T:
+            case MetaMessage::MetaField::UINT32_T:
+            case MetaMessage::MetaField::INT32_T:
+            case MetaMessage::MetaField::UINT64_T:
+            case MetaMessage::MetaField::INT64_T:
+            case MetaMessage::MetaField::FLOAT_T:
+            case MetaMessage::MetaField::DOUBLE_T:
+                layout->add(f, m_scalars.size());
+                // All bits zero, i.e., false, '\0', 0, or 0.0.
+                m_scalars.push_back(Scalar{});
+                break;
+            case MetaMessage::MetaField::STRING_T:
+            case MetaMessage::MetaField::BYTES_T:
+                layout->add(f, m_strings.size());
+                m_strings.emplace_back();
+                break;
+            case MetaMessage::MetaField::MESSAGE_T: {
+                auto it = scope.find(f.fieldDataTypeName());
+                if (it != scope.end()) {
+                    cluon::GenericMessage gm;
+                    gm.createFrom(it->second, scope);
+
+                    layout->add(f, m_messages.size());
+                    m_messages.push_back(std::move(gm));
+                }
+                break;
             }
+            default: break;
         }
     }
+    layout->updateNames();
+    m_layout = layout;
 }
 
 } // namespace cluon
@@ -12999,20 +15522,41 @@ inline void GenericMessage::createFrom(const MetaMessage &mm, const std::vector<
 
 //#include "cluon/ToJSONVisitor.hpp"
 
-#include <iomanip>
-#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
 
 namespace cluon {
 
 inline ToJSONVisitor::ToJSONVisitor(bool withOuterCurlyBraces, const std::map<uint32_t, bool> &mask) noexcept
     : m_withOuterCurlyBraces(withOuterCurlyBraces)
-    , m_mask(mask) {}
+    , m_mask(mask)
+    , m_buffer(m_data) {}
+
+inline ToJSONVisitor::ToJSONVisitor(std::string &buffer, bool withOuterCurlyBraces, const std::map<uint32_t, bool> &mask) noexcept
+    : m_withOuterCurlyBraces(withOuterCurlyBraces)
+    , m_mask(mask)
+    , m_buffer(buffer)
+    , m_appendToBuffer(true)
+    , m_begin(buffer.size()) {}
 
 inline std::string ToJSONVisitor::json() const noexcept {
-    const std::string tmp{m_buffer.str()};
+    if (m_appendToBuffer) {
+        return m_buffer.substr(m_begin);
+    }
     std::string retVal{"{}"};
-    if (2 < tmp.size()) {
-        retVal = {(m_withOuterCurlyBraces ? "{" : "") + tmp.substr(0, tmp.size() - 2) + (m_withOuterCurlyBraces ? "}" : "")};
+    if (2 < m_data.size()) {
+        retVal.clear();
+        retVal.reserve(m_data.size());
+        if (m_withOuterCurlyBraces) {
+            retVal += '{';
+        }
+        retVal.append(m_data, 0, m_data.size() - 2);
+        if (m_withOuterCurlyBraces) {
+            retVal += '}';
+        }
     }
     return retVal;
 }
@@ -13021,98 +15565,203 @@ inline void ToJSONVisitor::preVisit(int32_t id, const std::string &shortName, co
     (void)id;
     (void)longName;
     (void)shortName;
+    if (m_appendToBuffer && (0 == m_nesting)) {
+        m_begin = m_buffer.size();
+        if (m_withOuterCurlyBraces) {
+            m_buffer += '{';
+        }
+    }
+}
+
+inline void ToJSONVisitor::postVisit() noexcept {
+    if (m_appendToBuffer && (0 == m_nesting)) {
+        if (m_withOuterCurlyBraces) {
+            closeObject(m_begin + 1);
+        } else if (m_begin < m_buffer.size()) {
+            // Remove trailing ",\n".
+            m_buffer.resize(m_buffer.size() - 2);
+        }
+    }
+}
+
+inline bool ToJSONVisitor::isRendered(uint32_t id) noexcept {
+    return (0 < m_nesting) || m_mask.empty() || (0 == m_mask.count(id)) || m_mask[id];
+}
+
+inline void ToJSONVisitor::appendKey(const std::string &name) noexcept {
+    m_buffer += '\"';
+    m_buffer += name;
+    m_buffer += "\":";
+}
+
+inline void ToJSONVisitor::appendUnsigned(uint64_t v) noexcept {
+    // Render digits from the back into a buffer large enough for 2^64-1.
+    char digits[20];
+    char *end{digits + sizeof(digits)};
+    char *begin{end};
+    do {
+        *--begin = static_cast<char>('0' + (v % 10));
+        v /= 10;
+    } while (0 != v);
+    m_buffer.append(begin, static_cast<std::size_t>(end - begin));
 }
 
-inline void ToJSONVisitor::postVisit() noexcept {}
+inline void ToJSONVisitor::appendSigned(int64_t v) noexcept {
+    if (v < 0) {
+        m_buffer += '-';
+        appendUnsigned(0 - static_cast<uint64_t>(v));
+    } else {
+        appendUnsigned(static_cast<uint64_t>(v));
+    }
+}
+
+template <typename T>
+inline void ToJSONVisitor::appendFloatingPoint(T v) noexcept {
+    // Find the shortest precision that reads back into the identical value,
+    // starting from the number of digits that is always exact for T.
+    char tmp[32];
+    int length{0};
+    for (int precision{std::numeric_limits<T>::digits10}; precision <= std::numeric_limits<T>::max_digits10; precision++) {
+        length = std::snprintf(tmp, sizeof(tmp), "%.*g", precision, static_cast<double>(v));
+        if (!std::isfinite(v)) {
+            break;
+        }
+        const T readBack{std::is_same<T, float>::value ? static_cast<T>(std::strtof(tmp, nullptr)) : static_cast<T>(std::strtod(tmp, nullptr))};
+        if (!(readBack < v) && !(v < readBack)) {
+            break;
+        }
+    }
+    if (0 < length) {
+        m_buffer.append(tmp, static_cast<std::size_t>(length));
+    }
+}
+
+inline void ToJSONVisitor::closeObject(std::size_t begin) noexcept {
+    if (begin < m_buffer.size()) {
+        // Remove trailing ",\n".
+        m_buffer.resize(m_buffer.size() - 2);
+    }
+    m_buffer += '}';
+}
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, bool &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        m_buffer += (v ? '1' : '0');
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, char &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << '\"' << v << '\"' << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        m_buffer += '\"';
+        m_buffer += v;
+        m_buffer += '\"';
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int8_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << +v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendSigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint8_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << +v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendUnsigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int16_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << +v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendSigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint16_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << +v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendUnsigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int32_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendSigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint32_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendUnsigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int64_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendSigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint64_t &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << v << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendUnsigned(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, float &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << std::setprecision(7) << v << std::setprecision(6) << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendFloatingPoint(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << std::setprecision(11) << v << std::setprecision(6) << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        appendFloatingPoint(v);
+        m_buffer += ",\n";
     }
 }
 
 inline void ToJSONVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
     (void)typeName;
-    if ((0 == m_mask.count(id)) || m_mask[id]) {
-        m_buffer << '\"' << name << '\"' << ':' << '\"' << ToJSONVisitor::encodeBase64(v) << '\"' << ',' << '\n';
+    if (isRendered(id)) {
+        appendKey(name);
+        m_buffer += '\"';
+        m_buffer += ToJSONVisitor::encodeBase64(v);
+        m_buffer += '\"';
+        m_buffer += ",\n";
     }
 }
 
@@ -13121,6 +15770,7 @@ inline std::string ToJSONVisitor::encodeBase64(const std::string &input) noexcep
 
     const std::string ALPHABET{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
     auto length{input.length()};
+    retVal.reserve(((length + 2) / 3) * 4);
     uint32_t index{0};
     uint32_t value{0};
 
@@ -13919,6 +16569,314 @@ inline void ToMsgPackVisitor::visit(uint32_t id, std::string &&typeName, std::st
     m_numberOfFields++;
 }
 
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/OD4Fragmentation.hpp"
+//#include "cluon/PortableEndian.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+
+namespace cluon {
+
+inline bool isOD4Fragment(const char *data, std::size_t size) noexcept {
+    constexpr unsigned char OD4_FRAGMENT_BYTE0 = 0x0D;
+    constexpr unsigned char OD4_FRAGMENT_BYTE1 = 0xA5;
+    return (nullptr != data) && (OD4_FRAGMENT_HEADER_SIZE <= size) && (OD4_FRAGMENT_BYTE0 == static_cast<uint8_t>(data[0]))
+           && (OD4_FRAGMENT_BYTE1 == static_cast<uint8_t>(data[1]));
+}
+
+inline std::vector<std::string> fragmentOD4Frame(const std::string &frame, uint32_t sequenceNumber, std::size_t maxFragmentSize) noexcept {
+    std::vector<std::string> fragments;
+    if (!frame.empty() && (OD4_FRAGMENT_HEADER_SIZE < maxFragmentSize)) {
+        const std::size_t MAX_PAYLOAD{maxFragmentSize - OD4_FRAGMENT_HEADER_SIZE};
+        const std::size_t NUMBER_OF_FRAGMENTS{(frame.size() + MAX_PAYLOAD - 1) / MAX_PAYLOAD};
+        if ((NUMBER_OF_FRAGMENTS <= 0xFFFF) && (frame.size() <= 0xFFFFFFFF)) {
+            try {
+                fragments.reserve(NUMBER_OF_FRAGMENTS);
+                const uint32_t SEQUENCE{htole32(sequenceNumber)};
+                const uint16_t COUNT{htole16(static_cast<uint16_t>(NUMBER_OF_FRAGMENTS))};
+                const uint32_t LENGTH{htole32(static_cast<uint32_t>(frame.size()))};
+                for (std::size_t i{0}; i < NUMBER_OF_FRAGMENTS; i++) {
+                    const std::size_t OFFSET{i * MAX_PAYLOAD};
+                    const std::size_t PAYLOAD{std::min(MAX_PAYLOAD, frame.size() - OFFSET)};
+                    const uint16_t INDEX{htole16(static_cast<uint16_t>(i))};
+                    const uint32_t POSITION{htole32(static_cast<uint32_t>(OFFSET))};
+
+                    std::string fragment(OD4_FRAGMENT_HEADER_SIZE + PAYLOAD, '\0');
+                    fragment[0] = static_cast<char>(0x0D);
+                    fragment[1] = static_cast<char>(0xA5);
+                    std::memcpy(&fragment[2], &SEQUENCE, sizeof(uint32_t));
+                    std::memcpy(&fragment[6], &INDEX, sizeof(uint16_t));
+                    std::memcpy(&fragment[8], &COUNT, sizeof(uint16_t));
+                    std::memcpy(&fragment[10], &LENGTH, sizeof(uint32_t));
+                    std::memcpy(&fragment[14], &POSITION, sizeof(uint32_t));
+                    std::memcpy(&fragment[OD4_FRAGMENT_HEADER_SIZE], frame.data() + OFFSET, PAYLOAD);
+                    fragments.emplace_back(std::move(fragment));
+                }
+            } catch (...) { fragments.clear(); } // LCOV_EXCL_LINE
+        }
+    }
+    return fragments;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline OD4FragmentAssembler::OD4FragmentAssembler(std::size_t maxBufferedBytes, std::chrono::milliseconds timeout) noexcept
+    : m_maxBufferedBytes(maxBufferedBytes)
+    , m_timeout(timeout) {}
+
+inline uint64_t OD4FragmentAssembler::numberOfCompletedFrames() const noexcept {
+    return m_numberOfCompletedFrames;
+}
+
+inline uint64_t OD4FragmentAssembler::numberOfDroppedFrames() const noexcept {
+    return m_numberOfDroppedFrames;
+}
+
+inline std::pair<bool, std::string> OD4FragmentAssembler::add(uint64_t sender,
+                                                              const char *data,
+                                                              std::size_t size,
+                                                              const std::chrono::system_clock::time_point &receivedAt) noexcept {
+    std::pair<bool, std::string> retVal{false, ""};
+    if (!isOD4Fragment(data, size)) {
+        return retVal;
+    }
+
+    uint32_t sequenceNumber{0};
+    uint16_t index{0};
+    uint16_t count{0};
+    uint32_t length{0};
+    uint32_t offset{0};
+    std::memcpy(&sequenceNumber, data + 2, sizeof(uint32_t));
+    std::memcpy(&index, data + 6, sizeof(uint16_t));
+    std::memcpy(&count, data + 8, sizeof(uint16_t));
+    std::memcpy(&length, data + 10, sizeof(uint32_t));
+    std::memcpy(&offset, data + 14, sizeof(uint32_t));
+    sequenceNumber = le32toh(sequenceNumber);
+    index          = le16toh(index);
+    count          = le16toh(count);
+    length         = le32toh(length);
+    offset         = le32toh(offset);
+
+    const std::size_t PAYLOAD{size - OD4_FRAGMENT_HEADER_SIZE};
+    if ((0 == count) || (index >= count) || (0 == length) || (OD4_MAX_FRAME_SIZE < length) || (static_cast<std::size_t>(offset) + PAYLOAD > length)
+        || (length > m_maxBufferedBytes)) {
+        return retVal;
+    }
+
+    dropExpiredFrames(receivedAt);
+
+    try {
+        const auto KEY{std::make_pair(sender, sequenceNumber)};
+        auto it = m_pendingFrames.find(KEY);
+        if ((it != m_pendingFrames.end()) && ((it->second.m_data.size() != length) || (it->second.m_receivedFragments.size() != count))) {
+            // Sequence number was reused for a different OD4 frame; start over.
+            m_bufferedBytes -= it->second.m_data.size();
+            m_pendingFrames.erase(it);
+            m_numberOfDroppedFrames++;
+            it = m_pendingFrames.end();
+        }
+        if (it == m_pendingFrames.end()) {
+            while (!m_pendingFrames.empty() && (m_bufferedBytes + length > m_maxBufferedBytes)) {
+                dropOldestFrame();
+            }
+            PendingFrame pf;
+            pf.m_data.resize(length);
+            pf.m_receivedFragments.resize(count, false);
+            pf.m_missingFragments        = count;
+            pf.m_firstFragmentReceivedAt = receivedAt;
+            it                           = m_pendingFrames.emplace(KEY, std::move(pf)).first;
+            m_bufferedBytes += length;
+        }
+
+        PendingFrame &pf = it->second;
+        if (!pf.m_receivedFragments[index]) {
+            std::memcpy(&pf.m_data[offset], data + OD4_FRAGMENT_HEADER_SIZE, PAYLOAD);
+            pf.m_receivedFragments[index] = true;
+            pf.m_missingFragments--;
+        }
+
+        if (0 == pf.m_missingFragments) {
+            retVal.first  = true;
+            retVal.second = std::move(pf.m_data);
+            m_bufferedBytes -= length;
+            m_pendingFrames.erase(it);
+            m_numberOfCompletedFrames++;
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+
+    return retVal;
+}
+
+inline void OD4FragmentAssembler::dropExpiredFrames(const std::chrono::system_clock::time_point &now) noexcept {
+    for (auto it = m_pendingFrames.begin(); it != m_pendingFrames.end();) {
+        if (now - it->second.m_firstFragmentReceivedAt > m_timeout) {
+            m_bufferedBytes -= it->second.m_data.size();
+            it = m_pendingFrames.erase(it);
+            m_numberOfDroppedFrames++;
+        } else {
+            it++;
+        }
+    }
+}
+
+inline void OD4FragmentAssembler::dropOldestFrame() noexcept {
+    auto oldest = std::min_element(m_pendingFrames.begin(), m_pendingFrames.end(), [](const auto &a, const auto &b) {
+        return a.second.m_firstFragmentReceivedAt < b.second.m_firstFragmentReceivedAt;
+    });
+    if (oldest != m_pendingFrames.end()) {
+        m_bufferedBytes -= oldest->second.m_data.size();
+        m_pendingFrames.erase(oldest);
+        m_numberOfDroppedFrames++;
+    }
+}
+
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/TimeTrigger.hpp"
+
+// clang-format off
+#ifndef WIN32
+    #include <cerrno>
+    #include <time.h>
+#endif
+// clang-format on
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace cluon {
+namespace time {
+
+inline std::chrono::nanoseconds monotonicNow() noexcept {
+#ifdef WIN32
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+#else
+    struct timespec ts {};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+#endif
+}
+
+inline void sleepUntil(std::chrono::nanoseconds deadline, std::chrono::microseconds busyWait) noexcept {
+    const std::chrono::nanoseconds WAKEUP{deadline - busyWait};
+#ifdef __linux__
+    if (0 < WAKEUP.count()) {
+        struct timespec ts {};
+        ts.tv_sec  = static_cast<time_t>(WAKEUP.count() / (1000 * 1000 * 1000));
+        ts.tv_nsec = static_cast<long>(WAKEUP.count() % (1000 * 1000 * 1000));
+        while (EINTR == ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)) {}
+    }
+#else
+    const std::chrono::nanoseconds NOW{monotonicNow()};
+    if (WAKEUP > NOW) {
+        std::this_thread::sleep_for(WAKEUP - NOW);
+    }
+#endif
+    // Busy-wait for the remaining time.
+    while (monotonicNow() < deadline) {}
+}
+
+} // namespace time
+
+inline void TimeTriggerStatistics::add(std::chrono::nanoseconds jitter, std::chrono::nanoseconds overrun, uint64_t skippedCycles) noexcept {
+    jitter = std::max(jitter, std::chrono::nanoseconds(0));
+    m_numberOfCycles++;
+    m_sumOfJitter += jitter;
+    m_maxJitter = std::max(m_maxJitter, jitter);
+    m_jitterHistogram[bucket(jitter)]++;
+    if (overrun > std::chrono::nanoseconds(0)) {
+        m_numberOfOverruns++;
+        m_numberOfSkippedCycles += skippedCycles;
+        m_maxOverrun = std::max(m_maxOverrun, overrun);
+        m_overrunHistogram[bucket(overrun)]++;
+    }
+}
+
+inline void TimeTriggerStatistics::clear() noexcept {
+    *this = TimeTriggerStatistics();
+}
+
+inline uint64_t TimeTriggerStatistics::numberOfCycles() const noexcept {
+    return m_numberOfCycles;
+}
+
+inline uint64_t TimeTriggerStatistics::numberOfOverruns() const noexcept {
+    return m_numberOfOverruns;
+}
+
+inline uint64_t TimeTriggerStatistics::numberOfSkippedCycles() const noexcept {
+    return m_numberOfSkippedCycles;
+}
+
+inline std::chrono::nanoseconds TimeTriggerStatistics::meanJitter() const noexcept {
+    return (0 < m_numberOfCycles) ? m_sumOfJitter / static_cast<int64_t>(m_numberOfCycles) : std::chrono::nanoseconds(0);
+}
+
+inline std::chrono::nanoseconds TimeTriggerStatistics::maxJitter() const noexcept {
+    return m_maxJitter;
+}
+
+inline std::chrono::nanoseconds TimeTriggerStatistics::maxOverrun() const noexcept {
+    return m_maxOverrun;
+}
+
+inline const std::array<uint64_t, TimeTriggerStatistics::NUMBER_OF_BUCKETS> &TimeTriggerStatistics::jitterHistogram() const noexcept {
+    return m_jitterHistogram;
+}
+
+inline const std::array<uint64_t, TimeTriggerStatistics::NUMBER_OF_BUCKETS> &TimeTriggerStatistics::overrunHistogram() const noexcept {
+    return m_overrunHistogram;
+}
+
+inline uint8_t TimeTriggerStatistics::bucket(std::chrono::nanoseconds duration) noexcept {
+    uint8_t retVal{0};
+    for (int64_t us{duration.count() / 1000}; (0 < us) && (retVal < NUMBER_OF_BUCKETS - 1); us >>= 1) {
+        retVal++;
+    }
+    return retVal;
+}
+
+inline std::string TimeTriggerStatistics::toString() const noexcept {
+    std::stringstream sstr;
+    try {
+        auto histogram = [&sstr](const std::array<uint64_t, NUMBER_OF_BUCKETS> &buckets) {
+            for (uint8_t i{0}; i < NUMBER_OF_BUCKETS; i++) {
+                if (0 < buckets[i]) {
+                    sstr << ' ' << ((NUMBER_OF_BUCKETS - 1 == i) ? ">=" : "<") << (static_cast<uint64_t>(1) << ((NUMBER_OF_BUCKETS - 1 == i) ? i - 1 : i))
+                         << "us:" << buckets[i];
+                }
+            }
+        };
+        sstr << "cycles: " << m_numberOfCycles << ", overruns: " << m_numberOfOverruns << ", skipped cycles: " << m_numberOfSkippedCycles
+             << ", jitter mean/max: " << meanJitter().count() / 1000 << "/" << m_maxJitter.count() / 1000 << "us"
+             << ", overrun max: " << m_maxOverrun.count() / 1000 << "us" << '\n';
+        sstr << "jitter:";
+        histogram(m_jitterHistogram);
+        sstr << '\n' << "overrun:";
+        histogram(m_overrunHistogram);
+        sstr << '\n';
+    } catch (...) {} // LCOV_EXCL_LINE
+    return sstr.str();
+}
+
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -13931,11 +16889,27 @@ inline void ToMsgPackVisitor::visit(uint32_t id, std::string &&typeName, std::st
 //#include "cluon/OD4Session.hpp"
 //#include "cluon/Envelope.hpp"
 //#include "cluon/FromProtoVisitor.hpp"
+//#include "cluon/SharedMemoryRing.hpp"
 //#include "cluon/TerminateHandler.hpp"
 //#include "cluon/Time.hpp"
+//#include "cluon/TimeTrigger.hpp"
+//#include "cluon/UDPPacketSizeConstraints.hpp"
+
+// clang-format off
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+// clang-format on
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <string>
 #include <thread>
 
 namespace cluon {
@@ -13946,44 +16920,165 @@ inline OD4Session::OD4Session(uint16_t CID, std::function<void(cluon::data::Enve
     , m_delegate(std::move(delegate))
     , m_mapOfDataTriggeredDelegatesMutex{}
     , m_mapOfDataTriggeredDelegates{} {
+    // Optional features are enabled per CID by listing the CIDs in an environment variable, e.g., 111,112.
+    auto isEnabledFor = [CID](const char *listOfCIDs) {
+        bool enabled{false};
+        if (nullptr != listOfCIDs) {
+            try {
+                std::stringstream sstr{listOfCIDs};
+                std::string cid;
+                while (!enabled && std::getline(sstr, cid, ',')) {
+                    enabled = (std::to_string(CID) == cid);
+                }
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+        return enabled;
+    };
+    m_batching = isEnabledFor(getenv("CLUON_OD4SESSION_BATCHING"));
+
+    if (isEnabledFor(getenv("CLUON_OD4SESSION_SHAREDMEMORY"))) {
+        m_sharedMemoryRing = std::make_unique<cluon::SharedMemoryRing>("cluon-od4-" + std::to_string(CID),
+                                                                       cluon::SharedMemoryRing::capacityFor(cluon::OD4_MAX_FRAME_SIZE));
+        // Let the other OD4Sessions using shared memory ignore our UDP packets.
+        if (m_sharedMemoryRing->valid() && m_sharedMemoryRing->addParticipant(m_sender.getSendFromPort())) {
+            m_sharedMemoryReaderRunning.store(true);
+            m_sharedMemoryReader = std::thread([this, CID]() {
+                while (m_sharedMemoryReaderRunning.load()) {
+                    m_sharedMemoryRing->read(
+                        [this](std::string &&entry) {
+                            // Only unpack the envelope when it needs to be post-processed.
+                            if (this->hasDelegates()) {
+                                this->dispatch(entry.data(), entry.size(), cluon::time::now());
+                            }
+                        },
+                        std::chrono::milliseconds(100));
+                    if (0 < m_sharedMemoryRing->numberOfOverruns()) {
+                        std::cerr << "[cluon::OD4Session]: Envelopes for CID " << CID
+                                  << " were overwritten in shared memory before they could be read; receiving via UDP multicast from now on." << std::endl;
+                        m_sharedMemoryReaderRunning.store(false);
+                    }
+                }
+            });
+        } else {
+            std::cerr << "[cluon::OD4Session]: Failed to set up shared memory for CID " << CID << "; using UDP multicast." << std::endl;
+            m_sharedMemoryRing.reset();
+        }
+    }
+
+    // Receive via UDP multicast after the shared memory ring buffer was set up to decide which UDP packets to ignore.
     m_receiver = std::make_unique<cluon::UDPReceiver>(
         "225.0.0." + std::to_string(CID),
         12175,
-        [this](std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) {
-            this->callback(std::move(data), std::move(from), std::move(timepoint));
-        },
+        [this](cluon::ReceiveBuffer &&buffer) { this->callback(std::move(buffer)); },
         m_sender.getSendFromPort() /* passing our local send from port to the UDPReceiver to filter out our own bytes */);
 }
 
-inline void OD4Session::timeTrigger(float freq, std::function<bool()> delegate) noexcept {
+inline OD4Session::~OD4Session() noexcept {
+    // Stop all threads calling dispatch before the members it uses are destroyed.
+    m_receiver.reset();
+    if (m_sharedMemoryReader.joinable()) {
+        m_sharedMemoryReaderRunning.store(false);
+        m_sharedMemoryRing->notifyAll();
+        try {
+            m_sharedMemoryReader.join();
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+    m_sharedMemoryRing.reset();
+}
+
+inline void OD4Session::timeTrigger(float freq, std::function<bool()> delegate, const cluon::TimeTriggerOptions &options) noexcept {
     if (nullptr != delegate) {
+#ifdef __linux__
+        // Run the delegate with real-time priority and/or pinned to a CPU core; the original settings are restored afterwards.
+        int previousPolicy{SCHED_OTHER};
+        struct sched_param previousSchedulingParameters {};
+        const bool CHANGE_SCHEDULING{(0 < options.realtimePriority)
+                                     && (0 == ::pthread_getschedparam(::pthread_self(), &previousPolicy, &previousSchedulingParameters))};
+        if (CHANGE_SCHEDULING) {
+            struct sched_param schedulingParameters {};
+            schedulingParameters.sched_priority = std::min(options.realtimePriority, ::sched_get_priority_max(SCHED_FIFO));
+            const int retVal{::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &schedulingParameters)};
+            if (0 != retVal) {
+                std::cerr << "[cluon::OD4Session]: Failed to set SCHED_FIFO priority " << options.realtimePriority << ": " << ::strerror(retVal) << " (" << retVal
+                          << ")" << std::endl;
+            }
+        }
+        cpu_set_t previousCPUs;
+        CPU_ZERO(&previousCPUs);
+        const bool CHANGE_AFFINITY{(-1 < options.cpuAffinity) && (CPU_SETSIZE > options.cpuAffinity)
+                                   && (0 == ::pthread_getaffinity_np(::pthread_self(), sizeof(cpu_set_t), &previousCPUs))};
+        if (CHANGE_AFFINITY) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(static_cast<std::size_t>(options.cpuAffinity), &cpus);
+            const int retVal{::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), &cpus)};
+            if (0 != retVal) {
+                std::cerr << "[cluon::OD4Session]: Failed to pin time-triggered delegate to CPU " << options.cpuAffinity << ": " << ::strerror(retVal) << " ("
+                          << retVal << ")" << std::endl;
+            }
+        }
+#endif
+        try {
+            std::lock_guard<std::mutex> lck{m_timeTriggerStatisticsMutex};
+            m_timeTriggerStatistics.clear();
+        } catch (...) {} // LCOV_EXCL_LINE
+
+        // All deadlines are computed from the start to avoid accumulating rounding errors.
+        const std::chrono::nanoseconds PERIOD{static_cast<int64_t>(1000.0 * 1000.0 * 1000.0 / static_cast<double>((freq > 0) ? freq : 1.0f))};
+        const std::chrono::nanoseconds START{cluon::time::monotonicNow()};
+        int64_t cycle{0};
         bool delegateIsRunning{true};
-        const int64_t TIME_SLICE_IN_MILLISECONDS{static_cast<uint32_t>(1000 / ((freq > 0) ? freq : 1.0f))};
         do {
-            cluon::data::TimeStamp before{cluon::time::now()};
+            const std::chrono::nanoseconds BEFORE{cluon::time::monotonicNow()};
+            const std::chrono::nanoseconds DEADLINE{START + cycle * PERIOD};
             try {
                 delegateIsRunning = delegate();
             } catch (...) {
                 delegateIsRunning = false; // delegate threw exception.
             }
-            cluon::data::TimeStamp after{cluon::time::now()};
-
-            const int64_t beforeInMicroseconds{cluon::time::toMicroseconds(before)};
-            const int64_t afterInMicroseconds{cluon::time::toMicroseconds(after)};
-
-            const int64_t timeSpent{(afterInMicroseconds > beforeInMicroseconds) ? (afterInMicroseconds - beforeInMicroseconds) / 1000 : 0};
-            const int64_t timeToSleepInMilliseconds{TIME_SLICE_IN_MILLISECONDS - timeSpent};
-
-            // Sleep the remaining time.
-            if ((timeToSleepInMilliseconds > 0) && (timeToSleepInMilliseconds <= TIME_SLICE_IN_MILLISECONDS)) {
-                std::this_thread::sleep_for(std::chrono::duration<int64_t, std::milli>(timeToSleepInMilliseconds));
-            } else {
+            const std::chrono::nanoseconds AFTER{cluon::time::monotonicNow()};
+
+            // Skip the cycles whose deadlines have already passed and start the latest one immediately.
+            cycle++;
+            std::chrono::nanoseconds overrun{AFTER - (START + cycle * PERIOD)};
+            int64_t skippedCycles{0};
+            if (overrun > std::chrono::nanoseconds(0)) {
+                skippedCycles = overrun / PERIOD;
+                cycle += skippedCycles;
                 std::cerr << "[cluon::OD4Session]: time-triggered delegate violated allocated time slice." << std::endl;
+            } else {
+                overrun = std::chrono::nanoseconds(0);
+            }
+            try {
+                std::lock_guard<std::mutex> lck{m_timeTriggerStatisticsMutex};
+                m_timeTriggerStatistics.add(BEFORE - DEADLINE, overrun, static_cast<uint64_t>(skippedCycles));
+            } catch (...) {} // LCOV_EXCL_LINE
+
+            if (delegateIsRunning && !TerminateHandler::instance().isTerminated.load()) {
+                cluon::time::sleepUntil(START + cycle * PERIOD, options.busyWait);
             }
         } while (delegateIsRunning && !TerminateHandler::instance().isTerminated.load());
+
+#ifdef __linux__
+        if (CHANGE_AFFINITY) {
+            ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), &previousCPUs);
+        }
+        if (CHANGE_SCHEDULING) {
+            ::pthread_setschedparam(::pthread_self(), previousPolicy, &previousSchedulingParameters);
+        }
+#endif
     }
 }
 
+inline cluon::TimeTriggerStatistics OD4Session::timeTriggerStatistics() noexcept {
+    cluon::TimeTriggerStatistics retVal;
+    try {
+        std::lock_guard<std::mutex> lck{m_timeTriggerStatisticsMutex};
+        retVal = m_timeTriggerStatistics;
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
 inline bool OD4Session::dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate) noexcept {
     bool retVal{false};
     if (nullptr == m_delegate) {
@@ -14003,7 +17098,7 @@ inline bool OD4Session::dataTrigger(int32_t messageIdentifier, std::function<voi
     return retVal;
 }
 
-inline void OD4Session::callback(std::string &&data, std::string && /*from*/, std::chrono::system_clock::time_point &&timepoint) noexcept {
+inline bool OD4Session::hasDelegates() noexcept {
     size_t numberOfDataTriggeredDelegates{0};
     {
         try {
@@ -14011,14 +17106,50 @@ inline void OD4Session::callback(std::string &&data, std::string && /*from*/, st
             numberOfDataTriggeredDelegates = m_mapOfDataTriggeredDelegates.size();
         } catch (...) {} // LCOV_EXCL_LINE
     }
+    return (nullptr != m_delegate) || (0 < numberOfDataTriggeredDelegates);
+}
+
+inline void OD4Session::callback(cluon::ReceiveBuffer &&buffer) noexcept {
+    // Envelopes from OD4Sessions on this host using shared memory are received from there.
+    if (m_sharedMemoryReaderRunning.load() && buffer.fromLocalHost()
+        && m_sharedMemoryRing->hasParticipant(ntohs(buffer.fromAddress().sin_port))) {
+        return;
+    }
+
     // Only unpack the envelope when it needs to be post-processed.
-    if ((nullptr != m_delegate) || (0 < numberOfDataTriggeredDelegates)) {
-        std::stringstream sstr(data);
-        auto retVal = extractEnvelope(sstr);
+    if (hasDelegates()) {
+        if (cluon::isOD4Fragment(buffer.data(), buffer.size())) {
+            // Fragments are distinguished by sender address and port.
+            const struct sockaddr_in FROM{buffer.fromAddress()};
+            const uint64_t SENDER{(static_cast<uint64_t>(FROM.sin_addr.s_addr) << 16) | static_cast<uint64_t>(FROM.sin_port)};
+            auto retVal = m_fragmentAssembler.add(SENDER, buffer.data(), buffer.size(), buffer.sampleTime());
+            if (retVal.first) {
+                dispatch(retVal.second.data(), retVal.second.size(), cluon::time::convert(buffer.sampleTime()));
+            }
+        } else {
+            // Decode directly from the receive buffer.
+            dispatch(buffer.data(), buffer.size(), cluon::time::convert(buffer.sampleTime()));
+        }
+    }
+}
+
+inline void OD4Session::dispatch(const char *data, std::size_t size, const cluon::data::TimeStamp &received) noexcept {
+    try {
+        // Delegates are called from the UDP receiver and the shared memory reader.
+        std::lock_guard<std::mutex> dispatchLock{m_dispatchMutex};
+
+        // A UDP packet or shared memory entry might carry several consecutive Envelopes when sent as a batch.
+        std::size_t consumed{0};
+        while (0 < size) {
+            auto retVal = extractEnvelope(data, size, consumed);
+            if (!retVal.first) {
+                break;
+            }
+            data += consumed;
+            size -= consumed;
 
-        if (retVal.first) {
-            cluon::data::Envelope env{retVal.second};
-            env.received(cluon::time::convert(timepoint));
+            cluon::data::Envelope env{std::move(retVal.second)};
+            env.received(received);
 
             // "Catch all"-delegate.
             if (nullptr != m_delegate) {
@@ -14033,21 +17164,89 @@ inline void OD4Session::callback(std::string &&data, std::string && /*from*/, st
                 } catch (...) {} // LCOV_EXCL_LINE
             }
         }
-    }
+    } catch (...) {} // LCOV_EXCL_LINE
 }
 
 inline void OD4Session::send(cluon::data::Envelope &&envelope) noexcept {
     sendInternal(cluon::serializeEnvelope(std::move(envelope)));
 }
 
+inline void OD4Session::send(std::vector<cluon::data::Envelope> &envelopes) noexcept {
+    try {
+        send(std::vector<cluon::data::Envelope>(envelopes));
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline void OD4Session::send(std::vector<cluon::data::Envelope> &&envelopes) noexcept {
+    constexpr std::size_t MAX_BATCH_SIZE = static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_ETHERNET_MTU)
+                                           - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                           - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    try {
+        std::vector<std::string> frames;
+        frames.reserve(envelopes.size());
+        for (auto &envelope : envelopes) {
+            frames.emplace_back(cluon::serializeEnvelope(std::move(envelope)));
+        }
+
+        if (nullptr != m_sharedMemoryRing) {
+            std::string entry;
+            for (const auto &frame : frames) {
+                entry.append(frame);
+            }
+            if (!m_sharedMemoryRing->write(entry.data(), entry.size())) {
+                // Every single OD4 frame fits into the ring buffer.
+                for (const auto &frame : frames) {
+                    m_sharedMemoryRing->write(frame.data(), frame.size());
+                }
+            }
+        }
+
+        std::vector<std::string> packets;
+        std::string packet;
+        for (const auto &frame : frames) {
+            if (!packet.empty() && (!m_batching || (MAX_BATCH_SIZE < packet.size() + frame.size()))) {
+                packets.emplace_back(std::move(packet));
+                packet.clear();
+            }
+            if (MAX_LENGTH < frame.size()) {
+                auto fragments{cluon::fragmentOD4Frame(frame, m_fragmentSequenceNumber++, cluon::OD4_MAX_FRAGMENT_SIZE)};
+                std::move(fragments.begin(), fragments.end(), std::back_inserter(packets));
+                continue;
+            }
+            packet.append(frame);
+        }
+        if (!packet.empty()) {
+            packets.emplace_back(std::move(packet));
+        }
+        m_sender.send(std::move(packets));
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
 inline void OD4Session::sendInternal(std::string &&dataToSend) noexcept {
-    m_sender.send(std::move(dataToSend));
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    if (nullptr != m_sharedMemoryRing) {
+        m_sharedMemoryRing->write(dataToSend.data(), dataToSend.size());
+    }
+    if (MAX_LENGTH < dataToSend.size()) {
+        m_sender.send(cluon::fragmentOD4Frame(dataToSend, m_fragmentSequenceNumber++, cluon::OD4_MAX_FRAGMENT_SIZE));
+    } else {
+        m_sender.send(std::move(dataToSend));
+    }
 }
 
 inline bool OD4Session::isRunning() noexcept {
     return m_receiver->isRunning();
 }
 
+inline bool OD4Session::isUsingSharedMemory() const noexcept {
+    return (nullptr != m_sharedMemoryRing);
+}
+
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -14216,12 +17415,14 @@ inline int32_t EnvelopeConverter::setMessageSpecification(const std::string &ms)
 
     m_listOfMetaMessages.clear();
     m_scopeOfMetaMessages.clear();
+    m_genericMessages.clear();
 
     cluon::MessageParser mp;
     auto parsingResult = mp.parse(ms);
     if (cluon::MessageParser::MessageParserErrorCodes::NO_MESSAGEPARSER_ERROR == parsingResult.second) {
         m_listOfMetaMessages = parsingResult.first;
         for (const auto &mm : m_listOfMetaMessages) { m_scopeOfMetaMessages[mm.messageIdentifier()] = mm; }
+        for (const auto &mm : m_listOfMetaMessages) { m_genericMessages[mm.messageIdentifier()].createFrom(mm, m_listOfMetaMessages); }
         retVal = static_cast<int32_t>(m_listOfMetaMessages.size());
     }
     return retVal;
@@ -14231,28 +17432,22 @@ inline std::string EnvelopeConverter::getJSONFromProtoEncodedEnvelope(const std:
     std::string retVal{"{}"};
     if (!m_listOfMetaMessages.empty()) {
         cluon::data::Envelope envelope;
-        std::stringstream sstr(protoEncodedEnvelope);
+        bool hasOD4Header{false};
         constexpr uint8_t OD4_HEADER_SIZE{5};
         if (OD4_HEADER_SIZE < protoEncodedEnvelope.size()) {
             // Try decoding complete OD4-encoded Envelope including header.
-            constexpr uint8_t byte0{0x0D};
-            constexpr uint8_t byte1{0xA4};
-            if ((static_cast<uint8_t>(protoEncodedEnvelope.at(0)) == byte0) && (static_cast<uint8_t>(protoEncodedEnvelope.at(1)) == byte1)) {
-                uint32_t length = (*reinterpret_cast<const uint32_t *>(protoEncodedEnvelope.data() + 1));
-                length          = le32toh(length) >> 8;
-                if ((OD4_HEADER_SIZE + length) == protoEncodedEnvelope.size()) {
-                    auto result{extractEnvelope(sstr)};
-                    if (result.first) {
-                        envelope = result.second;
-                    }
-                }
+            std::size_t consumed{0};
+            auto result{extractEnvelope(protoEncodedEnvelope.data(), protoEncodedEnvelope.size(), consumed)};
+            hasOD4Header = (result.first && (consumed == protoEncodedEnvelope.size()));
+            if (hasOD4Header) {
+                envelope = std::move(result.second);
             }
         }
 
-        if (0 == envelope.dataType()) {
+        if (!hasOD4Header && (0 == envelope.dataType())) {
             // Directly decoding complete OD4 container failed, try decoding without header.
             cluon::FromProtoVisitor protoDecoder;
-            protoDecoder.decodeFrom(sstr, envelope);
+            protoDecoder.decodeFrom(protoEncodedEnvelope.data(), protoEncodedEnvelope.size(), envelope);
         }
 
         retVal = getJSONFromEnvelope(envelope);
@@ -14261,43 +17456,98 @@ inline std::string EnvelopeConverter::getJSONFromProtoEncodedEnvelope(const std:
 }
 
 inline std::string EnvelopeConverter::getJSONFromEnvelope(cluon::data::Envelope &envelope) noexcept {
-    std::string retVal{"{}"};
-    if (!m_listOfMetaMessages.empty()) {
-        if (0 < m_scopeOfMetaMessages.count(envelope.dataType())) {
-            // First, create JSON from Envelope.
-            constexpr bool OUTER_CURLY_BRACES{false};
+    std::string retVal;
+    if (!appendJSONFromEnvelope(retVal, envelope)) {
+        retVal = "{}";
+    }
+    return retVal;
+}
+
+inline bool EnvelopeConverter::appendJSONFromEnvelope(std::string &buffer, cluon::data::Envelope &envelope) noexcept {
+    bool retVal{false};
+    auto payload = m_scopeOfMetaMessages.find(envelope.dataType());
+    auto prototype = m_genericMessages.find(envelope.dataType());
+    if ((m_scopeOfMetaMessages.end() != payload) && (m_genericMessages.end() != prototype)) {
+        // First, stream JSON from Envelope into the buffer.
+        constexpr bool OUTER_CURLY_BRACES{false};
+        buffer += '{';
+        {
             // Ignore field 2 (= serializedData) as it will be replaced below.
             const std::map<uint32_t, bool> mask{{2, false}};
-            ToJSONVisitor envelopeToJSON{OUTER_CURLY_BRACES, mask};
+            ToJSONVisitor envelopeToJSON{buffer, OUTER_CURLY_BRACES, mask};
             envelope.accept(envelopeToJSON);
+        }
 
-            std::stringstream sstr{envelope.serializedData()};
-            cluon::FromProtoVisitor protoDecoder;
-            protoDecoder.decodeFrom(sstr);
-
-            // Now, create JSON from payload.
-            cluon::MetaMessage payload{m_scopeOfMetaMessages[envelope.dataType()]};
-            cluon::GenericMessage gm;
-
-            // Create "empty" GenericMessage from this MetaMessage.
-            gm.createFrom(payload, m_listOfMetaMessages);
+        buffer += ",\n\"";
+        const std::size_t BEGIN_OF_NAME{buffer.size()};
+        buffer += payload->second.messageName();
+        std::replace(buffer.begin() + static_cast<std::string::difference_type>(BEGIN_OF_NAME), buffer.end(), '.', '_');
+        buffer += "\":{";
 
-            // Set values in the newly created GenericMessage from ProtoDecoder.
-            gm.accept(protoDecoder);
+        // Now, copy "empty" GenericMessage for this MetaMessage and set its values from the payload.
+        cluon::GenericMessage gm{prototype->second};
+        cluon::FromProtoVisitor protoDecoder;
+        protoDecoder.decodeFrom(envelope.serializedData().data(), envelope.serializedData().size(), gm);
 
-            ToJSONVisitor payloadToJSON{OUTER_CURLY_BRACES};
+        {
+            ToJSONVisitor payloadToJSON{buffer, OUTER_CURLY_BRACES};
             try {
                 // Catch possible linb::any exception.
                 gm.accept(payloadToJSON);
             } catch (const linb::bad_any_cast &) {} // LCOV_EXCL_LINE
+        }
+        buffer += "}}";
+        retVal = true;
+    }
+    return retVal;
+}
 
-            std::string tmp{payload.messageName()};
-            std::replace(tmp.begin(), tmp.end(), '.', '_');
-
-            const std::string strPayloadJSON{payloadToJSON.json() != "{}" ? payloadToJSON.json() : ""};
+inline uint64_t EnvelopeConverter::getJSONFromRecFile(std::istream &recFile, std::ostream &out) noexcept {
+    return getJSONFromEnvelopes(
+        [&recFile]() {
+            std::pair<bool, cluon::data::Envelope> retVal{false, cluon::data::Envelope()};
+            if (recFile.good()) {
+                retVal = extractEnvelope(recFile);
+            }
+            return retVal;
+        },
+        out);
+}
 
-            retVal = '{' + envelopeToJSON.json() + ',' + '\n' + '"' + tmp + '"' + ':' + '{' + strPayloadJSON + '}' + '}';
+inline uint64_t EnvelopeConverter::getJSONFromEnvelopes(const std::function<std::pair<bool, cluon::data::Envelope>()> &nextEnvelope,
+                                                        std::ostream &out) noexcept {
+    uint64_t retVal{0};
+    try {
+        // Collect the JSON representations in one buffer that is handed over
+        // to the output stream whenever it exceeds the threshold.
+        constexpr std::size_t FLUSH_THRESHOLD{1024 * 1024};
+        std::string buffer;
+        buffer.reserve(2 * FLUSH_THRESHOLD);
+        buffer += '[';
+        while (true) {
+            auto envelope = nextEnvelope();
+            if (!envelope.first) {
+                break;
+            }
+            const std::size_t BEFORE{buffer.size()};
+            if (0 < retVal) {
+                buffer += ',';
+            }
+            buffer += '\n';
+            if (appendJSONFromEnvelope(buffer, envelope.second)) {
+                retVal++;
+            } else {
+                buffer.resize(BEFORE);
+            }
+            if (FLUSH_THRESHOLD < buffer.size()) {
+                out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
         }
+        buffer += "\n]\n";
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+    } catch (...) { // LCOV_EXCL_LINE
     }
     return retVal;
 }
@@ -14319,12 +17569,8 @@ inline std::string EnvelopeConverter::getProtoEncodedEnvelopeFromJSON(const std:
     // clang-format on
     std::string retVal;
     if (0 < m_scopeOfMetaMessages.count(messageIdentifier)) {
-        // Get specification for message to be created.
-        cluon::MetaMessage message{m_scopeOfMetaMessages[messageIdentifier]};
-
-        // Create "empty" instance for the required message as GenericMessage.
-        cluon::GenericMessage gm;
-        gm.createFrom(message, m_listOfMetaMessages);
+        // Copy "empty" instance for the required message as GenericMessage.
+        cluon::GenericMessage gm{m_genericMessages[messageIdentifier]};
 
         // Parse data from given JSON.
         std::stringstream sstr{json};
@@ -14335,17 +17581,172 @@ inline std::string EnvelopeConverter::getProtoEncodedEnvelopeFromJSON(const std:
         gm.accept(jsonDecoder);
 
         // Finally, transform GenericMessage into Envelope.
-        ToProtoVisitor protoEncoder;
-        gm.accept(protoEncoder);
+        std::string serializedData;
+        ToProtoVisitor protoEncoder{serializedData};
+        protoEncoder.encodeFrom(gm);
 
         cluon::data::Envelope env;
-        env.dataType(messageIdentifier).serializedData(protoEncoder.encodedData()).senderStamp(senderStamp).sampleTimeStamp(sampleTimeStamp);
+        env.dataType(messageIdentifier).serializedData(std::move(serializedData)).senderStamp(senderStamp).sampleTimeStamp(sampleTimeStamp);
 
         retVal = cluon::serializeEnvelope(std::move(env));
     }
     return retVal;
 }
 
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/Compression.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace cluon {
+namespace compression {
+
+// Matches are at least COMPRESSION_MIN_MATCH bytes long and refer to at most
+// COMPRESSION_MAX_OFFSET bytes back; the last COMPRESSION_LAST_LITERALS bytes
+// are always stored as literals so that the compressor never reads beyond
+// the input when comparing four bytes at once.
+static constexpr std::size_t COMPRESSION_MIN_MATCH{4};
+static constexpr std::size_t COMPRESSION_MAX_OFFSET{65535};
+static constexpr std::size_t COMPRESSION_LAST_LITERALS{5};
+static constexpr uint32_t COMPRESSION_HASH_BITS{16};
+
+inline void compress(const char *data, std::size_t size, std::string &compressed) noexcept {
+    try {
+        const uint8_t *in{reinterpret_cast<const uint8_t *>(data)};
+        compressed.reserve(compressed.size() + size + size / 255 + 16);
+
+        auto read32 = [in](std::size_t position) {
+            uint32_t v{0};
+            std::memcpy(&v, in + position, sizeof(uint32_t));
+            return v;
+        };
+        auto hash = [](uint32_t v) { return (v * 2654435761U) >> (32 - COMPRESSION_HASH_BITS); };
+        auto appendLength = [&compressed](std::size_t length) {
+            for (; 255 <= length; length -= 255) {
+                compressed.push_back(static_cast<char>(255));
+            }
+            compressed.push_back(static_cast<char>(length));
+        };
+        // A sequence without a match (matchLength is 0) is the last one in a block.
+        auto appendSequence = [in, &compressed, &appendLength](std::size_t literals, std::size_t numberOfLiterals, std::size_t offset, std::size_t matchLength) {
+            const std::size_t MATCH_LENGTH{(0 < matchLength) ? matchLength - COMPRESSION_MIN_MATCH : 0};
+            compressed.push_back(static_cast<char>(((std::min)(numberOfLiterals, std::size_t{15}) << 4) | (std::min)(MATCH_LENGTH, std::size_t{15})));
+            if (15 <= numberOfLiterals) {
+                appendLength(numberOfLiterals - 15);
+            }
+            compressed.append(reinterpret_cast<const char *>(in + literals), numberOfLiterals);
+            if (0 < matchLength) {
+                compressed.push_back(static_cast<char>(offset & 0xFF));
+                compressed.push_back(static_cast<char>((offset >> 8) & 0xFF));
+                if (15 <= MATCH_LENGTH) {
+                    appendLength(MATCH_LENGTH - 15);
+                }
+            }
+        };
+
+        std::size_t anchor{0};
+        if (size > COMPRESSION_MIN_MATCH + COMPRESSION_LAST_LITERALS) {
+            // Positions of the last occurrences of four-byte sequences.
+            std::vector<uint32_t> table(std::size_t{1} << COMPRESSION_HASH_BITS, 0);
+            const std::size_t LIMIT{size - COMPRESSION_LAST_LITERALS};
+            std::size_t position{0};
+            while (position + COMPRESSION_MIN_MATCH <= LIMIT) {
+                const uint32_t SEQUENCE{read32(position)};
+                const uint32_t HASH{hash(SEQUENCE)};
+                const std::size_t CANDIDATE{table[HASH]};
+                table[HASH] = static_cast<uint32_t>(position);
+                if ((CANDIDATE < position) && (position - CANDIDATE <= COMPRESSION_MAX_OFFSET) && (read32(CANDIDATE) == SEQUENCE)) {
+                    std::size_t matchLength{COMPRESSION_MIN_MATCH};
+                    while ((position + matchLength < LIMIT) && (in[CANDIDATE + matchLength] == in[position + matchLength])) {
+                        matchLength++;
+                    }
+                    appendSequence(anchor, position - anchor, position - CANDIDATE, matchLength);
+                    position += matchLength;
+                    anchor = position;
+                } else {
+                    // Skip faster through data that does not compress, like images.
+                    position += 1 + ((position - anchor) >> 6);
+                }
+            }
+        }
+        appendSequence(anchor, size - anchor, 0, 0);
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline bool decompress(const char *data, std::size_t size, std::size_t decompressedSize, std::string &decompressed) noexcept {
+    bool retVal{false};
+    try {
+        decompressed.resize(decompressedSize);
+        const uint8_t *in{reinterpret_cast<const uint8_t *>(data)};
+        const uint8_t *END{in + size};
+        char *out{&decompressed[0]};
+        std::size_t position{0};
+
+        auto readLength = [&in, END](std::size_t &length) {
+            uint8_t b{255};
+            while ((255 == b) && (in < END)) {
+                b = *in++;
+                length += b;
+            }
+            return (255 != b);
+        };
+
+        retVal = (0 < size);
+        while (retVal && (in < END)) {
+            const uint8_t TOKEN{*in++};
+            std::size_t numberOfLiterals{static_cast<std::size_t>(TOKEN >> 4)};
+            retVal = ((15 != numberOfLiterals) || readLength(numberOfLiterals))
+                     && (numberOfLiterals <= static_cast<std::size_t>(END - in)) && (numberOfLiterals <= decompressedSize - position);
+            if (retVal) {
+                std::memcpy(out + position, in, numberOfLiterals);
+                in += numberOfLiterals;
+                position += numberOfLiterals;
+
+                // The last sequence has no match.
+                if (in < END) {
+                    retVal = (2 <= END - in);
+                    if (retVal) {
+                        const std::size_t OFFSET{static_cast<std::size_t>(in[0]) | (static_cast<std::size_t>(in[1]) << 8)};
+                        in += 2;
+                        std::size_t matchLength{static_cast<std::size_t>(TOKEN & 0x0F)};
+                        retVal = ((15 != matchLength) || readLength(matchLength));
+                        matchLength += COMPRESSION_MIN_MATCH;
+                        retVal = retVal && (0 < OFFSET) && (OFFSET <= position) && (matchLength <= decompressedSize - position);
+                        if (retVal) {
+                            if (OFFSET >= matchLength) {
+                                std::memcpy(out + position, out + position - OFFSET, matchLength);
+                            } else {
+                                // Overlapping matches repeat the last OFFSET bytes.
+                                for (std::size_t i{0}; i < matchLength; i++) {
+                                    out[position + i] = out[position - OFFSET + i];
+                                }
+                            }
+                            position += matchLength;
+                        }
+                    }
+                }
+            }
+        }
+        retVal = retVal && (decompressedSize == position);
+    } catch (...) { // LCOV_EXCL_LINE
+        retVal = false; // LCOV_EXCL_LINE
+    }
+    return retVal;
+}
+
+} // namespace compression
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -14356,41 +17757,160 @@ inline std::string EnvelopeConverter::getProtoEncodedEnvelopeFromJSON(const std:
  */
 
 //#include "cluon/Player.hpp"
+//#include "cluon/Compression.hpp"
 //#include "cluon/Envelope.hpp"
+//#include "cluon/PortableEndian.hpp"
 //#include "cluon/Time.hpp"
 
+// clang-format off
+#ifndef WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 
+// Layout of the index sidecar file (all numbers little endian):
+//   magic version:uint32 sizeOfEntry:uint32
+//   recFileSize:uint64 recFileModificationTime:int64 recFileContentHash:uint64 numberOfEntries:uint64
+//   per entry: sampleTimeStamp:int64 filePosition:uint64 dataType:int32 senderStamp:uint32 size:uint32 reserved:uint32
+// with the entries stored in chronological order; recFileModificationTime is in nanoseconds
+// and recFileContentHash is the FNV-1a hash over the first and last bytes of the rec file.
+static constexpr char PLAYER_INDEX_FILE_MAGIC[8]{'\x89', 'R', 'E', 'C', 'I', 'D', 'X', '\n'};
+static constexpr uint32_t PLAYER_INDEX_FILE_VERSION{2};
+static constexpr std::size_t PLAYER_INDEX_FILE_HEADER_SIZE{sizeof(PLAYER_INDEX_FILE_MAGIC) + 2 * sizeof(uint32_t) + 4 * sizeof(uint64_t)};
+static constexpr std::size_t PLAYER_INDEX_FILE_HASHED_BYTES{4 * 1024};
+static constexpr std::size_t PLAYER_INDEX_FILE_ENTRY_SIZE{2 * sizeof(uint64_t) + 4 * sizeof(uint32_t)};
+
+// Layout of a chunked rec file (all numbers little endian):
+//   magic version:uint32 reserved:uint32
+//   per chunk: compressedSize:uint32 uncompressedSize:uint32 and the consecutive OD4-framed
+//              Envelopes compressed with cluon::compression; a chunk is stored as it is if
+//              compressing does not save any bytes (compressedSize == uncompressedSize)
+//   per chunk: filePosition:uint64 compressedSize:uint32 uncompressedSize:uint32
+//              minSampleTimeStamp:int64 maxSampleTimeStamp:int64 numberOfEnvelopes:uint32 reserved:uint32
+//   numberOfChunks:uint64 positionOfChunkTable:uint64 magic
+// where filePosition refers to the compressed bytes of a chunk. If the table of chunks
+// is missing, e.g., because the recording was interrupted, the chunks are found from
+// their sizes.
+static constexpr char CHUNKED_REC_FILE_MAGIC[8]{'\x89', 'R', 'E', 'C', 'C', 'H', 'K', '\n'};
+static constexpr uint32_t CHUNKED_REC_FILE_VERSION{1};
+static constexpr std::size_t CHUNKED_REC_FILE_HEADER_SIZE{sizeof(CHUNKED_REC_FILE_MAGIC) + 2 * sizeof(uint32_t)};
+static constexpr std::size_t CHUNKED_REC_FILE_CHUNK_HEADER_SIZE{2 * sizeof(uint32_t)};
+static constexpr std::size_t CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE{3 * sizeof(uint64_t) + 4 * sizeof(uint32_t)};
+static constexpr std::size_t CHUNKED_REC_FILE_TRAILER_SIZE{2 * sizeof(uint64_t) + sizeof(CHUNKED_REC_FILE_MAGIC)};
+
+/**
+ * This function determines the fingerprint of a rec file to validate its index sidecar file.
+ *
+ * @param file Name of the rec file.
+ * @param fingerprint Fingerprint to be determined.
+ * @return true if the fingerprint could be determined.
+ */
+inline bool fingerprintRecFile(const std::string &file, RecFileFingerprint &fingerprint) noexcept {
+    bool retVal{false};
+#ifdef WIN32
+    (void)file;
+    (void)fingerprint;
+#else
+    const int fd{::open(file.c_str(), O_RDONLY)};
+    if (-1 < fd) {
+        struct stat fileStatus {};
+        if (0 == ::fstat(fd, &fileStatus)) {
+#ifdef __APPLE__
+            const struct timespec MODIFICATION_TIME{fileStatus.st_mtimespec};
+#else
+            const struct timespec MODIFICATION_TIME{fileStatus.st_mtim};
+#endif
+            fingerprint.m_size             = static_cast<uint64_t>(fileStatus.st_size);
+            fingerprint.m_modificationTime = static_cast<int64_t>(MODIFICATION_TIME.tv_sec) * static_cast<int64_t>(1000 * 1000 * 1000)
+                                             + static_cast<int64_t>(MODIFICATION_TIME.tv_nsec);
+
+            // FNV-1a over the first and the last bytes.
+            uint64_t hash{0xcbf29ce484222325ull};
+            char buffer[PLAYER_INDEX_FILE_HASHED_BYTES];
+            const uint64_t TAIL{(fingerprint.m_size > PLAYER_INDEX_FILE_HASHED_BYTES) ? fingerprint.m_size - PLAYER_INDEX_FILE_HASHED_BYTES : 0};
+            retVal = true;
+            for (uint64_t offset : {static_cast<uint64_t>(0), TAIL}) {
+                const ssize_t BYTES{::pread(fd, buffer, sizeof(buffer), static_cast<off_t>(offset))};
+                retVal = retVal && (0 <= BYTES);
+                for (ssize_t i{0}; i < BYTES; i++) {
+                    hash = (hash ^ static_cast<uint8_t>(buffer[i])) * 0x100000001b3ull;
+                }
+            }
+            fingerprint.m_contentHash = hash;
+        }
+        ::close(fd);
+    }
+#endif
+    return retVal;
+}
+
 inline IndexEntry::IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept
     : m_sampleTimeStamp(sampleTimeStamp)
     , m_filePosition(filePosition)
     , m_available(false) {}
 
+inline IndexEntry::IndexEntry(const int64_t &sampleTimeStamp,
+                              const uint64_t &filePosition,
+                              const int32_t &dataType,
+                              const uint32_t &senderStamp,
+                              const uint32_t &size) noexcept
+    : m_sampleTimeStamp(sampleTimeStamp)
+    , m_filePosition(filePosition)
+    , m_dataType(dataType)
+    , m_senderStamp(senderStamp)
+    , m_size(size)
+    , m_available(false) {}
+
 ////////////////////////////////////////////////////////////////////////
 
-inline Player::Player(const std::string &file, const bool &autoRewind, const bool &threading) noexcept
+inline Player::Player(const std::string &file,
+                      const bool &autoRewind,
+                      const bool &threading,
+                      const bool &memoryMapped,
+                      const std::map<int32_t, std::set<uint32_t>> &allowList) noexcept
     : m_threading(threading)
     , m_file(file)
+    , m_indexFile(file + ".idx")
+    , m_allowList(allowList)
     , m_recFile()
     , m_recFileValid(false)
+    , m_memoryMapped(memoryMapped)
     , m_autoRewind(autoRewind)
     , m_indexMutex()
-    , m_index()
-    , m_previousPreviousEnvelopeAlreadyReplayed(m_index.end())
-    , m_previousEnvelopeAlreadyReplayed(m_index.begin())
-    , m_currentEnvelopeToReplay(m_index.begin())
-    , m_nextEntryToReadFromRecFile(m_index.begin())
-    , m_desiredInitialLevel(0)
+    , m_indexSampleTimeStamps()
+    , m_indexFilePositions()
+    , m_indexDataTypes()
+    , m_indexSenderStamps()
+    , m_indexSizes()
+    , m_previousEnvelopeAlreadyReplayed(0)
+    , m_currentEnvelopeToReplay(0)
+    , m_nextEntryToReadFromRecFile(0)
     , m_firstTimePointReturningAEnvelope()
     , m_numberOfReturnedEnvelopesInTotal(0)
     , m_delay(0)
@@ -14398,6 +17918,11 @@ inline Player::Player(const std::string &file, const bool &autoRewind, const boo
     , m_envelopeCacheFillingThreadIsRunning(false)
     , m_envelopeCacheFillingThread()
     , m_envelopeCache()
+    , m_envelopeCacheHead(0)
+    , m_envelopeCacheEntries(0)
+    , m_envelopeCacheBytes(0)
+    , m_envelopeCacheNotEmpty()
+    , m_envelopeCacheNotFull()
     , m_playerListenerMutex()
     , m_playerListener(nullptr) {
     initializeIndex();
@@ -14417,6 +17942,11 @@ inline Player::~Player() {
         m_envelopeCacheFillingThread.join();
     }
 
+#ifndef WIN32
+    if (nullptr != m_mappedRecFile) {
+        ::munmap(const_cast<char *>(m_mappedRecFile), m_mappedRecFileSize);
+    }
+#endif
     m_recFile.close();
 }
 
@@ -14433,45 +17963,595 @@ inline void Player::initializeIndex() noexcept {
     m_recFile.open(m_file.c_str(), std::ios_base::in | std::ios_base::binary); /* Flawfinder: ignore */
     m_recFileValid = m_recFile.good();
 
-    if (m_recFileValid) {
-        // Determine file size to display progress.
-        m_recFile.seekg(0, m_recFile.end);
-        int64_t fileLength = m_recFile.tellg();
-        m_recFile.seekg(0, m_recFile.beg);
+    if (m_recFileValid) {
+        // Determine file size to display progress.
+        m_recFile.seekg(0, m_recFile.end);
+        int64_t fileLength = m_recFile.tellg();
+        m_recFile.seekg(0, m_recFile.beg);
+
+        // The sidecar index is only valid for the rec file it was created from.
+        RecFileFingerprint fingerprint{};
+        const bool HAS_FINGERPRINT{fingerprintRecFile(m_file, fingerprint)};
+
+        // Chunked rec files start with a magic number instead of an OD4-framed Envelope.
+        {
+            char magic[sizeof(CHUNKED_REC_FILE_MAGIC)]{};
+            m_recFile.read(magic, sizeof(magic)); // Flawfinder: ignore
+            m_chunked = m_recFile.good() && (0 == std::memcmp(magic, CHUNKED_REC_FILE_MAGIC, sizeof(CHUNKED_REC_FILE_MAGIC)));
+            m_recFile.clear();
+            m_recFile.seekg(0, m_recFile.beg);
+        }
+        if (m_chunked && !readChunkTable(static_cast<uint64_t>(fileLength))) {
+            std::clog << "[cluon::Player]: " << m_file << " contains an invalid chunk." << std::endl;
+        }
+
+        const cluon::data::TimeStamp BEFORE{cluon::time::now()};
+        if (HAS_FINGERPRINT && loadIndexFile(fingerprint)) {
+            const cluon::data::TimeStamp AFTER{cluon::time::now()};
+            std::clog << "[cluon::Player]: " << m_file << " contains " << m_indexSampleTimeStamps.size() << " entries; "
+                      << "loaded index from " << m_indexFile << " "
+                      << "in " << cluon::time::deltaInMicroseconds(AFTER, BEFORE) / static_cast<int64_t>(1000) << "ms." << std::endl;
+        } else {
+            // Read complete file in large blocks and store file positions to envelopes
+            // to create index of available data. Only the meta data of each Envelope
+            // is decoded while its payload is skipped; the actual reading of Envelopes
+            // is deferred.
+            uint64_t totalBytesRead = 0;
+            try {
+                std::vector<IndexEntry> entries;
+                if (m_chunked) {
+                    totalBytesRead = indexChunks(entries);
+                } else {
+                    constexpr std::size_t OD4_HEADER_SIZE{5};
+                    constexpr std::size_t BLOCK_SIZE{4 * 1024 * 1024};
+                    std::vector<char> buffer(BLOCK_SIZE);
+                    std::size_t available{0};
+                    std::size_t position{0};
+                    bool endOfFile{false};
+                    int32_t oldPercentage = -1;
+                    while (true) {
+                        const std::size_t REMAINING{available - position};
+                        std::size_t lengthOfNextEnvelope{OD4_HEADER_SIZE};
+                        if (OD4_HEADER_SIZE <= REMAINING) {
+                            const char *header{buffer.data() + position};
+                            if ((0x0D != static_cast<uint8_t>(header[0])) || (0xA4 != static_cast<uint8_t>(header[1]))) {
+                                break;
+                            }
+                            uint32_t length{0};
+                            std::memcpy(&length, header + 1, sizeof(uint32_t));
+                            lengthOfNextEnvelope += (le32toh(length) >> 8);
+                        }
+
+                        if (lengthOfNextEnvelope <= REMAINING) {
+                            std::size_t consumed{0};
+                            auto retVal = extractEnvelopeMetaData(buffer.data() + position, REMAINING, consumed);
+                            if (retVal.first) {
+                                // Store mapping .rec file position --> index entry.
+                                const int64_t microseconds = cluon::time::toMicroseconds(retVal.second.sampleTimeStamp());
+                                entries.emplace_back(
+                                    IndexEntry(microseconds, totalBytesRead, retVal.second.dataType(), retVal.second.senderStamp(), static_cast<uint32_t>(consumed)));
+                            }
+                            position += lengthOfNextEnvelope;
+                            totalBytesRead += lengthOfNextEnvelope;
+
+                            const int32_t percentage = static_cast<int32_t>((static_cast<float>(totalBytesRead) * 100.0f) / static_cast<float>(fileLength));
+                            if ((percentage % 5 == 0) && (percentage != oldPercentage)) {
+                                std::clog << "[cluon::Player]: Indexed " << percentage << "% from " << m_file << "." << std::endl;
+                                oldPercentage = percentage;
+                            }
+                        } else {
+                            if (endOfFile) {
+                                break;
+                            }
+                            // Keep the incomplete Envelope and read the next block behind it.
+                            std::memmove(buffer.data(), buffer.data() + position, REMAINING);
+                            available = REMAINING;
+                            position  = 0;
+                            if (buffer.size() < lengthOfNextEnvelope) {
+                                buffer.resize(lengthOfNextEnvelope);
+                            }
+                            m_recFile.read(buffer.data() + available, static_cast<std::streamsize>(buffer.size() - available)); // Flawfinder: ignore
+                            available += static_cast<std::size_t>(m_recFile.gcount());
+                            endOfFile = !m_recFile.good();
+                        }
+                    }
+                }
+
+                // Sort entries chronologically while keeping the order from the .rec file for equal sample time stamps.
+                std::stable_sort(entries.begin(), entries.end(), [](const IndexEntry &a, const IndexEntry &b) {
+                    return a.m_sampleTimeStamp < b.m_sampleTimeStamp;
+                });
+                clearIndex();
+                for (const auto &e : entries) {
+                    appendToIndex(e);
+                }
+            } catch (...) { // LCOV_EXCL_LINE
+                clearIndex(); // LCOV_EXCL_LINE
+            }
+            const cluon::data::TimeStamp AFTER{cluon::time::now()};
+
+            std::clog << "[cluon::Player]: " << m_file << " contains " << m_indexSampleTimeStamps.size() << " entries; "
+                      << "read " << totalBytesRead << " bytes "
+                      << "in " << cluon::time::deltaInMicroseconds(AFTER, BEFORE) / static_cast<int64_t>(1000 * 1000) << "s." << std::endl;
+
+            // Reset fstream's error states after reaching EOF.
+            m_recFile.clear();
+
+            // Player is used by tools that only read the rec file; create the sidecar only on request.
+            const char *CLUON_PLAYER_INDEXFILE = getenv("CLUON_PLAYER_INDEXFILE");
+            if (HAS_FINGERPRINT && (nullptr != CLUON_PLAYER_INDEXFILE) && (CLUON_PLAYER_INDEXFILE[0] == '1')) {
+                storeIndexFile(fingerprint);
+            }
+        }
+
+        // The sidecar index describes the complete rec file; filter only afterwards.
+        applyAllowList();
+
+        if (m_memoryMapped && (m_chunked || !mapRecFile(static_cast<uint64_t>(fileLength)))) {
+            std::clog << "[cluon::Player]: " << m_file << " could not be memory-mapped; using cache instead." << std::endl;
+            m_memoryMapped = false;
+        }
+    } else {
+        std::clog << "[cluon::Player]: " << m_file << " could not be opened." << std::endl;
+    }
+}
+
+inline bool Player::mapRecFile(const uint64_t &recFileSize) noexcept {
+    bool retVal{false};
+#ifdef WIN32
+    (void)recFileSize;
+#else
+    const int fd{::open(m_file.c_str(), O_RDONLY)};
+    if ((-1 < fd) && (0 < recFileSize)) {
+        void *mapped{::mmap(nullptr, static_cast<std::size_t>(recFileSize), PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (MAP_FAILED != mapped) {
+            // Envelopes are replayed mostly in the order they were recorded; let the kernel read ahead.
+            ::madvise(mapped, static_cast<std::size_t>(recFileSize), MADV_SEQUENTIAL);
+            m_mappedRecFile     = static_cast<const char *>(mapped);
+            m_mappedRecFileSize = static_cast<std::size_t>(recFileSize);
+            retVal              = true;
+        }
+    }
+    if (-1 < fd) {
+        ::close(fd);
+    }
+#endif
+    return retVal;
+}
+
+inline bool Player::readChunkTable(const uint64_t &recFileSize) noexcept {
+    bool retVal{false};
+    try {
+        m_chunks.clear();
+        auto readUInt32 = [](const char *data) {
+            uint32_t v{0};
+            std::memcpy(&v, data, sizeof(uint32_t));
+            return le32toh(v);
+        };
+        auto readUInt64 = [](const char *data) {
+            uint64_t v{0};
+            std::memcpy(&v, data, sizeof(uint64_t));
+            return le64toh(v);
+        };
+
+        char header[CHUNKED_REC_FILE_HEADER_SIZE]{};
+        m_recFile.read(header, sizeof(header)); // Flawfinder: ignore
+        if (m_recFile.good() && (CHUNKED_REC_FILE_VERSION == readUInt32(header + sizeof(CHUNKED_REC_FILE_MAGIC)))) {
+            // Use the table of chunks at the end of the file if available.
+            char trailer[CHUNKED_REC_FILE_TRAILER_SIZE]{};
+            if (CHUNKED_REC_FILE_HEADER_SIZE + CHUNKED_REC_FILE_TRAILER_SIZE <= recFileSize) {
+                m_recFile.seekg(static_cast<std::streamoff>(recFileSize - CHUNKED_REC_FILE_TRAILER_SIZE));
+                m_recFile.read(trailer, sizeof(trailer)); // Flawfinder: ignore
+            }
+            const uint64_t NUMBER_OF_CHUNKS{readUInt64(trailer)};
+            const uint64_t POSITION_OF_CHUNK_TABLE{readUInt64(trailer + sizeof(uint64_t))};
+            if (m_recFile.good() && (0 == std::memcmp(trailer + 2 * sizeof(uint64_t), CHUNKED_REC_FILE_MAGIC, sizeof(CHUNKED_REC_FILE_MAGIC)))
+                && (CHUNKED_REC_FILE_HEADER_SIZE <= POSITION_OF_CHUNK_TABLE) && (POSITION_OF_CHUNK_TABLE <= recFileSize - CHUNKED_REC_FILE_TRAILER_SIZE)
+                && (NUMBER_OF_CHUNKS == (recFileSize - CHUNKED_REC_FILE_TRAILER_SIZE - POSITION_OF_CHUNK_TABLE) / CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE)
+                && (0 == (recFileSize - CHUNKED_REC_FILE_TRAILER_SIZE - POSITION_OF_CHUNK_TABLE) % CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE)) {
+                std::string table(static_cast<std::size_t>(NUMBER_OF_CHUNKS * CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE), '\0');
+                m_recFile.seekg(static_cast<std::streamoff>(POSITION_OF_CHUNK_TABLE));
+                m_recFile.read(&table[0], static_cast<std::streamsize>(table.size())); // Flawfinder: ignore
+                retVal = m_recFile.good();
+                for (std::size_t position{0}; retVal && (position < table.size()); position += CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE) {
+                    const char *entry{table.data() + position};
+                    ChunkEntry chunk;
+                    chunk.m_filePosition       = readUInt64(entry);
+                    chunk.m_compressedSize     = readUInt32(entry + sizeof(uint64_t));
+                    chunk.m_uncompressedSize   = readUInt32(entry + sizeof(uint64_t) + sizeof(uint32_t));
+                    chunk.m_minSampleTimeStamp = static_cast<int64_t>(readUInt64(entry + sizeof(uint64_t) + 2 * sizeof(uint32_t)));
+                    chunk.m_maxSampleTimeStamp = static_cast<int64_t>(readUInt64(entry + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t)));
+                    chunk.m_numberOfEnvelopes  = readUInt32(entry + 3 * sizeof(uint64_t) + 2 * sizeof(uint32_t));
+                    chunk.m_dataPosition       = m_chunks.empty() ? 0 : m_chunks.back().m_dataPosition + m_chunks.back().m_uncompressedSize;
+
+                    // Chunks must be located between the header and the table of chunks.
+                    retVal = (CHUNKED_REC_FILE_HEADER_SIZE + CHUNKED_REC_FILE_CHUNK_HEADER_SIZE <= chunk.m_filePosition)
+                             && (chunk.m_filePosition <= POSITION_OF_CHUNK_TABLE) && (chunk.m_compressedSize <= POSITION_OF_CHUNK_TABLE - chunk.m_filePosition)
+                             && (chunk.m_compressedSize <= chunk.m_uncompressedSize);
+                    if (retVal) {
+                        m_chunks.push_back(chunk);
+                    }
+                }
+            } else {
+                // Find the chunks from their sizes, e.g., for an interrupted recording.
+                uint64_t position{CHUNKED_REC_FILE_HEADER_SIZE};
+                retVal = true;
+                while (retVal && (position + CHUNKED_REC_FILE_CHUNK_HEADER_SIZE <= recFileSize)) {
+                    char chunkHeader[CHUNKED_REC_FILE_CHUNK_HEADER_SIZE]{};
+                    m_recFile.clear();
+                    m_recFile.seekg(static_cast<std::streamoff>(position));
+                    m_recFile.read(chunkHeader, sizeof(chunkHeader)); // Flawfinder: ignore
+
+                    ChunkEntry chunk;
+                    chunk.m_filePosition     = position + CHUNKED_REC_FILE_CHUNK_HEADER_SIZE;
+                    chunk.m_compressedSize   = readUInt32(chunkHeader);
+                    chunk.m_uncompressedSize = readUInt32(chunkHeader + sizeof(uint32_t));
+                    chunk.m_dataPosition     = m_chunks.empty() ? 0 : m_chunks.back().m_dataPosition + m_chunks.back().m_uncompressedSize;
+                    retVal = m_recFile.good() && (chunk.m_compressedSize <= chunk.m_uncompressedSize);
+                    if (retVal && (chunk.m_compressedSize <= recFileSize - chunk.m_filePosition)) {
+                        m_chunks.push_back(chunk);
+                    } else {
+                        // The last chunk is incomplete.
+                        break;
+                    }
+                    position = chunk.m_filePosition + chunk.m_compressedSize;
+                }
+                std::clog << "[cluon::Player]: " << m_file << " has no table of chunks; found " << m_chunks.size() << " chunks." << std::endl;
+            }
+        }
+    } catch (...) { // LCOV_EXCL_LINE
+        retVal = false; // LCOV_EXCL_LINE
+    }
+    m_recFile.clear();
+    m_recFile.seekg(0, m_recFile.beg);
+    return retVal;
+}
+
+inline uint64_t Player::indexChunks(std::vector<IndexEntry> &entries) {
+    std::vector<std::vector<IndexEntry>> entriesPerChunk(m_chunks.size());
+    std::atomic<std::size_t> nextChunk{0};
+    std::atomic<uint64_t> totalBytesDecompressed{0};
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+    auto indexer = [this, &entriesPerChunk, &nextChunk, &totalBytesDecompressed, &failureMutex, &failure]() {
+        try {
+            // Every thread reads from its own stream.
+            std::fstream in(m_file.c_str(), std::ios_base::in | std::ios_base::binary); /* Flawfinder: ignore */
+            for (std::size_t chunk{nextChunk++}; chunk < m_chunks.size(); chunk = nextChunk++) {
+                const std::string DATA{decompressChunk(readChunk(in, chunk), m_chunks[chunk].m_uncompressedSize)};
+                std::size_t position{0};
+                std::size_t consumed{0};
+                while (position < DATA.size()) {
+                    auto retVal = extractEnvelopeMetaData(DATA.data() + position, DATA.size() - position, consumed);
+                    if (!retVal.first) {
+                        break;
+                    }
+                    entriesPerChunk[chunk].emplace_back(IndexEntry(cluon::time::toMicroseconds(retVal.second.sampleTimeStamp()),
+                                                                   m_chunks[chunk].m_dataPosition + position,
+                                                                   retVal.second.dataType(),
+                                                                   retVal.second.senderStamp(),
+                                                                   static_cast<uint32_t>(consumed)));
+                    position += consumed;
+                }
+                totalBytesDecompressed += DATA.size();
+            }
+        } catch (...) { // LCOV_EXCL_LINE
+            // Stop the other threads and hand the first exception to the caller.
+            std::lock_guard<std::mutex> lck(failureMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            nextChunk = m_chunks.size();
+        }
+    };
+
+    {
+        // Destroying a joinable std::thread terminates the program; join all threads on every path.
+        std::vector<std::thread> threads;
+        struct ThreadJoiner {
+            std::vector<std::thread> &m_threads;
+            ~ThreadJoiner() {
+                for (auto &t : m_threads) {
+                    if (t.joinable()) {
+                        t.join();
+                    }
+                }
+            }
+        } threadJoiner{threads};
+
+        const std::size_t NUMBER_OF_THREADS{(std::min)(m_chunks.size(), static_cast<std::size_t>((std::max)(1u, std::thread::hardware_concurrency())))};
+        try {
+            for (std::size_t i{1}; i < NUMBER_OF_THREADS; i++) {
+                threads.emplace_back(indexer);
+            }
+        } catch (...) {
+            // Stop the threads started so far before handing the exception to the caller.
+            nextChunk = m_chunks.size();
+            throw;
+        }
+        indexer();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    for (const auto &e : entriesPerChunk) {
+        entries.insert(entries.end(), e.begin(), e.end());
+    }
+    return totalBytesDecompressed;
+}
+
+inline std::string Player::readChunk(std::fstream &in, std::size_t chunk) {
+    std::string compressed(m_chunks[chunk].m_compressedSize, '\0');
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(m_chunks[chunk].m_filePosition));
+    in.read(&compressed[0], static_cast<std::streamsize>(compressed.size())); // Flawfinder: ignore
+    if (static_cast<std::size_t>(in.gcount()) != compressed.size()) {
+        compressed.clear();
+    }
+    return compressed;
+}
+
+inline std::string Player::decompressChunk(std::string &&compressed, uint32_t uncompressedSize) noexcept {
+    std::string decompressed;
+    if (compressed.size() == uncompressedSize) {
+        decompressed = std::move(compressed);
+    } else if (!cluon::compression::decompress(compressed.data(), compressed.size(), uncompressedSize, decompressed)) {
+        decompressed.clear();
+    }
+    return decompressed;
+}
+
+inline std::pair<bool, cluon::data::Envelope> Player::extractEnvelopeFromChunk(const uint64_t &position) noexcept {
+    std::pair<bool, cluon::data::Envelope> retVal{false, cluon::data::Envelope()};
+    try {
+        auto it = std::upper_bound(
+            m_chunks.begin(), m_chunks.end(), position, [](const uint64_t &p, const ChunkEntry &chunk) { return p < chunk.m_dataPosition; });
+        if (m_chunks.begin() != it) {
+            const std::size_t CHUNK{static_cast<std::size_t>(it - m_chunks.begin()) - 1};
+            if ((CHUNK != m_currentChunk) || m_currentChunkData.empty()) {
+                m_currentChunk = CHUNK;
+                m_currentChunkData.clear();
+
+                // Use the chunk if it was decompressed in the background already and drop
+                // the ones that are not ahead anymore, e.g., after seeking.
+                for (auto &prefetchedChunk : m_prefetchedChunks) {
+                    if (CHUNK == prefetchedChunk.first) {
+                        m_currentChunkData = prefetchedChunk.second.get();
+                    }
+                }
+                m_prefetchedChunks.erase(std::remove_if(m_prefetchedChunks.begin(),
+                                                        m_prefetchedChunks.end(),
+                                                        [CHUNK](const std::pair<std::size_t, std::future<std::string>> &prefetchedChunk) {
+                                                            return (prefetchedChunk.first <= CHUNK) || (CHUNK + Player::CHUNKS_TO_PREFETCH < prefetchedChunk.first);
+                                                        }),
+                                         m_prefetchedChunks.end());
+                if (m_currentChunkData.empty()) {
+                    m_currentChunkData = decompressChunk(readChunk(m_recFile, CHUNK), m_chunks[CHUNK].m_uncompressedSize);
+                }
+
+                // Decompress the subsequent chunks concurrently.
+                for (std::size_t next{CHUNK + 1}; (next <= CHUNK + Player::CHUNKS_TO_PREFETCH) && (next < m_chunks.size()); next++) {
+                    auto prefetched = std::find_if(m_prefetchedChunks.begin(),
+                                                   m_prefetchedChunks.end(),
+                                                   [next](const std::pair<std::size_t, std::future<std::string>> &prefetchedChunk) { return next == prefetchedChunk.first; });
+                    if (m_prefetchedChunks.end() == prefetched) {
+                        m_prefetchedChunks.emplace_back(
+                            next, std::async(std::launch::async, &Player::decompressChunk, readChunk(m_recFile, next), m_chunks[next].m_uncompressedSize));
+                    }
+                }
+            }
+
+            const uint64_t OFFSET{position - m_chunks[CHUNK].m_dataPosition};
+            if (OFFSET < m_currentChunkData.size()) {
+                retVal = extractEnvelope(m_currentChunkData.data() + OFFSET, m_currentChunkData.size() - static_cast<std::size_t>(OFFSET));
+            }
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline void Player::appendToIndex(const IndexEntry &entry) {
+    m_indexSampleTimeStamps.push_back(entry.m_sampleTimeStamp);
+    m_indexFilePositions.push_back(entry.m_filePosition);
+    m_indexDataTypes.push_back(entry.m_dataType);
+    m_indexSenderStamps.push_back(entry.m_senderStamp);
+    m_indexSizes.push_back(entry.m_size);
+}
+
+inline void Player::clearIndex() noexcept {
+    m_indexSampleTimeStamps.clear();
+    m_indexFilePositions.clear();
+    m_indexDataTypes.clear();
+    m_indexSenderStamps.clear();
+    m_indexSizes.clear();
+}
+
+inline void Player::applyAllowList() noexcept {
+    if (!m_allowList.empty()) {
+        const std::size_t TOTAL{m_indexSampleTimeStamps.size()};
+        std::size_t kept{0};
+        for (std::size_t i{0}; i < TOTAL; i++) {
+            auto it = m_allowList.find(m_indexDataTypes[i]);
+            if ((it != m_allowList.end()) && (it->second.empty() || (0 < it->second.count(m_indexSenderStamps[i])))) {
+                m_indexSampleTimeStamps[kept] = m_indexSampleTimeStamps[i];
+                m_indexFilePositions[kept]    = m_indexFilePositions[i];
+                m_indexDataTypes[kept]        = m_indexDataTypes[i];
+                m_indexSenderStamps[kept]     = m_indexSenderStamps[i];
+                m_indexSizes[kept]            = m_indexSizes[i];
+                kept++;
+            }
+        }
+        m_indexSampleTimeStamps.resize(kept);
+        m_indexFilePositions.resize(kept);
+        m_indexDataTypes.resize(kept);
+        m_indexSenderStamps.resize(kept);
+        m_indexSizes.resize(kept);
+
+        std::clog << "[cluon::Player]: Replaying " << kept << " of " << TOTAL << " entries from " << m_file << "." << std::endl;
+    }
+}
+
+inline bool Player::loadIndexFile(const RecFileFingerprint &fingerprint) noexcept {
+    bool retVal{false};
+#ifdef WIN32
+    (void)fingerprint;
+#else
+    // Positions in a chunked rec file refer to the decompressed chunks.
+    uint64_t dataSize{fingerprint.m_size};
+    if (m_chunked) {
+        dataSize = (m_chunks.empty() ? 0 : m_chunks.back().m_dataPosition + m_chunks.back().m_uncompressedSize);
+    }
+    const int fd{::open(m_indexFile.c_str(), O_RDONLY)};
+    if (-1 < fd) {
+        struct stat fileStatus {};
+        if ((0 == ::fstat(fd, &fileStatus)) && (PLAYER_INDEX_FILE_HEADER_SIZE <= static_cast<std::size_t>(fileStatus.st_size))) {
+            const std::size_t SIZE{static_cast<std::size_t>(fileStatus.st_size)};
+            void *mapped{::mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, fd, 0)};
+            if (MAP_FAILED != mapped) {
+                const char *data{static_cast<const char *>(mapped)};
+                auto readUInt32 = [data](std::size_t position) {
+                    uint32_t v{0};
+                    std::memcpy(&v, data + position, sizeof(uint32_t));
+                    return le32toh(v);
+                };
+                auto readUInt64 = [data](std::size_t position) {
+                    uint64_t v{0};
+                    std::memcpy(&v, data + position, sizeof(uint64_t));
+                    return le64toh(v);
+                };
+
+                constexpr std::size_t FINGERPRINT_POSITION{sizeof(PLAYER_INDEX_FILE_MAGIC) + 2 * sizeof(uint32_t)};
+                const uint64_t NUMBER_OF_ENTRIES{readUInt64(FINGERPRINT_POSITION + 3 * sizeof(uint64_t))};
+                if ((0 == std::memcmp(data, PLAYER_INDEX_FILE_MAGIC, sizeof(PLAYER_INDEX_FILE_MAGIC)))
+                    && (PLAYER_INDEX_FILE_VERSION == readUInt32(sizeof(PLAYER_INDEX_FILE_MAGIC)))
+                    && (PLAYER_INDEX_FILE_ENTRY_SIZE == readUInt32(sizeof(PLAYER_INDEX_FILE_MAGIC) + sizeof(uint32_t)))
+                    && (fingerprint.m_size == readUInt64(FINGERPRINT_POSITION))
+                    && (fingerprint.m_modificationTime == static_cast<int64_t>(readUInt64(FINGERPRINT_POSITION + sizeof(uint64_t))))
+                    && (fingerprint.m_contentHash == readUInt64(FINGERPRINT_POSITION + 2 * sizeof(uint64_t)))
+                    && (NUMBER_OF_ENTRIES == (SIZE - PLAYER_INDEX_FILE_HEADER_SIZE) / PLAYER_INDEX_FILE_ENTRY_SIZE)
+                    && (0 == (SIZE - PLAYER_INDEX_FILE_HEADER_SIZE) % PLAYER_INDEX_FILE_ENTRY_SIZE)) {
+                    try {
+                        retVal = true;
+                        m_indexSampleTimeStamps.reserve(static_cast<std::size_t>(NUMBER_OF_ENTRIES));
+                        m_indexFilePositions.reserve(static_cast<std::size_t>(NUMBER_OF_ENTRIES));
+                        m_indexDataTypes.reserve(static_cast<std::size_t>(NUMBER_OF_ENTRIES));
+                        m_indexSenderStamps.reserve(static_cast<std::size_t>(NUMBER_OF_ENTRIES));
+                        m_indexSizes.reserve(static_cast<std::size_t>(NUMBER_OF_ENTRIES));
+                        int64_t previousSampleTimeStamp{(std::numeric_limits<int64_t>::min)()};
+                        for (std::size_t position{PLAYER_INDEX_FILE_HEADER_SIZE}; retVal && (position < SIZE); position += PLAYER_INDEX_FILE_ENTRY_SIZE) {
+                            const int64_t SAMPLE_TIMESTAMP{static_cast<int64_t>(readUInt64(position))};
+                            const uint64_t FILE_POSITION{readUInt64(position + sizeof(uint64_t))};
+                            const int32_t DATATYPE{static_cast<int32_t>(readUInt32(position + 2 * sizeof(uint64_t)))};
+                            const uint32_t SENDERSTAMP{readUInt32(position + 2 * sizeof(uint64_t) + sizeof(uint32_t))};
+                            const uint32_t LENGTH{readUInt32(position + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t))};
+
+                            // Entries are stored chronologically and must point into the rec file.
+                            retVal = (previousSampleTimeStamp <= SAMPLE_TIMESTAMP) && (FILE_POSITION < dataSize) && (LENGTH <= dataSize - FILE_POSITION);
+                            if (retVal) {
+                                appendToIndex(IndexEntry(SAMPLE_TIMESTAMP, FILE_POSITION, DATATYPE, SENDERSTAMP, LENGTH));
+                                previousSampleTimeStamp = SAMPLE_TIMESTAMP;
+                            }
+                        }
+                    } catch (...) { // LCOV_EXCL_LINE
+                        retVal = false; // LCOV_EXCL_LINE
+                    }
+                    if (!retVal) {
+                        clearIndex();
+                    }
+                }
+                ::munmap(mapped, SIZE);
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    return retVal;
+}
+
+/**
+ * This function writes an index sidecar file for a rec file.
+ *
+ * @param indexFile Name of the index sidecar file.
+ * @param fingerprint Fingerprint of the rec file.
+ * @param numberOfEntries Number of entries in the index.
+ * @param entry Function returning the entries of the index in chronological order.
+ * @return true if the index sidecar file was written.
+ */
+inline bool storeIndexEntries(const std::string &indexFile,
+                              const RecFileFingerprint &fingerprint,
+                              const std::size_t &numberOfEntries,
+                              const std::function<IndexEntry(std::size_t)> &entry) noexcept {
+    bool retVal{false};
+#ifdef WIN32
+    (void)indexFile;
+    (void)fingerprint;
+    (void)numberOfEntries;
+    (void)entry;
+#else
+    try {
+        std::string buffer;
+        buffer.reserve(PLAYER_INDEX_FILE_HEADER_SIZE + numberOfEntries * PLAYER_INDEX_FILE_ENTRY_SIZE);
+        auto appendUInt32 = [&buffer](uint32_t v) {
+            v = htole32(v);
+            buffer.append(reinterpret_cast<const char *>(&v), sizeof(uint32_t));
+        };
+        auto appendUInt64 = [&buffer](uint64_t v) {
+            v = htole64(v);
+            buffer.append(reinterpret_cast<const char *>(&v), sizeof(uint64_t));
+        };
 
-        // Read complete file and store file positions to envelopes to create
-        // index of available data. The actual reading of Envelopes is deferred.
-        uint64_t totalBytesRead = 0;
-        const cluon::data::TimeStamp BEFORE{cluon::time::now()};
-        {
-            int32_t oldPercentage = -1;
-            while (m_recFile.good()) {
-                const uint64_t POS_BEFORE = static_cast<uint64_t>(m_recFile.tellg());
-                auto retVal               = extractEnvelope(m_recFile);
-                const uint64_t POS_AFTER  = static_cast<uint64_t>(m_recFile.tellg());
-
-                if (!m_recFile.eof() && retVal.first) {
-                    totalBytesRead += (POS_AFTER - POS_BEFORE);
-
-                    // Store mapping .rec file position --> index entry.
-                    const int64_t microseconds = cluon::time::toMicroseconds(retVal.second.sampleTimeStamp());
-                    m_index.emplace(std::make_pair(microseconds, IndexEntry(microseconds, POS_BEFORE)));
-
-                    const int32_t percentage = static_cast<int32_t>((static_cast<float>(m_recFile.tellg()) * 100.0f) / static_cast<float>(fileLength));
-                    if ((percentage % 5 == 0) && (percentage != oldPercentage)) {
-                        std::clog << "[cluon::Player]: Indexed " << percentage << "% from " << m_file << "." << std::endl;
-                        oldPercentage = percentage;
-                    }
+        buffer.append(PLAYER_INDEX_FILE_MAGIC, sizeof(PLAYER_INDEX_FILE_MAGIC));
+        appendUInt32(PLAYER_INDEX_FILE_VERSION);
+        appendUInt32(static_cast<uint32_t>(PLAYER_INDEX_FILE_ENTRY_SIZE));
+        appendUInt64(fingerprint.m_size);
+        appendUInt64(static_cast<uint64_t>(fingerprint.m_modificationTime));
+        appendUInt64(fingerprint.m_contentHash);
+        appendUInt64(static_cast<uint64_t>(numberOfEntries));
+        for (std::size_t i{0}; i < numberOfEntries; i++) {
+            const IndexEntry e{entry(i)};
+            appendUInt64(static_cast<uint64_t>(e.m_sampleTimeStamp));
+            appendUInt64(e.m_filePosition);
+            appendUInt32(static_cast<uint32_t>(e.m_dataType));
+            appendUInt32(e.m_senderStamp);
+            appendUInt32(e.m_size);
+            appendUInt32(0);
+        }
+
+        // Write to a unique temporary file first so that concurrent readers never see a partial
+        // index and concurrent writers do not interfere; the complete file replaces the sidecar.
+        std::vector<char> tmp(indexFile.begin(), indexFile.end());
+        const char SUFFIX[]{".XXXXXX"};
+        tmp.insert(tmp.end(), SUFFIX, SUFFIX + sizeof(SUFFIX));
+        const int fd{::mkstemp(tmp.data())};
+        if (-1 < fd) {
+            std::size_t written{0};
+            while (written < buffer.size()) {
+                const ssize_t BYTES{::write(fd, buffer.data() + written, buffer.size() - written)};
+                if (0 < BYTES) {
+                    written += static_cast<std::size_t>(BYTES);
+                } else if (!((-1 == BYTES) && (EINTR == errno))) {
+                    break;
                 }
             }
+            retVal = (written == buffer.size()) && (0 == ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)) && (0 == ::fsync(fd));
+            retVal = (0 == ::close(fd)) && retVal;
+            retVal = retVal && (0 == std::rename(tmp.data(), indexFile.c_str()));
+            if (!retVal) {
+                ::unlink(tmp.data());
+            }
         }
-        const cluon::data::TimeStamp AFTER{cluon::time::now()};
+    } catch (...) {} // LCOV_EXCL_LINE
+#endif
+    return retVal;
+}
 
-        std::clog << "[cluon::Player]: " << m_file << " contains " << m_index.size() << " entries; "
-                  << "read " << totalBytesRead << " bytes "
-                  << "in " << cluon::time::deltaInMicroseconds(AFTER, BEFORE) / static_cast<int64_t>(1000 * 1000) << "s." << std::endl;
-    } else {
-        std::clog << "[cluon::Player]: " << m_file << " could not be opened." << std::endl;
+inline void Player::storeIndexFile(const RecFileFingerprint &fingerprint) noexcept {
+    auto entry = [this](std::size_t i) {
+        return IndexEntry(m_indexSampleTimeStamps[i], m_indexFilePositions[i], m_indexDataTypes[i], m_indexSenderStamps[i], m_indexSizes[i]);
+    };
+    if (storeIndexEntries(m_indexFile, fingerprint, m_indexSampleTimeStamps.size(), entry)) {
+        std::clog << "[cluon::Player]: Stored index in " << m_indexFile << "." << std::endl;
     }
 }
 
@@ -14480,7 +18560,13 @@ inline void Player::resetCaches() noexcept {
         std::lock_guard<std::mutex> lck(m_indexMutex);
         m_delay                            = 0;
         m_numberOfReturnedEnvelopesInTotal = 0;
-        m_envelopeCache.clear();
+        for (auto &e : m_envelopeCache) {
+            e = cluon::data::Envelope();
+        }
+        m_envelopeCacheHead     = 0;
+        m_envelopeCacheEntries  = 0;
+        m_envelopeCacheBytes    = 0;
+        m_mappedRecFileReleased = 0;
     } catch (...) {} // LCOV_EXCL_LINE
 }
 
@@ -14488,57 +18574,87 @@ inline void Player::resetIterators() noexcept {
     try {
         std::lock_guard<std::mutex> lck(m_indexMutex);
         // Point to first entry in index.
-        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay = m_index.begin();
-        // Invalidate iterator for erasing entries point.
-        m_previousPreviousEnvelopeAlreadyReplayed = m_index.end();
+        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay = 0;
     } catch (...) {} // LCOV_EXCL_LINE
 }
 
 inline void Player::computeInitialCacheLevelAndFillCache() noexcept {
-    if (m_recFileValid && (m_index.size() > 0)) {
-        int64_t smallestSampleTimePoint = (std::numeric_limits<int64_t>::max)();
-        int64_t largestSampleTimePoint  = (std::numeric_limits<int64_t>::min)();
-        for (auto it = m_index.begin(); it != m_index.end(); it++) {
-            smallestSampleTimePoint = (std::min)(smallestSampleTimePoint, it->first);
-            largestSampleTimePoint  = (std::max)(largestSampleTimePoint, it->first);
+    if (m_recFileValid && (m_indexSampleTimeStamps.size() > 0)) {
+        if (!m_memoryMapped) {
+            uint64_t totalBytes{0};
+            for (const auto size : m_indexSizes) {
+                totalBytes += size;
+            }
+            const uint64_t AVERAGE_BYTES_PER_ENTRY{sizeof(cluon::data::Envelope) + totalBytes / m_indexSizes.size()};
+            const std::size_t CAPACITY{static_cast<std::size_t>(
+                (std::min<uint64_t>)(m_indexSizes.size(), (std::max<uint64_t>)(1, Player::LOOK_AHEAD_IN_BYTES / AVERAGE_BYTES_PER_ENTRY)))};
+            if (m_envelopeCache.size() != CAPACITY) {
+                std::clog << "[cluon::Player]: Initializing cache with " << CAPACITY << " entries." << std::endl;
+                try {
+                    std::lock_guard<std::mutex> lck(m_indexMutex);
+                    m_envelopeCache = std::vector<cluon::data::Envelope>(CAPACITY);
+                } catch (...) {} // LCOV_EXCL_LINE
+            }
         }
 
-        const uint32_t ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY
-            = static_cast<uint32_t>(std::ceil(static_cast<float>(m_index.size()) * (static_cast<float>(Player::ONE_SECOND_IN_MICROSECONDS))
-                                              / static_cast<float>(largestSampleTimePoint - smallestSampleTimePoint)));
-        m_desiredInitialLevel = (std::max<uint32_t>)(ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY * Player::LOOK_AHEAD_IN_S, MIN_ENTRIES_FOR_LOOK_AHEAD);
-
-        std::clog << "[cluon::Player]: Initializing cache with " << m_desiredInitialLevel << " entries." << std::endl;
-
         resetCaches();
         resetIterators();
-        fillEnvelopeCache(m_desiredInitialLevel);
+        fillEnvelopeCache((std::numeric_limits<uint32_t>::max)());
     }
 }
 
+inline bool Player::hasRoomInEnvelopeCache() const noexcept {
+    // An Envelope larger than the look-ahead is accepted into an empty cache.
+    return (m_nextEntryToReadFromRecFile < m_indexSizes.size()) && (m_envelopeCacheEntries < m_envelopeCache.size())
+           && ((0 == m_envelopeCacheEntries) || (m_envelopeCacheBytes + m_indexSizes[m_nextEntryToReadFromRecFile] <= Player::LOOK_AHEAD_IN_BYTES));
+}
+
 inline uint32_t Player::fillEnvelopeCache(const uint32_t &maxNumberOfEntriesToReadFromFile) noexcept {
     uint32_t entriesReadFromFile = 0;
-    if (m_recFileValid && (maxNumberOfEntriesToReadFromFile > 0)) {
+    if (m_recFileValid && !m_memoryMapped) {
         // Reset any fstream's error states.
         m_recFile.clear();
 
-        while ((m_nextEntryToReadFromRecFile != m_index.end()) && (entriesReadFromFile < maxNumberOfEntriesToReadFromFile)) {
-            // Move to corresponding position in the .rec file.
-            m_recFile.seekg(static_cast<std::streamoff>(m_nextEntryToReadFromRecFile->second.m_filePosition));
+        // Only seek when the next entry does not follow the previous one in the .rec file.
+        uint64_t positionInRecFile{(std::numeric_limits<uint64_t>::max)()};
+        while (entriesReadFromFile < maxNumberOfEntriesToReadFromFile) {
+            std::size_t entry{0};
+            try {
+                std::lock_guard<std::mutex> lck(m_indexMutex);
+                if (!hasRoomInEnvelopeCache()) {
+                    break;
+                }
+                entry = m_nextEntryToReadFromRecFile;
+            } catch (...) { // LCOV_EXCL_LINE
+                break; // LCOV_EXCL_LINE
+            }
 
-            // Read the corresponding cluon::data::Envelope.
-            auto retVal = extractEnvelope(m_recFile);
-            if (retVal.first) {
-                // Store the envelope in the envelope cache.
-                try {
-                    std::lock_guard<std::mutex> lck(m_indexMutex);
-                    m_nextEntryToReadFromRecFile->second.m_available
-                        = m_envelopeCache.emplace(std::make_pair(m_nextEntryToReadFromRecFile->second.m_filePosition, retVal.second)).second;
-                } catch (...) {} // LCOV_EXCL_LINE
+            // Read the corresponding cluon::data::Envelope; an unreadable entry is replayed as empty Envelope.
+            const uint64_t FILE_POSITION{m_indexFilePositions[entry]};
+            std::pair<bool, cluon::data::Envelope> retVal;
+            if (m_chunked) {
+                retVal = extractEnvelopeFromChunk(FILE_POSITION);
+            } else {
+                // Move to corresponding position in the .rec file.
+                if (FILE_POSITION != positionInRecFile) {
+                    m_recFile.clear();
+                    m_recFile.seekg(static_cast<std::streamoff>(FILE_POSITION));
+                }
+                retVal            = extractEnvelope(m_recFile);
+                positionInRecFile = FILE_POSITION + m_indexSizes[entry];
+            }
 
+            // Append the envelope to the envelope cache.
+            try {
+                std::lock_guard<std::mutex> lck(m_indexMutex);
+                m_envelopeCache[(m_envelopeCacheHead + m_envelopeCacheEntries) % m_envelopeCache.size()] = std::move(retVal.second);
+                m_envelopeCacheEntries++;
+                m_envelopeCacheBytes += m_indexSizes[entry];
                 m_nextEntryToReadFromRecFile++;
-                entriesReadFromFile++;
-            }
+            } catch (...) {} // LCOV_EXCL_LINE
+            m_envelopeCacheNotEmpty.notify_one();
+
+            entriesReadFromFile++;
         }
     }
 
@@ -14546,11 +18662,20 @@ inline uint32_t Player::fillEnvelopeCache(const uint32_t &maxNumberOfEntriesToRe
 }
 
 inline std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplayed() noexcept {
+    if (m_memoryMapped) {
+        // Decode the next Envelope straight from the memory-mapped rec file.
+        auto next = getNextSerializedEnvelopeToBeReplayed();
+        if (nullptr != next.first) {
+            return extractEnvelope(next.first, next.second);
+        }
+        return std::make_pair(false, cluon::data::Envelope());
+    }
+
     bool hasEnvelopeToReturn{false};
     cluon::data::Envelope envelopeToReturn;
 
     // If at "EOF", either throw exception or autorewind.
-    if (m_currentEnvelopeToReplay == m_index.end()) {
+    if (m_currentEnvelopeToReplay == m_indexSampleTimeStamps.size()) {
         if (!m_autoRewind) {
             return std::make_pair(hasEnvelopeToReturn, envelopeToReturn);
         } else {
@@ -14558,39 +18683,40 @@ inline std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplaye
         }
     }
 
-    if (m_currentEnvelopeToReplay != m_index.end()) {
-        checkAvailabilityOfNextEnvelopeToBeReplayed();
+    if (m_currentEnvelopeToReplay != m_indexSampleTimeStamps.size()) {
+        // If Player is non-threaded, refill the cache sequentially once it is drained.
+        if (!m_threading) {
+            bool isEmpty{false};
+            try {
+                std::lock_guard<std::mutex> lck(m_indexMutex);
+                isEmpty = (0 == m_envelopeCacheEntries);
+            } catch (...) {} // LCOV_EXCL_LINE
+            if (isEmpty) {
+                fillEnvelopeCache((std::numeric_limits<uint32_t>::max)());
+            }
+        }
 
         try {
             {
-                std::lock_guard<std::mutex> lck(m_indexMutex);
-
-                cluon::data::Envelope &nextEnvelope = m_envelopeCache[m_currentEnvelopeToReplay->second.m_filePosition];
-                envelopeToReturn                    = nextEnvelope;
+                std::unique_lock<std::mutex> lck(m_indexMutex);
+                // Wait for the concurrent thread to provide the next Envelope.
+                m_envelopeCacheNotEmpty.wait(lck, [this]() { return (0 < m_envelopeCacheEntries); });
 
-                m_delay = static_cast<uint32_t>(m_currentEnvelopeToReplay->first - m_previousEnvelopeAlreadyReplayed->first);
+                envelopeToReturn    = std::move(m_envelopeCache[m_envelopeCacheHead]);
+                m_envelopeCacheHead = (m_envelopeCacheHead + 1) % m_envelopeCache.size();
+                m_envelopeCacheEntries--;
+                m_envelopeCacheBytes -= m_indexSizes[m_currentEnvelopeToReplay];
 
-                // TODO: Delegate deleting into own thread.
-                if (m_previousPreviousEnvelopeAlreadyReplayed != m_index.end()) {
-                    auto it = m_envelopeCache.find(m_previousEnvelopeAlreadyReplayed->second.m_filePosition);
-                    if (it != m_envelopeCache.end()) {
-                        m_envelopeCache.erase(it);
-                    }
-                }
+                m_delay = static_cast<uint32_t>(m_indexSampleTimeStamps[m_currentEnvelopeToReplay] - m_indexSampleTimeStamps[m_previousEnvelopeAlreadyReplayed]);
 
-                m_previousPreviousEnvelopeAlreadyReplayed = m_previousEnvelopeAlreadyReplayed;
-                m_previousEnvelopeAlreadyReplayed         = m_currentEnvelopeToReplay++;
+                m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay++;
 
                 m_numberOfReturnedEnvelopesInTotal++;
             }
+            m_envelopeCacheNotFull.notify_one();
 
             // TODO compensate for internal data processing.
 
-            // If Player is non-threaded, read next entry sequentially.
-            if (!m_threading) {
-                fillEnvelopeCache(1);
-            }
-
             // Store sample time stamp as int64 to avoid unnecessary copying of Envelopes.
             hasEnvelopeToReturn = true;
         } catch (...) {} // LCOV_EXCL_LINE
@@ -14598,27 +18724,44 @@ inline std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplaye
     return std::make_pair(hasEnvelopeToReturn, envelopeToReturn);
 }
 
-inline void Player::checkAvailabilityOfNextEnvelopeToBeReplayed() noexcept {
-    uint64_t numberOfEntries = 0;
-    do {
-        {
+inline std::pair<const char *, std::size_t> Player::getNextSerializedEnvelopeToBeReplayed() noexcept {
+    std::pair<const char *, std::size_t> retVal{nullptr, 0};
+    if (m_memoryMapped) {
+        // If at "EOF", either stop or autorewind.
+        if ((m_currentEnvelopeToReplay == m_indexSampleTimeStamps.size()) && m_autoRewind) {
+            rewind();
+        }
+
+        if (m_currentEnvelopeToReplay != m_indexSampleTimeStamps.size()) {
             try {
                 std::lock_guard<std::mutex> lck(m_indexMutex);
-                numberOfEntries = m_envelopeCache.size();
+                const uint64_t FILE_POSITION{m_indexFilePositions[m_currentEnvelopeToReplay]};
+                retVal = std::make_pair(m_mappedRecFile + FILE_POSITION, static_cast<std::size_t>(m_indexSizes[m_currentEnvelopeToReplay]));
+
+                m_delay = static_cast<uint32_t>(m_indexSampleTimeStamps[m_currentEnvelopeToReplay] - m_indexSampleTimeStamps[m_previousEnvelopeAlreadyReplayed]);
+
+                m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay++;
+                m_numberOfReturnedEnvelopesInTotal++;
+
+#ifndef WIN32
+                // Release pages far behind the replay position to keep the memory
+                // footprint constant; they are read again from the rec file if needed.
+                if (FILE_POSITION > m_mappedRecFileReleased + 2 * MAPPED_BYTES_TO_RELEASE) {
+                    ::madvise(const_cast<char *>(m_mappedRecFile) + m_mappedRecFileReleased, MAPPED_BYTES_TO_RELEASE, MADV_DONTNEED);
+                    m_mappedRecFileReleased += MAPPED_BYTES_TO_RELEASE;
+                }
+#endif
             } catch (...) {} // LCOV_EXCL_LINE
         }
-        if (0 == numberOfEntries) {
-            using namespace std::chrono_literals; // LCOV_EXCL_LINE
-            std::this_thread::sleep_for(10ms);    // LCOV_EXCL_LINE
-        }
-    } while (0 == numberOfEntries);
+    }
+    return retVal;
 }
 
 ////////////////////////////////////////////////////////////////////////
 
 inline uint32_t Player::totalNumberOfEnvelopesInRecFile() const noexcept {
     std::lock_guard<std::mutex> lck(m_indexMutex);
-    return static_cast<uint32_t>(m_index.size());
+    return static_cast<uint32_t>(m_indexSampleTimeStamps.size());
 }
 
 inline uint32_t Player::delay() const noexcept {
@@ -14645,56 +18788,64 @@ inline void Player::rewind() noexcept {
 
 inline void Player::seekTo(float ratio) noexcept {
     if (!(ratio < 0) && !(ratio > 1)) {
-        bool enableThreading = m_threading;
-        if (m_threading) {
-            // Stop concurrent thread.
-            setEnvelopeCacheFillingRunning(false);
-            m_envelopeCacheFillingThread.join();
-        }
-
-        // Read data sequentially.
-        m_threading = false;
-
-        resetCaches();
-        resetIterators();
-
         uint32_t numberOfEntriesInIndex = 0;
         try {
             std::lock_guard<std::mutex> lck(m_indexMutex);
-            numberOfEntriesInIndex = static_cast<uint32_t>(m_index.size());
+            numberOfEntriesInIndex = static_cast<uint32_t>(m_indexSampleTimeStamps.size());
         } catch (...) {} // LCOV_EXCL_LINE
 
-        // Fast forward.
-        m_numberOfReturnedEnvelopesInTotal = 0;
         std::clog << "[cluon::Player]: Seeking to " << static_cast<float>(numberOfEntriesInIndex) * ratio << "/" << numberOfEntriesInIndex << std::endl;
-        if (0 < ratio) {
-            for (m_numberOfReturnedEnvelopesInTotal = 0;
-                 m_numberOfReturnedEnvelopesInTotal < static_cast<uint32_t>(static_cast<float>(numberOfEntriesInIndex) * ratio) - 1;
-                 m_numberOfReturnedEnvelopesInTotal++) {
-                m_currentEnvelopeToReplay++;
-            }
-        }
-        try {
-            std::lock_guard<std::mutex> lck(m_indexMutex);
-            m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay;
-        } catch (...) {} // LCOV_EXCL_LINE
-
-        // Refill cache.
-        m_envelopeCache.clear();
-        fillEnvelopeCache(static_cast<uint32_t>(static_cast<float>(m_desiredInitialLevel) * .3f));
-
+        const uint32_t ENTRY{static_cast<uint32_t>(static_cast<float>(numberOfEntriesInIndex) * ratio)};
         // Correct iterators if not at the beginning.
-        if ((0 < ratio) && (ratio < 1)) {
-            getNextEnvelopeToBeReplayed();
-        }
+        seekToEntry((0 < ENTRY) ? ENTRY - 1 : 0, (0 < ratio) && (ratio < 1));
         std::clog << "[cluon::Player]: Seeking done." << std::endl;
+    }
+}
 
-        if (enableThreading) {
-            m_threading = enableThreading;
-            // Re-start concurrent thread.
-            setEnvelopeCacheFillingRunning(true);
-            m_envelopeCacheFillingThread = std::thread(&Player::manageCache, this);
-        }
+inline void Player::seekToTimestamp(int64_t sampleTimeStamp) noexcept {
+    std::size_t entry{0};
+    try {
+        std::lock_guard<std::mutex> lck(m_indexMutex);
+        entry = static_cast<std::size_t>(std::lower_bound(m_indexSampleTimeStamps.begin(), m_indexSampleTimeStamps.end(), sampleTimeStamp)
+                                         - m_indexSampleTimeStamps.begin());
+    } catch (...) {} // LCOV_EXCL_LINE
+    seekToEntry(entry, false);
+}
+
+inline void Player::seekToEntry(std::size_t entry, bool skipEntry) noexcept {
+    bool enableThreading = m_threading;
+    if (m_threading) {
+        // Stop concurrent thread.
+        setEnvelopeCacheFillingRunning(false);
+        m_envelopeCacheFillingThread.join();
+    }
+
+    // Read data sequentially.
+    m_threading = false;
+
+    resetCaches();
+    resetIterators();
+
+    // Fast forward.
+    try {
+        std::lock_guard<std::mutex> lck(m_indexMutex);
+        m_currentEnvelopeToReplay          = (std::min)(entry, m_indexSampleTimeStamps.size());
+        m_numberOfReturnedEnvelopesInTotal = m_currentEnvelopeToReplay;
+        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay;
+    } catch (...) {} // LCOV_EXCL_LINE
+
+    // Refill cache.
+    fillEnvelopeCache((std::numeric_limits<uint32_t>::max)());
+
+    if (skipEntry) {
+        getNextEnvelopeToBeReplayed();
+    }
+
+    if (enableThreading) {
+        m_threading = enableThreading;
+        // Re-start concurrent thread.
+        setEnvelopeCacheFillingRunning(true);
+        m_envelopeCacheFillingThread = std::thread(&Player::manageCache, this);
     }
 }
 
@@ -14707,78 +18858,384 @@ inline bool Player::hasMoreDataFromRecFile() const noexcept {
     // File must be successfully opened AND
     //  the Player must be configured as m_autoRewind OR
     //  some entries are left to replay.
-    return (m_recFileValid && (m_autoRewind || (m_currentEnvelopeToReplay != m_index.end())));
+    return (m_recFileValid && (m_autoRewind || (m_currentEnvelopeToReplay != m_indexSampleTimeStamps.size())));
 }
 
 ////////////////////////////////////////////////////////////////////////
 
 inline void Player::setEnvelopeCacheFillingRunning(const bool &running) noexcept {
+    {
+        std::lock_guard<std::mutex> lck(m_envelopeCacheFillingThreadIsRunningMutex);
+        m_envelopeCacheFillingThreadIsRunning = running;
+    }
+    try {
+        // Synchronize with the concurrent thread before waking it up to not miss the notification.
+        std::lock_guard<std::mutex> lck(m_indexMutex);
+    } catch (...) {} // LCOV_EXCL_LINE
+    m_envelopeCacheNotFull.notify_all();
+}
+
+inline bool Player::isEnvelopeCacheFillingRunning() const noexcept {
     std::lock_guard<std::mutex> lck(m_envelopeCacheFillingThreadIsRunningMutex);
-    m_envelopeCacheFillingThreadIsRunning = running;
+    return m_envelopeCacheFillingThreadIsRunning;
+}
+
+inline void Player::manageCache() noexcept {
+    cluon::data::TimeStamp lastStatistics{cluon::time::now()};
+
+    while (isEnvelopeCacheFillingRunning()) {
+        bool hasRoom{false};
+        try {
+            // Wait until there is room in the cache or until statistics are due.
+            std::unique_lock<std::mutex> lck(m_indexMutex);
+            using namespace std::chrono_literals;
+            hasRoom = m_envelopeCacheNotFull.wait_for(lck, 100ms, [this]() { return hasRoomInEnvelopeCache() || !isEnvelopeCacheFillingRunning(); })
+                      && hasRoomInEnvelopeCache();
+        } catch (...) {} // LCOV_EXCL_LINE
+
+        if (hasRoom) {
+            fillEnvelopeCache((std::numeric_limits<uint32_t>::max)());
+        }
+
+        // Publish some statistics at 1 Hz.
+        const cluon::data::TimeStamp NOW{cluon::time::now()};
+        if (Player::ONE_SECOND_IN_MICROSECONDS <= cluon::time::deltaInMicroseconds(NOW, lastStatistics)) {
+            uint64_t numberOfReturnedEnvelopesInTotal = 0;
+            uint32_t totalNumberOfEnvelopes           = 0;
+            try {
+                // m_numberOfReturnedEnvelopesInTotal is modified in a different thread.
+                std::lock_guard<std::mutex> lck(m_indexMutex);
+                numberOfReturnedEnvelopesInTotal = m_numberOfReturnedEnvelopesInTotal;
+                totalNumberOfEnvelopes           = static_cast<uint32_t>(m_indexSampleTimeStamps.size());
+            } catch (...) {} // LCOV_EXCL_LINE
+
+            try {
+                std::lock_guard<std::mutex> lck(m_playerListenerMutex);
+                if (nullptr != m_playerListener) {
+                    cluon::data::PlayerStatus ps;
+                    ps.state(2); // State: "playback"
+                    ps.numberOfEntries(totalNumberOfEnvelopes);
+                    ps.currentEntryForPlayback(static_cast<uint32_t>(numberOfReturnedEnvelopesInTotal));
+                    m_playerListener(ps);
+                }
+            } catch (...) {} // LCOV_EXCL_LINE
+
+            lastStatistics = NOW;
+        }
+    }
+}
+
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/Recorder.hpp"
+//#include "cluon/Compression.hpp"
+//#include "cluon/Envelope.hpp"
+//#include "cluon/Player.hpp"
+//#include "cluon/Time.hpp"
+
+// clang-format off
+#ifndef WIN32
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace cluon {
+
+inline Recorder::Recorder(const std::string &file, const bool &chunked) noexcept
+    : m_file(file)
+    , m_chunked(chunked) {
+    m_recFile = std::fopen(m_file.c_str(), "wb"); /* Flawfinder: ignore */
+    if (nullptr != m_recFile) {
+        // Envelopes are already written in large blocks; avoid copying them once more.
+        std::setvbuf(m_recFile, nullptr, _IONBF, 0);
+        try {
+            bool headerWritten{true};
+            if (m_chunked) {
+                std::string header(CHUNKED_REC_FILE_MAGIC, sizeof(CHUNKED_REC_FILE_MAGIC));
+                const uint32_t VERSION{htole32(CHUNKED_REC_FILE_VERSION)};
+                header.append(reinterpret_cast<const char *>(&VERSION), sizeof(uint32_t));
+                header.append(sizeof(uint32_t), '\0');
+                headerWritten = writeBuffer(header.data(), header.size());
+            }
+            if (headerWritten) {
+                m_frontBuffer.reserve(2 * WRITE_SIZE_IN_BYTES);
+                m_backBuffer.reserve(2 * WRITE_SIZE_IN_BYTES);
+                m_running   = true;
+                m_recording = true;
+                m_writer    = std::thread(&Recorder::writeRecFile, this);
+            }
+        } catch (...) { // LCOV_EXCL_LINE
+            m_running   = false; // LCOV_EXCL_LINE
+            m_recording = false; // LCOV_EXCL_LINE
+        }
+    } else {
+        std::clog << "[cluon::Recorder]: " << m_file << " could not be opened." << std::endl;
+    }
+}
+
+inline Recorder::~Recorder() {
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_running = false;
+    }
+    m_bufferReady.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+
+    if (nullptr != m_recFile) {
+        if (m_chunked && m_recording) {
+            // Write the last, incomplete chunk and the table of all chunks.
+            while (m_recording && !m_chunk.empty()) {
+                m_recording = writeChunk();
+            }
+            m_recording = m_recording && writeChunkTable();
+        }
+        sync();
+        std::fclose(m_recFile);
+        m_recFile = nullptr;
+        if (m_recording) {
+            storeIndexFile();
+        }
+        std::clog << "[cluon::Recorder]: Recorded " << m_index.size() << " entries with " << m_bytesWritten << " bytes to " << m_file;
+        if (m_chunked) {
+            std::clog << " in " << m_chunks.size() << " chunks with " << m_recFileSize << " bytes";
+        }
+        std::clog << "." << std::endl;
+    }
+}
+
+inline void Recorder::record(cluon::data::Envelope &&envelope) noexcept {
+    try {
+        const int64_t SAMPLE_TIMESTAMP{cluon::time::toMicroseconds(envelope.sampleTimeStamp())};
+        const int32_t DATATYPE{envelope.dataType()};
+        const uint32_t SENDERSTAMP{envelope.senderStamp()};
+        const std::string DATA{cluon::serializeEnvelope(std::move(envelope))};
+        if (!DATA.empty()) {
+            bool bufferReady{false};
+            {
+                std::lock_guard<std::mutex> lck(m_mutex);
+                if (m_recording) {
+                    m_index.emplace_back(IndexEntry(SAMPLE_TIMESTAMP, m_bytesRecorded, DATATYPE, SENDERSTAMP, static_cast<uint32_t>(DATA.size())));
+                    m_frontBuffer.append(DATA);
+                    m_bytesRecorded += DATA.size();
+                    bufferReady = (WRITE_SIZE_IN_BYTES <= m_frontBuffer.size());
+                }
+            }
+            if (bufferReady) {
+                m_bufferReady.notify_one();
+            }
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline bool Recorder::isRecording() const noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return m_recording;
+}
+
+inline uint64_t Recorder::numberOfEnvelopes() const noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return m_index.size();
+}
+
+inline uint64_t Recorder::bytesWritten() const noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return m_bytesWritten;
+}
+
+inline uint64_t Recorder::backlog() const noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return m_bytesRecorded - m_bytesWritten;
+}
+
+inline float Recorder::writeRate() const noexcept {
+    std::lock_guard<std::mutex> lck(m_mutex);
+    return m_writeRate;
+}
+
+inline void Recorder::writeRecFile() noexcept {
+    try {
+        auto lastWriteRate = std::chrono::steady_clock::now();
+        uint64_t bytesWrittenAtLastWriteRate{0};
+
+        std::unique_lock<std::mutex> lck(m_mutex);
+        while (m_running || !m_frontBuffer.empty()) {
+            // Write at the latest after WRITE_INTERVAL_IN_MILLISECONDS to limit the data at risk.
+            m_bufferReady.wait_for(lck, std::chrono::milliseconds(WRITE_INTERVAL_IN_MILLISECONDS), [this]() {
+                return !m_running || (WRITE_SIZE_IN_BYTES <= m_frontBuffer.size());
+            });
+
+            if (!m_frontBuffer.empty()) {
+                // Continue recording into the other buffer while writing this one.
+                std::swap(m_frontBuffer, m_backBuffer);
+                lck.unlock();
+                bool written{true};
+                if (m_chunked) {
+                    m_chunk.append(m_backBuffer);
+                    while (written && (CHUNK_SIZE_IN_BYTES <= m_chunk.size())) {
+                        written = writeChunk();
+                    }
+                } else {
+                    written = writeBuffer(m_backBuffer.data(), m_backBuffer.size());
+                }
+                const uint64_t SIZE{m_backBuffer.size()};
+                m_backBuffer.clear();
+                if (written && (SYNC_SIZE_IN_BYTES <= m_bytesWritten + SIZE - m_bytesSynced)) {
+                    m_bytesSynced = m_bytesWritten + SIZE;
+                    sync();
+                }
+                lck.lock();
+
+                if (written) {
+                    m_bytesWritten += SIZE;
+                } else if (m_recording) {
+                    std::clog << "[cluon::Recorder]: Failed to write to " << m_file << "; stopped recording." << std::endl;
+                    m_recording = false;
+                    m_frontBuffer.clear();
+                }
+            }
+
+            const auto NOW      = std::chrono::steady_clock::now();
+            const auto DURATION = std::chrono::duration_cast<std::chrono::duration<float>>(NOW - lastWriteRate);
+            if (1.0f <= DURATION.count()) {
+                m_writeRate                 = static_cast<float>(m_bytesWritten - bytesWrittenAtLastWriteRate) / DURATION.count();
+                bytesWrittenAtLastWriteRate = m_bytesWritten;
+                lastWriteRate               = NOW;
+            }
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
 }
 
-inline bool Player::isEnvelopeCacheFillingRunning() const noexcept {
-    std::lock_guard<std::mutex> lck(m_envelopeCacheFillingThreadIsRunningMutex);
-    return m_envelopeCacheFillingThreadIsRunning;
+inline bool Recorder::writeBuffer(const char *data, std::size_t size) noexcept {
+    const bool WRITTEN{size == std::fwrite(data, 1, size, m_recFile)};
+    if (WRITTEN) {
+        m_recFileSize += size;
+    }
+    return WRITTEN;
 }
 
-inline void Player::manageCache() noexcept {
-    uint8_t statisticsCounter = 0;
-    float refillMultiplicator = 1.1f;
-    uint32_t numberOfEntries  = 0;
-
-    while (isEnvelopeCacheFillingRunning()) {
-        try {
-            std::lock_guard<std::mutex> lck(m_indexMutex);
-            numberOfEntries = static_cast<uint32_t>(m_envelopeCache.size());
-        } catch (...) {} // LCOV_EXCL_LINE
-
-        // Check if refilling of the cache is needed.
-        refillMultiplicator = checkRefillingCache(numberOfEntries, refillMultiplicator);
-        (void)refillMultiplicator;
+inline bool Recorder::writeChunk() noexcept {
+    bool retVal{false};
+    try {
+        // Chunks end with complete Envelopes.
+        ChunkEntry chunk;
+        std::size_t length{0};
+        {
+            std::lock_guard<std::mutex> lck(m_mutex);
+            while ((m_nextIndexEntryForChunk < m_index.size()) && (length < CHUNK_SIZE_IN_BYTES)) {
+                const IndexEntry &entry{m_index[m_nextIndexEntryForChunk]};
+                if (length + entry.m_size > m_chunk.size()) {
+                    break;
+                }
+                chunk.m_minSampleTimeStamp = (0 == chunk.m_numberOfEnvelopes) ? entry.m_sampleTimeStamp : (std::min)(chunk.m_minSampleTimeStamp, entry.m_sampleTimeStamp);
+                chunk.m_maxSampleTimeStamp = (0 == chunk.m_numberOfEnvelopes) ? entry.m_sampleTimeStamp : (std::max)(chunk.m_maxSampleTimeStamp, entry.m_sampleTimeStamp);
+                chunk.m_numberOfEnvelopes++;
+                length += entry.m_size;
+                m_nextIndexEntryForChunk++;
+            }
+        }
 
-        // Manage cache at 10 Hz.
-        using namespace std::chrono_literals;
-        std::this_thread::sleep_for(100ms);
+        if (0 < length) {
+            std::string compressed;
+            cluon::compression::compress(m_chunk.data(), length, compressed);
+            // Store chunks as they are if compressing does not save any bytes, e.g., for images.
+            const bool STORED{compressed.size() >= length};
+            chunk.m_compressedSize   = static_cast<uint32_t>(STORED ? length : compressed.size());
+            chunk.m_uncompressedSize = static_cast<uint32_t>(length);
+            chunk.m_filePosition     = m_recFileSize + CHUNKED_REC_FILE_CHUNK_HEADER_SIZE;
+
+            uint32_t header[2]{htole32(chunk.m_compressedSize), htole32(chunk.m_uncompressedSize)};
+            retVal = writeBuffer(reinterpret_cast<const char *>(header), sizeof(header))
+                     && writeBuffer(STORED ? m_chunk.data() : compressed.data(), chunk.m_compressedSize);
+            if (retVal) {
+                m_chunks.push_back(chunk);
+                m_chunk.erase(0, length);
+            }
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
 
-        // Publish some statistics at 1 Hz.
-        if (0 == ((++statisticsCounter) % 10)) {
-            uint64_t numberOfReturnedEnvelopesInTotal = 0;
-            uint32_t totalNumberOfEnvelopes           = 0;
-            try {
-                // m_numberOfReturnedEnvelopesInTotal is modified in a different thread.
-                std::lock_guard<std::mutex> lck(m_indexMutex);
-                numberOfReturnedEnvelopesInTotal = m_numberOfReturnedEnvelopesInTotal;
-                totalNumberOfEnvelopes           = static_cast<uint32_t>(m_index.size());
-            } catch (...) {} // LCOV_EXCL_LINE
+inline bool Recorder::writeChunkTable() noexcept {
+    bool retVal{false};
+    try {
+        std::string table;
+        table.reserve(m_chunks.size() * CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE + CHUNKED_REC_FILE_TRAILER_SIZE);
+        auto appendUInt32 = [&table](uint32_t v) {
+            v = htole32(v);
+            table.append(reinterpret_cast<const char *>(&v), sizeof(uint32_t));
+        };
+        auto appendUInt64 = [&table](uint64_t v) {
+            v = htole64(v);
+            table.append(reinterpret_cast<const char *>(&v), sizeof(uint64_t));
+        };
 
-            try {
-                std::lock_guard<std::mutex> lck(m_playerListenerMutex);
-                if (nullptr != m_playerListener) {
-                    cluon::data::PlayerStatus ps;
-                    ps.state(2); // State: "playback"
-                    ps.numberOfEntries(totalNumberOfEnvelopes);
-                    ps.currentEntryForPlayback(static_cast<uint32_t>(numberOfReturnedEnvelopesInTotal));
-                    m_playerListener(ps);
-                }
-            } catch (...) {} // LCOV_EXCL_LINE
+        const uint64_t POSITION_OF_CHUNK_TABLE{m_recFileSize};
+        for (const auto &chunk : m_chunks) {
+            appendUInt64(chunk.m_filePosition);
+            appendUInt32(chunk.m_compressedSize);
+            appendUInt32(chunk.m_uncompressedSize);
+            appendUInt64(static_cast<uint64_t>(chunk.m_minSampleTimeStamp));
+            appendUInt64(static_cast<uint64_t>(chunk.m_maxSampleTimeStamp));
+            appendUInt32(chunk.m_numberOfEnvelopes);
+            appendUInt32(0);
+        }
+        appendUInt64(static_cast<uint64_t>(m_chunks.size()));
+        appendUInt64(POSITION_OF_CHUNK_TABLE);
+        table.append(CHUNKED_REC_FILE_MAGIC, sizeof(CHUNKED_REC_FILE_MAGIC));
+        retVal = writeBuffer(table.data(), table.size());
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
 
-            statisticsCounter = 0;
-        }
-    }
+inline void Recorder::sync() noexcept {
+#ifndef WIN32
+    const int fd{fileno(m_recFile)};
+#if defined(__linux__)
+    ::fdatasync(fd);
+    // Recorded data is not read again while recording; do not let it crowd out the page cache.
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#else
+    ::fsync(fd);
+#endif
+#endif
 }
 
-inline float Player::checkRefillingCache(const uint32_t &numberOfEntries, float refillMultiplicator) noexcept {
-    // If filling level is around 35%, pour in more from the recording.
-    if (numberOfEntries < 0.35 * m_desiredInitialLevel) {
-        const uint32_t entriesReadFromFile = fillEnvelopeCache(static_cast<uint32_t>(refillMultiplicator * static_cast<float>(m_desiredInitialLevel)));
-        if (entriesReadFromFile > 0) {
-            std::clog << "[cluon::Player]: Number of entries in cache: " << numberOfEntries << ". " << entriesReadFromFile << " added to cache. "
-                      << m_envelopeCache.size() << " entries available." << std::endl;
-            refillMultiplicator *= 1.25f;
+inline void Recorder::storeIndexFile() noexcept {
+#ifndef WIN32
+    try {
+        RecFileFingerprint fingerprint{};
+        if (fingerprintRecFile(m_file, fingerprint)) {
+            // cluon::Player expects the entries in chronological order; keep the recorded order for equal sample time stamps.
+            std::stable_sort(m_index.begin(), m_index.end(), [](const IndexEntry &a, const IndexEntry &b) {
+                return a.m_sampleTimeStamp < b.m_sampleTimeStamp;
+            });
+            const std::string INDEX_FILE{m_file + ".idx"};
+            auto entry = [this](std::size_t i) { return m_index[i]; };
+            if (storeIndexEntries(INDEX_FILE, fingerprint, m_index.size(), entry)) {
+                std::clog << "[cluon::Recorder]: Stored index in " << INDEX_FILE << "." << std::endl;
+            }
         }
-    }
-    return refillMultiplicator;
+    } catch (...) {} // LCOV_EXCL_LINE
+#endif
 }
 
 } // namespace cluon
@@ -15801,49 +20258,493 @@ inline void SharedMemory::waitSysV() noexcept {
     }
 }
 
-inline void SharedMemory::notifyAllSysV() noexcept {
-    if (-1 != m_conditionIDSysV) {
-        {
-            constexpr int NUMBER_OF_SEMAPHORE_TO_CONTROL{0};
-            constexpr int WAKEUP_VALUE{0};
-
-            union semun tmp;
-            tmp.val = WAKEUP_VALUE;
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#pragma GCC diagnostic ignored "-Wclass-varargs"
-#endif
-            if (-1 == ::semctl(m_conditionIDSysV, NUMBER_OF_SEMAPHORE_TO_CONTROL, SETVAL, tmp)) {
-                std::cerr << "[cluon::SharedMemory (SysV)] Failed to notify semaphore (0x" << std::hex << m_conditionKeySysV << std::dec
-                          << ", intended to use as condition variable): " << ::strerror(errno) << " (" << errno << ")" << std::endl;
-                m_broken.store(true);
+inline void SharedMemory::notifyAllSysV() noexcept {
+    if (-1 != m_conditionIDSysV) {
+        {
+            constexpr int NUMBER_OF_SEMAPHORE_TO_CONTROL{0};
+            constexpr int WAKEUP_VALUE{0};
+
+            union semun tmp;
+            tmp.val = WAKEUP_VALUE;
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma GCC diagnostic ignored "-Wclass-varargs"
+#endif
+            if (-1 == ::semctl(m_conditionIDSysV, NUMBER_OF_SEMAPHORE_TO_CONTROL, SETVAL, tmp)) {
+                std::cerr << "[cluon::SharedMemory (SysV)] Failed to notify semaphore (0x" << std::hex << m_conditionKeySysV << std::dec
+                          << ", intended to use as condition variable): " << ::strerror(errno) << " (" << errno << ")" << std::endl;
+                m_broken.store(true);
+            }
+#pragma GCC diagnostic pop
+        }
+        {
+            constexpr int NUMBER_OF_SEMAPHORE_TO_CONTROL{0};
+            constexpr int SLEEPING_VALUE{1};
+
+            union semun tmp;
+            tmp.val = SLEEPING_VALUE;
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma GCC diagnostic ignored "-Wclass-varargs"
+#endif
+            if (-1 == ::semctl(m_conditionIDSysV, NUMBER_OF_SEMAPHORE_TO_CONTROL, SETVAL, tmp)) {
+                std::cerr << "[cluon::SharedMemory (SysV)] Failed to reset semaphore for notification (0x" << std::hex << m_conditionKeySysV << std::dec
+                          << ", intended to use as condition variable): " << ::strerror(errno) << " (" << errno << ")" << std::endl;
+                m_broken.store(true);
+            }
+#pragma GCC diagnostic pop
+        }
+    }
+}
+
+inline bool SharedMemory::validSysV() noexcept {
+    return (-1 != m_sharedMemoryIDSysV) && (nullptr != m_sharedMemory) && (0 < m_size) && (-1 != m_mutexIDSysV) && (-1 != m_conditionIDSysV);
+}
+#endif
+
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/SharedMemoryRing.hpp"
+//#include "cluon/SharedMemory.hpp"
+
+// clang-format off
+#ifndef WIN32
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <sys/file.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+        #include <time.h>
+    #endif
+#endif
+// clang-format on
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace cluon {
+
+/**
+ * The shared memory area starts with a Header followed by the entries. Every
+ * entry is stored as SIZE (uint32) RESERVED (uint32) PRODUCER (uint64)
+ * followed by its payload padded to 8 bytes. Positions are monotonically
+ * increasing byte counters and an entry resides at position % capacity.
+ *
+ * A producer announces the range it is going to overwrite in reservedPosition
+ * before copying the entry and publishes the entry in writePosition afterwards.
+ * Consumers copy an entry and verify with reservedPosition afterwards that it
+ * was not overwritten in the meantime.
+ *
+ * The announced identifiers are stored in participants as PID << 32 | identifier;
+ * entries of processes that have gone are reused.
+ */
+struct SharedMemoryRing::Segment {
+    enum : uint32_t { MAGIC = 0x0D4A0002, ENTRY_HEADER_SIZE = 16, MAX_PARTICIPANTS = 64 };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t capacity;
+        std::atomic<uint32_t> closed;
+        std::atomic<uint32_t> waitingConsumers;
+        std::atomic<uint32_t> notification;
+        uint32_t reserved;
+        std::atomic<uint64_t> reservedPosition;
+        std::atomic<uint64_t> writePosition;
+        std::atomic<uint64_t> participants[MAX_PARTICIPANTS];
+    };
+
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "std::atomic<uint64_t> must be lock-free to reside in shared memory.");
+
+    std::unique_ptr<cluon::SharedMemory> m_sharedMemory{nullptr};
+    Header *m_header{nullptr};
+    char *m_entries{nullptr};
+    uint32_t m_capacity{0};
+    bool m_isCreator{false};
+    // Position of the first entry to be read by the attaching SharedMemoryRing.
+    uint64_t m_attachPosition{0};
+
+    bool attach() noexcept {
+        bool retVal{false};
+        if (m_sharedMemory->valid() && (sizeof(Header) < m_sharedMemory->size())) {
+            Header *header{reinterpret_cast<Header *>(m_sharedMemory->data())};
+            retVal = (MAGIC == header->magic) && (0 == header->closed.load()) && (sizeof(Header) + header->capacity <= m_sharedMemory->size());
+            if (retVal) {
+                m_header         = header;
+                m_entries        = m_sharedMemory->data() + sizeof(Header);
+                m_capacity       = header->capacity;
+                m_attachPosition = header->writePosition.load(std::memory_order_acquire);
+            }
+        }
+        return retVal;
+    }
+
+    bool create(uint32_t capacity) noexcept {
+        bool retVal{m_sharedMemory->valid() && (sizeof(Header) + capacity <= m_sharedMemory->size())};
+        if (retVal) {
+            m_header = new (m_sharedMemory->data()) Header;
+            m_header->capacity = capacity;
+            m_header->closed.store(0);
+            m_header->waitingConsumers.store(0);
+            m_header->notification.store(0);
+            m_header->reservedPosition.store(0);
+            m_header->writePosition.store(0);
+            for (auto &participant : m_header->participants) {
+                participant.store(0);
+            }
+            m_header->magic = MAGIC;
+            m_entries       = m_sharedMemory->data() + sizeof(Header);
+            m_capacity      = capacity;
+            m_isCreator     = true;
+        }
+        return retVal;
+    }
+
+    void copyTo(uint64_t position, const char *src, std::size_t size) noexcept {
+        const std::size_t OFFSET{static_cast<std::size_t>(position % m_capacity)};
+        const std::size_t FIRST{std::min(size, m_capacity - OFFSET)};
+        std::memcpy(m_entries + OFFSET, src, FIRST);
+        std::memcpy(m_entries, src + FIRST, size - FIRST);
+    }
+
+    void copyFrom(uint64_t position, char *dst, std::size_t size) noexcept {
+        const std::size_t OFFSET{static_cast<std::size_t>(position % m_capacity)};
+        const std::size_t FIRST{std::min(size, m_capacity - OFFSET)};
+        std::memcpy(dst, m_entries + OFFSET, FIRST);
+        std::memcpy(dst + FIRST, m_entries, size - FIRST);
+    }
+
+    bool addParticipant(uint64_t participant) noexcept {
+        bool retVal{false};
+        m_sharedMemory->lock();
+        for (auto &p : m_header->participants) {
+            uint64_t value{p.load()};
+#ifndef WIN32
+            if ((0 != value) && (0 != ::kill(static_cast<pid_t>(value >> 32), 0)) && (ESRCH == errno)) {
+                p.store(0);
+                value = 0;
+            }
+#endif
+            if (!retVal && (0 == value)) {
+                p.store(participant);
+                retVal = true;
+            }
+        }
+        m_sharedMemory->unlock();
+        return retVal;
+    }
+
+    void removeParticipant(uint64_t participant) noexcept {
+        for (auto &p : m_header->participants) {
+            uint64_t expected{participant};
+            p.compare_exchange_strong(expected, 0);
+        }
+    }
+
+    bool hasParticipant(uint32_t identifier) const noexcept {
+        for (const auto &p : m_header->participants) {
+            const uint64_t VALUE{p.load(std::memory_order_relaxed)};
+            if ((0 != VALUE) && (identifier == static_cast<uint32_t>(VALUE))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void notifyAll() noexcept {
+        m_header->notification.fetch_add(1);
+        if (0 < m_header->waitingConsumers.load()) {
+#ifdef __linux__
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->notification)), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+        }
+    }
+
+    void wait(uint32_t notification, std::chrono::microseconds timeout) noexcept {
+#ifdef __linux__
+        struct timespec ts;
+        ts.tv_sec  = static_cast<time_t>(timeout.count() / 1000000);
+        ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->notification)), FUTEX_WAIT, notification, &ts, nullptr, 0);
+#else
+        // Without futexes, poll in short intervals.
+        (void)notification;
+        std::this_thread::sleep_for(std::min(timeout, std::chrono::microseconds(100)));
+#endif
+    }
+};
+
+inline SharedMemoryRing::SharedMemoryRing(const std::string &name, uint32_t capacity) noexcept
+    : m_name{name}
+    , m_capacity{std::max(capacity, static_cast<uint32_t>(4096)) & ~static_cast<uint32_t>(7)}
+    , m_producerID{0} {
+    static std::atomic<uint32_t> numberOfInstances{0};
+#ifndef WIN32
+    m_producerID = (static_cast<uint64_t>(::getpid()) << 32) | numberOfInstances++;
+#endif
+    try {
+        std::lock_guard<std::mutex> lck(m_segmentMutex);
+        m_segment = attachOrCreate();
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline SharedMemoryRing::~SharedMemoryRing() noexcept {
+    try {
+        std::lock_guard<std::mutex> lck(m_segmentMutex);
+        if ((nullptr != m_segment) && (0 != m_participant)) {
+            m_segment->removeParticipant(m_participant);
+        }
+        if ((nullptr != m_segment) && m_segment->m_isCreator) {
+            // Let the attached SharedMemoryRings move on to a new shared
+            // memory area before this one is removed.
+            const int32_t fd{lockName()};
+            m_segment->m_header->closed.store(1);
+            m_segment->notifyAll();
+            m_readSegment.reset();
+            m_segment.reset();
+            unlockName(fd);
+        }
+        m_readSegment.reset();
+        m_segment.reset();
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline bool SharedMemoryRing::valid() noexcept {
+    return (nullptr != segment());
+}
+
+inline std::size_t SharedMemoryRing::maxEntrySize() noexcept {
+    auto s{segment()};
+    return (nullptr != s) ? (s->m_capacity / 2 - Segment::ENTRY_HEADER_SIZE) : 0;
+}
+
+inline uint64_t SharedMemoryRing::numberOfOverruns() const noexcept {
+    return m_numberOfOverruns.load();
+}
+
+inline bool SharedMemoryRing::addParticipant(uint32_t identifier) noexcept {
+    bool retVal{false};
+    try {
+        std::lock_guard<std::mutex> lck(m_segmentMutex);
+        if ((nullptr != m_segment) && (0 != m_participant)) {
+            m_segment->removeParticipant(m_participant);
+        }
+#ifndef WIN32
+        m_participant = (static_cast<uint64_t>(::getpid()) << 32) | identifier;
+#endif
+        retVal = (nullptr != m_segment) && (0 != m_participant) && m_segment->addParticipant(m_participant);
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline bool SharedMemoryRing::hasParticipant(uint32_t identifier) noexcept {
+    auto s{segment()};
+    return (nullptr != s) && s->hasParticipant(identifier);
+}
+
+inline uint32_t SharedMemoryRing::capacityFor(uint32_t maxEntrySize) noexcept {
+    // Entries may take at most half of the capacity.
+    return 2 * (Segment::ENTRY_HEADER_SIZE + ((maxEntrySize + 7) & ~static_cast<uint32_t>(7)));
+}
+
+inline void SharedMemoryRing::notifyAll() noexcept {
+    auto s{segment()};
+    if (nullptr != s) {
+        s->notifyAll();
+    }
+}
+
+inline bool SharedMemoryRing::write(const char *data, std::size_t size) noexcept {
+    bool retVal{false};
+    auto s{segment()};
+    if ((nullptr != s) && (0 != s->m_header->closed.load())) {
+        s = reconnect(s);
+    }
+    if ((nullptr != s) && (nullptr != data) && (size <= (s->m_capacity / 2 - Segment::ENTRY_HEADER_SIZE))) {
+        const uint64_t LENGTH{Segment::ENTRY_HEADER_SIZE + ((static_cast<uint64_t>(size) + 7) & ~static_cast<uint64_t>(7))};
+
+        char entryHeader[Segment::ENTRY_HEADER_SIZE]{};
+        const uint32_t SIZE{static_cast<uint32_t>(size)};
+        std::memcpy(entryHeader, &SIZE, sizeof(uint32_t));
+        std::memcpy(entryHeader + 8, &m_producerID, sizeof(uint64_t));
+
+        s->m_sharedMemory->lock();
+        {
+            const uint64_t POSITION{s->m_header->writePosition.load(std::memory_order_relaxed)};
+            s->m_header->reservedPosition.store(POSITION + LENGTH, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            s->copyTo(POSITION, entryHeader, Segment::ENTRY_HEADER_SIZE);
+            s->copyTo(POSITION + Segment::ENTRY_HEADER_SIZE, data, size);
+            s->m_header->writePosition.store(POSITION + LENGTH, std::memory_order_release);
+        }
+        s->m_sharedMemory->unlock();
+        s->notifyAll();
+        retVal = true;
+    }
+    return retVal;
+}
+
+inline std::size_t SharedMemoryRing::read(std::function<void(std::string &&entry)> delegate, std::chrono::milliseconds timeout) noexcept {
+    std::size_t retVal{0};
+    auto s{segment()};
+    if ((nullptr != s) && (0 != s->m_header->closed.load())) {
+        s = reconnect(s);
+    }
+    if (nullptr == s) {
+        std::this_thread::sleep_for(timeout);
+        return retVal;
+    }
+    if (s != m_readSegment) {
+        // Deliver all entries written since attaching, including the ones
+        // written before this method was called for the first time.
+        m_readSegment  = s;
+        m_readPosition = s->m_attachPosition;
+    }
+
+    Segment::Header *header{s->m_header};
+    uint64_t writePosition{header->writePosition.load(std::memory_order_acquire)};
+    {
+        // Spin shortly before sleeping to keep the latency low for frequent entries.
+        const auto NOW{std::chrono::steady_clock::now()};
+        const auto SPIN_UNTIL{NOW + std::chrono::microseconds(20)};
+        const auto WAIT_UNTIL{NOW + timeout};
+        while ((writePosition == m_readPosition) && (0 == header->closed.load())) {
+            const auto now{std::chrono::steady_clock::now()};
+            if (now >= WAIT_UNTIL) {
+                break;
+            }
+            if (now >= SPIN_UNTIL) {
+                header->waitingConsumers.fetch_add(1);
+                const uint32_t NOTIFICATION{header->notification.load()};
+                if ((header->writePosition.load() == m_readPosition) && (0 == header->closed.load())) {
+                    s->wait(NOTIFICATION, std::chrono::duration_cast<std::chrono::microseconds>(WAIT_UNTIL - now));
+                }
+                header->waitingConsumers.fetch_sub(1);
+            }
+            writePosition = header->writePosition.load(std::memory_order_acquire);
+        }
+    }
+
+    while (m_readPosition != writePosition) {
+        bool overrun{(s->m_capacity < writePosition - m_readPosition)};
+        if (!overrun) {
+            char entryHeader[Segment::ENTRY_HEADER_SIZE];
+            s->copyFrom(m_readPosition, entryHeader, Segment::ENTRY_HEADER_SIZE);
+            uint32_t size{0};
+            uint64_t producerID{0};
+            std::memcpy(&size, entryHeader, sizeof(uint32_t));
+            std::memcpy(&producerID, entryHeader + 8, sizeof(uint64_t));
+
+            std::string entry;
+            overrun = (s->m_capacity / 2 < size);
+            if (!overrun && (producerID != m_producerID)) {
+                try {
+                    entry.resize(size);
+                    s->copyFrom(m_readPosition + Segment::ENTRY_HEADER_SIZE, &entry[0], size);
+                } catch (...) { // LCOV_EXCL_LINE
+                    overrun = true; // LCOV_EXCL_LINE
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            overrun = overrun || (s->m_capacity < header->reservedPosition.load(std::memory_order_relaxed) - m_readPosition);
+
+            if (!overrun) {
+                m_readPosition += Segment::ENTRY_HEADER_SIZE + ((static_cast<uint64_t>(size) + 7) & ~static_cast<uint64_t>(7));
+                if ((producerID != m_producerID) && (nullptr != delegate)) {
+                    try {
+                        delegate(std::move(entry));
+                    } catch (...) {} // LCOV_EXCL_LINE
+                    retVal++;
+                }
+            }
+        }
+        if (overrun) {
+            // The producers have overwritten entries that were not read yet; continue with the latest entry.
+            m_numberOfOverruns++;
+            m_readPosition = header->writePosition.load(std::memory_order_acquire);
+            break;
+        }
+    }
+    return retVal;
+}
+
+inline std::shared_ptr<SharedMemoryRing::Segment> SharedMemoryRing::segment() noexcept {
+    std::lock_guard<std::mutex> lck(m_segmentMutex);
+    return m_segment;
+}
+
+inline std::shared_ptr<SharedMemoryRing::Segment> SharedMemoryRing::reconnect(const std::shared_ptr<Segment> &closedSegment) noexcept {
+    std::lock_guard<std::mutex> lck(m_segmentMutex);
+    if (closedSegment == m_segment) {
+        m_segment = attachOrCreate();
+        if ((nullptr != m_segment) && (0 != m_participant)) {
+            m_segment->addParticipant(m_participant);
+        }
+    }
+    return m_segment;
+}
+
+inline std::shared_ptr<SharedMemoryRing::Segment> SharedMemoryRing::attachOrCreate() noexcept {
+    std::shared_ptr<Segment> retVal{nullptr};
+#ifndef WIN32
+    // Creating a shared memory area replaces an existing one; thus, attaching
+    // and creating is serialized among all processes.
+    const int32_t fd{lockName()};
+    try {
+        auto s{std::make_shared<Segment>()};
+        s->m_sharedMemory = std::make_unique<cluon::SharedMemory>(m_name);
+        if (!s->attach()) {
+            s->m_sharedMemory.reset();
+            s->m_sharedMemory = std::make_unique<cluon::SharedMemory>(m_name, static_cast<uint32_t>(sizeof(Segment::Header)) + m_capacity);
+            if (!s->create(m_capacity)) {
+                s.reset();
             }
-#pragma GCC diagnostic pop
         }
-        {
-            constexpr int NUMBER_OF_SEMAPHORE_TO_CONTROL{0};
-            constexpr int SLEEPING_VALUE{1};
-
-            union semun tmp;
-            tmp.val = SLEEPING_VALUE;
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#pragma GCC diagnostic ignored "-Wclass-varargs"
+        retVal = s;
+    } catch (...) {} // LCOV_EXCL_LINE
+    unlockName(fd);
 #endif
-            if (-1 == ::semctl(m_conditionIDSysV, NUMBER_OF_SEMAPHORE_TO_CONTROL, SETVAL, tmp)) {
-                std::cerr << "[cluon::SharedMemory (SysV)] Failed to reset semaphore for notification (0x" << std::hex << m_conditionKeySysV << std::dec
-                          << ", intended to use as condition variable): " << ::strerror(errno) << " (" << errno << ")" << std::endl;
-                m_broken.store(true);
-            }
-#pragma GCC diagnostic pop
-        }
-    }
+    return retVal;
 }
 
-inline bool SharedMemory::validSysV() noexcept {
-    return (-1 != m_sharedMemoryIDSysV) && (nullptr != m_sharedMemory) && (0 < m_size) && (-1 != m_mutexIDSysV) && (-1 != m_conditionIDSysV);
+inline int32_t SharedMemoryRing::lockName() noexcept {
+    int32_t fd{-1};
+#ifndef WIN32
+    std::string lockFile{m_name};
+    std::replace(lockFile.begin(), lockFile.end(), '/', '_');
+    lockFile = "/tmp/" + lockFile + ".lock";
+    fd = ::open(lockFile.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if ((-1 != fd) && (0 != ::flock(fd, LOCK_EX))) {
+        std::cerr << "[cluon::SharedMemoryRing] Failed to lock '" << lockFile << "': " << ::strerror(errno) << " (" << errno << ")" << std::endl; // LCOV_EXCL_LINE
+    }
+#endif
+    return fd;
 }
+
+inline void SharedMemoryRing::unlockName(int32_t fd) noexcept {
+#ifndef WIN32
+    if (-1 != fd) {
+        ::flock(fd, LOCK_UN);
+        ::close(fd);
+    }
+#else
+    (void)fd;
 #endif
+}
 
 } // namespace cluon
 #endif
@@ -17146,6 +22047,7 @@ class LIBCLUON_API MetaMessageToProtoTransformator {
 
 //#include "cluon/MetaMessageToCPPTransformator.hpp"
 //#include "cluon/MetaMessage.hpp"
+//#include "cluon/ProtoConstants.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -17235,6 +22137,37 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_CODEC_TYPE_TRAIT
+#define PROTO_CODEC_TYPE_TRAIT
+// Types providing encodeProto/decodeProto are (de)serialized without visiting each field by name.
+template<typename T>
+struct isProtoCodec {
+    static const bool value = false;
+};
+#endif
+
+#ifndef SHARED_BYTES_TYPE
+#define SHARED_BYTES_TYPE
+#include <memory>
+#include <string>
+
+// Fields of type bytes are held in a buffer that is shared between copies of a
+// message; a shared buffer is never modified but copied before being modified.
+inline const std::string &emptySharedBytes() noexcept {
+    static const std::string EMPTY;
+    return EMPTY;
+}
+
+inline std::string &mutableSharedBytes(std::shared_ptr<std::string> &v) noexcept {
+    if (!v) {
+        v = std::make_shared<std::string>();
+    } else if (1 < v.use_count()) {
+        v = std::make_shared<std::string>(*v);
+    }
+    return *v;
+}
+#endif
+
 
 #ifndef {{%HEADER_GUARD%}}_HPP
 #define {{%HEADER_GUARD%}}_HPP
@@ -17256,6 +22189,7 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <memory>
 #include <string>
 #include <utility>
 {{%NAMESPACE_OPENING%}}
@@ -17286,6 +22220,7 @@ class LIB_API {{%MESSAGE%}} {
 
     public:
         {{#%FIELDS%}}
+        {{^%IS_SHARED_BYTES%}}
         inline {{%MESSAGE%}}& {{%NAME%}}(const {{%TYPE%}} &v) noexcept {
             m_{{%NAME%}} = v;
             return *this;
@@ -17293,6 +22228,26 @@ class LIB_API {{%MESSAGE%}} {
         inline {{%TYPE%}} {{%NAME%}}() const noexcept {
             return m_{{%NAME%}};
         }
+        {{/%IS_SHARED_BYTES%}}{{#%IS_SHARED_BYTES%}}
+        inline {{%MESSAGE%}}& {{%NAME%}}(const std::string &v) noexcept {
+            m_{{%NAME%}} = std::make_shared<std::string>(v);
+            return *this;
+        }
+        inline {{%MESSAGE%}}& {{%NAME%}}(std::string &&v) noexcept {
+            m_{{%NAME%}} = std::make_shared<std::string>(std::move(v));
+            return *this;
+        }
+        inline {{%MESSAGE%}}& {{%NAME%}}(const std::shared_ptr<const std::string> &v) noexcept {
+            m_{{%NAME%}} = std::const_pointer_cast<std::string>(v); // NOLINT: Shared buffers are copied by mutableSharedBytes before being modified.
+            return *this;
+        }
+        inline const std::string &{{%NAME%}}() const noexcept {
+            return (m_{{%NAME%}} ? *m_{{%NAME%}} : emptySharedBytes());
+        }
+        inline std::shared_ptr<const std::string> {{%SHARED_NAME%}}() const noexcept {
+            return m_{{%NAME%}};
+        }
+        {{/%IS_SHARED_BYTES%}}
         {{/%FIELDS%}}
 
     public:
@@ -17303,7 +22258,7 @@ class LIB_API {{%MESSAGE%}} {
 //            visitor.preVisit(ID(), ShortName(), LongName());
             {{#%FIELDS%}}
             if ({{%FIELDIDENTIFIER%}} == fieldId) {
-                doVisit({{%FIELDIDENTIFIER%}}, std::move("{{%TYPE%}}"s), std::move("{{%NAME%}}"s), m_{{%NAME%}}, visitor);
+                doVisit({{%FIELDIDENTIFIER%}}, std::move("{{%TYPE%}}"s), std::move("{{%NAME%}}"s), {{%MEMBER%}}, visitor);
                 return;
             }
             {{/%FIELDS%}}
@@ -17314,7 +22269,7 @@ class LIB_API {{%MESSAGE%}} {
         inline void accept(Visitor &visitor) {
             visitor.preVisit(ID(), ShortName(), LongName());
             {{#%FIELDS%}}
-            doVisit({{%FIELDIDENTIFIER%}}, std::move("{{%TYPE%}}"s), std::move("{{%NAME%}}"s), m_{{%NAME%}}, visitor);
+            doVisit({{%FIELDIDENTIFIER%}}, std::move("{{%TYPE%}}"s), std::move("{{%NAME%}}"s), {{%MEMBER%}}, visitor);
             {{/%FIELDS%}}
             visitor.postVisit();
         }
@@ -17324,14 +22279,36 @@ class LIB_API {{%MESSAGE%}} {
             (void)visit; // Prevent warnings from empty messages.
             std::forward<PreVisitor>(preVisit)(ID(), ShortName(), LongName());
             {{#%FIELDS%}}
-            doTripletForwardVisit({{%FIELDIDENTIFIER%}}, std::move("{{%TYPE%}}"s), std::move("{{%NAME%}}"s), m_{{%NAME%}}, preVisit, visit, postVisit);
+            doTripletForwardVisit({{%FIELDIDENTIFIER%}}, std::move("{{%TYPE%}}"s), std::move("{{%NAME%}}"s), {{%MEMBER%}}, preVisit, visit, postVisit);
             {{/%FIELDS%}}
             std::forward<PostVisitor>(postVisit)();
         }
 
+    public:
+        // Proto tags are (field identifier << 3) | wire type.
+        template<class ProtoEncoder>
+        inline void encodeProto(ProtoEncoder &encoder) const {
+            (void)encoder; // Prevent warnings from empty messages.
+            {{#%FIELDS%}}
+            encoder.encodeField({{%PROTO_TAG%}}u, {{%VALUE%}});
+            {{/%FIELDS%}}
+        }
+
+        template<class ProtoDecoder>
+        inline void decodeProto(ProtoDecoder &decoder) {
+            while (decoder.nextField()) {
+                switch (decoder.fieldTag()) {
+                    {{#%FIELDS%}}
+                    case {{%PROTO_TAG%}}u: decoder.decodeField({{%MEMBER%}}); break;
+                    {{/%FIELDS%}}
+                    default: break;
+                }
+            }
+        }
+
     private:
         {{#%FIELDS%}}
-        {{%TYPE%}} m_{{%NAME%}}{ {{%FIELD_DEFAULT_INITIALIZATION_VALUE%}}{{%INITIALIZER_SUFFIX%}} }; // field identifier = {{%FIELDIDENTIFIER%}}.
+        {{%MEMBER_TYPE%}} m_{{%NAME%}}{ {{%FIELD_DEFAULT_INITIALIZATION_VALUE%}}{{%INITIALIZER_SUFFIX%}} }; // field identifier = {{%FIELDIDENTIFIER%}}.
         {{/%FIELDS%}}
 };
 {{%NAMESPACE_CLOSING%}}
@@ -17344,6 +22321,10 @@ template<>
 struct isTripletForwardVisitable<{{%COMPLETEPACKAGENAME_WITH_COLON_SEPARATORS%}}{{%MESSAGE%}}> {
     static const bool value = true;
 };
+template<>
+struct isProtoCodec<{{%COMPLETEPACKAGENAME_WITH_COLON_SEPARATORS%}}{{%MESSAGE%}}> {
+    static const bool value = true;
+};
 #endif
 )";
 
@@ -17398,6 +22379,14 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
             {MetaMessage::MetaField::BYTES_T, R"("")"},
         };
 
+        std::map<MetaMessage::MetaField::MetaFieldDataTypes, ProtoConstants> typeToProtoWireTypeMap = {
+            {MetaMessage::MetaField::FLOAT_T, ProtoConstants::FOUR_BYTES},
+            {MetaMessage::MetaField::DOUBLE_T, ProtoConstants::EIGHT_BYTES},
+            {MetaMessage::MetaField::STRING_T, ProtoConstants::LENGTH_DELIMITED},
+            {MetaMessage::MetaField::BYTES_T, ProtoConstants::LENGTH_DELIMITED},
+            {MetaMessage::MetaField::MESSAGE_T, ProtoConstants::LENGTH_DELIMITED},
+        };
+
         std::string namespacePrefix;
         std::string messageName{mm.messageName()};
         const auto pos = mm.messageName().find_last_of('.');
@@ -17428,8 +22417,26 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
             std::string fieldName{std::regex_replace(e.fieldName(), std::regex("\\."), "_")}; // NOLINT
             kainjow::mustache::data fieldEntry;
             fieldEntry.set("%NAME%", fieldName);
-            if (MetaMessage::MetaField::MESSAGE_T != e.fieldDataType()) {
+            fieldEntry.set("%MEMBER%", "m_" + fieldName);
+            fieldEntry.set("%VALUE%", "m_" + fieldName);
+            fieldEntry.set("%IS_SHARED_BYTES%", false);
+            if (MetaMessage::MetaField::BYTES_T == e.fieldDataType()) {
+                // Payloads of type bytes are shared between copies of a message.
+                std::string sharedName{fieldName};
+                sharedName[0] = static_cast<char>(::toupper(static_cast<unsigned char>(sharedName[0])));
                 fieldEntry.set("%TYPE%", typeToTypeStringMap[e.fieldDataType()]);
+                fieldEntry.set("%MEMBER_TYPE%", "std::shared_ptr<std::string>");
+                fieldEntry.set("%MEMBER%", "mutableSharedBytes(m_" + fieldName + ")");
+                fieldEntry.set("%VALUE%", fieldName + "()");
+                fieldEntry.set("%IS_SHARED_BYTES%", true);
+                fieldEntry.set("%SHARED_NAME%", "shared" + sharedName);
+                // An empty buffer is not allocated.
+                if (!e.defaultInitializationValue().empty() && (R"("")" != e.defaultInitializationValue())) {
+                    fieldEntry.set("%FIELD_DEFAULT_INITIALIZATION_VALUE%", "std::make_shared<std::string>(" + e.defaultInitializationValue() + "s)");
+                }
+            } else if (MetaMessage::MetaField::MESSAGE_T != e.fieldDataType()) {
+                fieldEntry.set("%TYPE%", typeToTypeStringMap[e.fieldDataType()]);
+                fieldEntry.set("%MEMBER_TYPE%", typeToTypeStringMap[e.fieldDataType()]);
 
                 const std::string defaultInitializatioValue{
                     (e.defaultInitializationValue().empty() ? typeToDefaultInitizationValueMap[e.fieldDataType()] : e.defaultInitializationValue())};
@@ -17438,7 +22445,7 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
                 std::string initializerSuffix;
                 if (e.fieldDataType() == MetaMessage::MetaField::FLOAT_T) {
                     initializerSuffix = "f"; // suffix for float types.
-                } else if (e.fieldDataType() == MetaMessage::MetaField::STRING_T || e.fieldDataType() == MetaMessage::MetaField::BYTES_T) {
+                } else if (e.fieldDataType() == MetaMessage::MetaField::STRING_T) {
                     initializerSuffix = "s"; // suffix to enforce std::string initialization.
                 }
                 fieldEntry.set("%INITIALIZER_SUFFIX%", initializerSuffix);
@@ -17447,9 +22454,16 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
                 const std::string completeDataTypeNameWithDoubleColons{std::regex_replace(tmp, std::regex("\\."), "::")}; // NOLINT
 
                 fieldEntry.set("%TYPE%", completeDataTypeNameWithDoubleColons);
+                fieldEntry.set("%MEMBER_TYPE%", completeDataTypeNameWithDoubleColons);
             }
             fieldEntry.set("%FIELDIDENTIFIER%", std::to_string(e.fieldIdentifier()));
 
+            // All other types are encoded as VarInt.
+            const ProtoConstants wireType{(0 < typeToProtoWireTypeMap.count(e.fieldDataType())) ? typeToProtoWireTypeMap[e.fieldDataType()]
+                                                                                               : ProtoConstants::VARINT};
+            const uint64_t protoTag{(static_cast<uint64_t>(e.fieldIdentifier()) << 3) | static_cast<uint8_t>(wireType)};
+            fieldEntry.set("%PROTO_TAG%", std::to_string(protoTag));
+
             fields.push_back(fieldEntry);
         }
     } catch (std::regex_error &) { // LCOV_EXCL_LINE
@@ -17608,11 +22622,13 @@ inline int32_t cluon_msc(int32_t argc, char **argv) {
     if (std::string::npos != inputFilename.find(PROGRAM)) {
         std::cerr << PROGRAM
                   << " transforms a given message specification file in .odvd format into C++." << std::endl;
-        std::cerr << "Usage:   " << PROGRAM << " [--cpp] [--proto] [--out=<file>] <odvd file>" << std::endl;
-        std::cerr << "         " << PROGRAM << " --cpp:   Generate C++14-compliant, self-contained header file." << std::endl;
-        std::cerr << "         " << PROGRAM << " --proto: Generate Proto version2-compliant file." << std::endl;
+        std::cerr << "Usage:   " << PROGRAM << " [--cpp] [--proto] [--binary] [--out=<file>] <odvd file>" << std::endl;
+        std::cerr << "         " << PROGRAM << " --cpp:    Generate C++14-compliant, self-contained header file." << std::endl;
+        std::cerr << "         " << PROGRAM << " --proto:  Generate Proto version2-compliant file." << std::endl;
+        std::cerr << "         " << PROGRAM << " --binary: Generate compiled message specification to be loaded by tools without parsing." << std::endl;
         std::cerr << std::endl;
         std::cerr << "Example: " << PROGRAM << " --cpp --out=/tmp/myOutput.hpp myFile.odvd" << std::endl;
+        std::cerr << "         " << PROGRAM << " --binary --out=/tmp/myFile.odvdc myFile.odvd" << std::endl;
         return 1;
     }
 
@@ -17621,6 +22637,7 @@ inline int32_t cluon_msc(int32_t argc, char **argv) {
 
     const bool generateCPP = commandline[{"--cpp"}];
     const bool generateProto = commandline[{"--proto"}];
+    const bool generateBinary = commandline[{"--binary"}];
 
     int retVal = 1;
     std::ifstream inputFile(inputFilename, std::ios::in);
@@ -17637,27 +22654,42 @@ inline int32_t cluon_msc(int32_t argc, char **argv) {
             std::ofstream outputFile(outputFilename, std::ios::out | std::ios::trunc);
             outputFile.close();
         }
-        for (auto e : result.first) {
-            std::string content;
-            if (generateCPP) {
-                cluon::MetaMessageToCPPTransformator transformation;
-                e.accept([&trans = transformation](const cluon::MetaMessage &_mm){ trans.visit(_mm); });
-                content = transformation.content();
-            }
-            if (generateProto) {
-                cluon::MetaMessageToProtoTransformator transformation;
-                e.accept([&trans = transformation](const cluon::MetaMessage &_mm){ trans.visit(_mm); });
-                content = transformation.content(addHeaderForFirstProtoFile);
-                addHeaderForFirstProtoFile = false;
+        if (generateBinary) {
+            if (cluon::MessageParser::MessageParserErrorCodes::NO_MESSAGEPARSER_ERROR == result.second) {
+                const std::string content{cluon::MessageParser::compile(result.first)};
+                if (!outputFilename.empty()) {
+                    std::ofstream outputFile(outputFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+                    outputFile.write(content.data(), static_cast<std::streamsize>(content.size()));
+                    outputFile.close();
+                }
+                else { // LCOV_EXCL_LINE
+                    std::cout.write(content.data(), static_cast<std::streamsize>(content.size())); // LCOV_EXCL_LINE
+                }
             }
+        }
+        else {
+            for (auto e : result.first) {
+                std::string content;
+                if (generateCPP) {
+                    cluon::MetaMessageToCPPTransformator transformation;
+                    e.accept([&trans = transformation](const cluon::MetaMessage &_mm){ trans.visit(_mm); });
+                    content = transformation.content();
+                }
+                if (generateProto) {
+                    cluon::MetaMessageToProtoTransformator transformation;
+                    e.accept([&trans = transformation](const cluon::MetaMessage &_mm){ trans.visit(_mm); });
+                    content = transformation.content(addHeaderForFirstProtoFile);
+                    addHeaderForFirstProtoFile = false;
+                }
 
-            if (!outputFilename.empty()) {
-                std::ofstream outputFile(outputFilename, std::ios::out | std::ios::app);
-                outputFile << content << std::endl;
-                outputFile.close();
-            }
-            else { // LCOV_EXCL_LINE
-                std::cout << content << std::endl; // LCOV_EXCL_LINE
+                if (!outputFilename.empty()) {
+                    std::ofstream outputFile(outputFilename, std::ios::out | std::ios::app);
+                    outputFile << content << std::endl;
+                    outputFile.close();
+                }
+                else { // LCOV_EXCL_LINE
+                    std::cout << content << std::endl; // LCOV_EXCL_LINE
+                }
             }
         }
     }
@@ -17707,11 +22739,16 @@ int32_t main(int32_t argc, char **argv) {
 //#include "cluon/Player.hpp"
 //#include "cluon/cluonDataStructures.hpp"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
 #include <thread>
 
@@ -17720,10 +22757,13 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
     const std::string PROGRAM{argv[0]}; // NOLINT
     auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
     if (1 == argc) {
-        std::cerr << PROGRAM << " replays a .rec file into an OpenDaVINCI session or to stdout; if playing back to an OD4Session using parameter --cid, you can specify the optional parameter --stdout to also playback to stdout; --keeprunning keeps " << PROGRAM << " open at the end of a recording file." << std::endl;
-        std::cerr << "Usage:   " << PROGRAM << " [--cid=<OpenDaVINCI session> [--stdout] [--keeprunning]] recording.rec" << std::endl;
+        std::cerr << PROGRAM << " replays a .rec file into an OpenDaVINCI session or to stdout; if playing back to an OD4Session using parameter --cid, you can specify the optional parameter --stdout to also playback to stdout; --keeprunning keeps " << PROGRAM << " open at the end of a recording file; --keep replays only the given message identifiers, optionally restricted to a senderStamp; --rate scales the playback speed between 0.25 and 100 times the recorded speed or replays as fast as possible with 'max'; --lockstep replays the next Envelope only after the previous one was acknowledged by sending a PlayerCommand with command 5 (acknowledge) to the OD4Session." << std::endl;
+        std::cerr << "Usage:   " << PROGRAM << " [--cid=<OpenDaVINCI session> [--stdout] [--keeprunning] [--lockstep]] [--keep=<ID[/SENDERSTAMP]>[,<ID[/SENDERSTAMP]>]*] [--rate=<factor>|max] recording.rec" << std::endl;
         std::cerr << "Example: " << PROGRAM << " --cid=111 file.rec" << std::endl;
         std::cerr << "         " << PROGRAM << " --cid=111 --stdout file.rec" << std::endl;
+        std::cerr << "         " << PROGRAM << " --keep=1030,1090/1 file.rec" << std::endl;
+        std::cerr << "         " << PROGRAM << " --rate=4 file.rec" << std::endl;
+        std::cerr << "         " << PROGRAM << " --cid=111 --lockstep --keep=1055 file.rec" << std::endl;
         std::cerr << "         " << PROGRAM << " file.rec" << std::endl;
         retCode = 1;
     }
@@ -17731,6 +22771,54 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
         const bool playBackToStdout = ( (0 != commandlineArguments.count("stdout")) || (0 == commandlineArguments.count("cid")) );
         const bool keepRunning = (0 != commandlineArguments.count("keeprunning"));
 
+        // Scale the recorded delays between two Envelopes, e.g., --rate=2 replays twice as fast; --rate=max does not wait at all.
+        constexpr float MIN_RATE{0.25f};
+        constexpr float MAX_RATE{100.0f};
+        bool asFastAsPossible{false};
+        float rate{1.0f};
+        if (0 != commandlineArguments.count("rate")) {
+            if ("max" == commandlineArguments["rate"]) {
+                asFastAsPossible = true;
+            } else {
+                const std::string RATE{commandlineArguments["rate"]};
+                std::size_t parsed{0};
+                try {
+                    rate = std::stof(RATE, &parsed);
+                } catch (...) {
+                    parsed = 0;
+                }
+                if ((0 == parsed) || (RATE.size() != parsed) || !((MIN_RATE <= rate) && (rate <= MAX_RATE))) {
+                    std::cerr << PROGRAM << ": Invalid value '" << RATE << "' for --rate; expected a factor between " << MIN_RATE << " and " << MAX_RATE << " or 'max'." << std::endl;
+                    return retCode = 1;
+                }
+            }
+        }
+
+        // In lockstep mode, the consumer acknowledges every replayed Envelope with a PlayerCommand acknowledge; acknowledgements are only received via an OD4Session.
+        constexpr uint8_t PLAYERCOMMAND_ACKNOWLEDGE{5};
+        const bool lockstep = (0 != commandlineArguments.count("lockstep")) && (0 != commandlineArguments.count("cid"));
+        if ((0 != commandlineArguments.count("lockstep")) && !lockstep) {
+            std::cerr << PROGRAM << ": Ignoring --lockstep as it requires --cid." << std::endl;
+        }
+
+        // Replay only the given message identifiers and senderStamps, e.g., --keep=1030,1090/1.
+        std::map<int32_t, std::set<uint32_t>> allowList;
+        if (0 != commandlineArguments.count("keep")) {
+            std::stringstream sstr{commandlineArguments["keep"]};
+            std::string entry;
+            while (std::getline(sstr, entry, ',')) {
+                try {
+                    const std::size_t SLASH{entry.find('/')};
+                    auto &senderStamps = allowList[std::stoi(entry.substr(0, SLASH))];
+                    if (std::string::npos != SLASH) {
+                        senderStamps.insert(static_cast<uint32_t>(std::stoul(entry.substr(SLASH + 1))));
+                    }
+                } catch (...) {
+                    std::cerr << PROGRAM << ": Ignoring invalid entry '" << entry << "' for --keep." << std::endl;
+                }
+            }
+        }
+
         std::string recFile;
         for (auto e : commandlineArguments) {
             if (recFile.empty() && e.second.empty() && e.first != PROGRAM) {
@@ -17745,14 +22833,28 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
             std::mutex playerCommandMutex;
             cluon::data::PlayerCommand playerCommand;
 
+            // Pending acknowledgements in lockstep mode; the first Envelope is replayed without waiting.
+            uint32_t acknowledgements{1};
+            std::mutex acknowledgementsMutex;
+            std::condition_variable acknowledgementsCondition;
+
             // Create an OD4Session to relay the.
             std::unique_ptr<cluon::OD4Session> od4;
             if (0 != commandlineArguments.count("cid")) {
                 // Interface to a running OpenDaVINCI session and listening for PlayerCommands.
                 od4 = std::make_unique<cluon::OD4Session>(static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))); // LCOV_EXCL_LINE
                 if (od4) {
-                    od4->dataTrigger(cluon::data::PlayerCommand::ID(), [&playCommandUpdate, &playerCommandMutex, &playerCommand](cluon::data::Envelope &&env){
+                    od4->dataTrigger(cluon::data::PlayerCommand::ID(), [lockstep, &acknowledgements, &acknowledgementsMutex, &acknowledgementsCondition, &playCommandUpdate, &playerCommandMutex, &playerCommand](cluon::data::Envelope &&env){
                         cluon::data::PlayerCommand pc = cluon::extractMessage<cluon::data::PlayerCommand>(std::move(env));
+                        // Count every acknowledgement so that none gets lost when they arrive faster than being processed.
+                        if (lockstep && (PLAYERCOMMAND_ACKNOWLEDGE == pc.command())) {
+                            {
+                                std::lock_guard<std::mutex> lck(acknowledgementsMutex);
+                                acknowledgements++;
+                            }
+                            acknowledgementsCondition.notify_one();
+                            return;
+                        }
                         {
                             std::lock_guard<std::mutex> lck(playerCommandMutex);
                             playerCommand = pc;
@@ -17792,7 +22894,8 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
             }
             constexpr bool AUTOREWIND{false};
             constexpr bool THREADING{true};
-            cluon::Player player(recFile, AUTOREWIND, THREADING);
+            constexpr bool MEMORYMAPPED{true};
+            cluon::Player player(recFile, AUTOREWIND, THREADING, MEMORYMAPPED, allowList);
             player.setPlayerListener([&playerStatusUpdate, &playerStatusMutex, &playerStatus](cluon::data::PlayerStatus &&ps){
                 {
                     std::lock_guard<std::mutex> lck(playerStatusMutex);
@@ -17888,8 +22991,19 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
                 }
                 // If playback is desired, relay the Envelope to the OD4Session.
                 if (play || step) {
+                    // In lockstep mode, wait until the consumer acknowledged the previously replayed Envelope.
+                    if (lockstep) {
+                        std::unique_lock<std::mutex> lck(acknowledgementsMutex);
+                        if (!acknowledgementsCondition.wait_for(lck, std::chrono::milliseconds(100), [&acknowledgements](){ return 0 < acknowledgements; })) {
+                            continue;
+                        }
+                    }
                     auto next = player.getNextEnvelopeToBeReplayed();
                     if (next.first) {
+                        if (lockstep) {
+                            std::lock_guard<std::mutex> lck(acknowledgementsMutex);
+                            acknowledgements--;
+                        }
                         if (od4 && od4->isRunning()) {
                             cluon::data::Envelope e = next.second;
                             od4->send(std::move(e));
@@ -17899,7 +23013,9 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
                             std::cout << cluon::serializeEnvelope(std::move(e));
                             std::cout.flush();
                         }
-                        std::this_thread::sleep_for(std::chrono::duration<int32_t, std::micro>(player.delay()));
+                        if (!lockstep && !asFastAsPossible) {
+                            std::this_thread::sleep_for(std::chrono::duration<int32_t, std::micro>(static_cast<int32_t>(static_cast<float>(player.delay()) / rate)));
+                        }
                     }
                 }
                 else {
@@ -18010,16 +23126,12 @@ inline int32_t cluon_livefeed(int32_t argc, char **argv) {
         {
             std::string odvdFile{commandlineArguments["odvd"]};
             if (!odvdFile.empty()) {
-                std::fstream fin{odvdFile, std::ios::in};
-                if (fin.good()) {
-                    const std::string s{static_cast<std::stringstream const&>(std::stringstream() << fin.rdbuf()).str()}; // NOLINT
-
-                    cluon::MessageParser mp;
-                    auto parsingResult = mp.parse(s);
-                    if (!parsingResult.first.empty()) {
-                        for (const auto &mm : parsingResult.first) { scopeOfMetaMessages[mm.messageIdentifier()] = mm; }
-                        std::clog << "Parsed " << parsingResult.first.size() << " message(s)." << std::endl;
-                    }
+                // The file might also contain a compiled message specification from cluon-msc --binary.
+                cluon::MessageParser mp;
+                auto parsingResult = mp.parseFile(odvdFile);
+                if (!parsingResult.first.empty()) {
+                    for (const auto &mm : parsingResult.first) { scopeOfMetaMessages[mm.messageIdentifier()] = mm; }
+                    std::clog << "Parsed " << parsingResult.first.size() << " message(s)." << std::endl;
                 }
             }
         }
@@ -18075,42 +23187,329 @@ inline int32_t cluon_livefeed(int32_t argc, char **argv) {
                             auto env = ee.second;
                             std::stringstream sstr;
 
-                            float freq{0};
-                            if ( (0 < mapOfUpdateRates.count(ee.second.dataType())) && (0 < mapOfUpdateRates[ee.second.dataType()].count(ee.second.senderStamp())) ) {
-                                freq = mapOfUpdateRates[ee.second.dataType()][ee.second.senderStamp()];
-                            }
+                            float freq{0};
+                            if ( (0 < mapOfUpdateRates.count(ee.second.dataType())) && (0 < mapOfUpdateRates[ee.second.dataType()].count(ee.second.senderStamp())) ) {
+                                freq = mapOfUpdateRates[ee.second.dataType()][ee.second.senderStamp()];
+                            }
+
+                            sstr << "Envelope: " << std::setfill(' ') << std::setw(5) << env.dataType() << std::setw(0) << "/" << env.senderStamp() << "; " << (static_cast<float>(static_cast<uint32_t>(freq*100.0f))/100.f) << " Hz; " << "sent: " << formatTimeStamp(env.sent()) << "; sample: " << formatTimeStamp(env.sampleTimeStamp());
+                            if (scopeOfMetaMessages.count(env.dataType()) > 0) {
+                                sstr << "; " << scopeOfMetaMessages[env.dataType()].messageName();
+                            }
+                            else {
+                                sstr << "; unknown data type";
+                            }
+                            sstr << std::endl;
+
+                            const auto AGE{cluon::time::deltaInMicroseconds(cluon::time::now(), env.received())};
+
+                            Color c = Color::DEFAULT;
+                            if (AGE <= 2 * 1000 * 1000) { c = Color::GREEN; }
+                            if (AGE > 2 * 1000 * 1000 && AGE <= 5 * 1000 * 1000) { c = Color::YELLOW; }
+                            if (AGE > 5 * 1000 * 1000) { c = Color::RED; }
+
+                            writeText(c, y++, x, sstr.str());
+                        }
+                    }
+                }
+                return od4Session.isRunning();
+            });
+
+            retVal = 0;
+        }
+    }
+    return retVal;
+}
+
+#endif
+
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// This test for a compiler definition is necessary to preserve single-file, header-only compability.
+#ifndef HAVE_CLUON_LIVEFEED
+#include "cluon-livefeed.hpp"
+#endif
+
+#include <cstdint>
+
+int32_t main(int32_t argc, char **argv) {
+    return cluon_livefeed(argc, argv);
+}
+#endif
+#ifdef HAVE_CLUON_REC2CSV
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_REC2CSV_HPP
+#define CLUON_REC2CSV_HPP
+
+//#include "cluon/cluon.hpp"
+//#include "cluon/Envelope.hpp"
+//#include "cluon/FromProtoVisitor.hpp"
+//#include "cluon/GenericMessage.hpp"
+//#include "cluon/MessageParser.hpp"
+//#include "cluon/MetaMessage.hpp"
+//#include "cluon/Player.hpp"
+//#include "cluon/ToCSVVisitor.hpp"
+//#include "cluon/cluonDataStructures.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+inline int32_t cluon_rec2csv(int32_t argc, char **argv) {
+    int32_t retCode{0};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if ( (0 == commandlineArguments.count("rec")) || (0 == commandlineArguments.count("odvd")) ) {
+        std::cerr << argv[0] << " extracts the content from a given .rec file using a provided .odvd message specification into separate .csv files; --threads sets the number of threads decoding Envelopes (default: number of cores)." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --rec=<Recording from an OD4Session> --odvd=<ODVD Message Specification> [--threads=<number of threads>]" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --rec=myRecording.rec --odvd=myMessages.odvd" << std::endl;
+        retCode = 1;
+    } else {
+        cluon::MessageParser mp;
+        std::pair<std::vector<cluon::MetaMessage>, cluon::MessageParser::MessageParserErrorCodes> messageParserResult;
+        {
+            std::ifstream fin(commandlineArguments["odvd"], std::ios::in|std::ios::binary);
+            if (fin.good()) {
+                fin.close();
+                // The file might also contain a compiled message specification from cluon-msc --binary.
+                messageParserResult = mp.parseFile(commandlineArguments["odvd"]);
+                std::clog << "Found " << messageParserResult.first.size() << " messages." << std::endl;
+            }
+            else {
+                std::cerr << argv[0] << ": Message specification '" << commandlineArguments["odvd"] << "' not found." << std::endl;
+                return retCode = 1;
+            }
+        }
+
+        std::fstream fin(commandlineArguments["rec"], std::ios::in|std::ios::binary);
+        if (fin.good()) {
+            fin.close();
+
+            std::map<int32_t, cluon::MetaMessage> scope;
+            for (const auto &e : messageParserResult.first) { scope[e.messageIdentifier()] = e; }
+
+            // Create "empty" GenericMessages only once per message type.
+            std::map<int32_t, cluon::GenericMessage> genericMessages;
+            for (const auto &e : messageParserResult.first) { genericMessages[e.messageIdentifier()].createFrom(e, messageParserResult.first); }
+
+            // Do not even read Envelopes that cannot be decoded.
+            std::map<int32_t, std::set<uint32_t>> allowList;
+            for (const auto &e : scope) { allowList[e.first]; }
+
+            constexpr const bool AUTOREWIND{false};
+            constexpr const bool THREADING{false};
+            constexpr const bool MEMORYMAPPED{true};
+            cluon::Player player(commandlineArguments["rec"], AUTOREWIND, THREADING, MEMORYMAPPED, allowList);
+            const uint32_t TOTAL_NUMBER_OF_ENVELOPES{player.totalNumberOfEnvelopesInRecFile()};
+
+            std::size_t numberOfDecoders{(std::max)(1u, std::thread::hardware_concurrency())};
+            if (0 != commandlineArguments.count("threads")) {
+                try {
+                    numberOfDecoders = static_cast<std::size_t>((std::max)(1, std::stoi(commandlineArguments["threads"])));
+                } catch (...) {
+                    std::cerr << argv[0] << ": Ignoring invalid value '" << commandlineArguments["threads"] << "' for --threads." << std::endl;
+                }
+            }
+
+            // Skip dataType, serializedData, and senderStamp (as it is in file name) from the Envelope.
+            const std::map<uint32_t, bool> TIMESTAMPS{ {1,false}, {2,false}, {3,true}, {4,true}, {5,true}, {6,false} };
 
-                            sstr << "Envelope: " << std::setfill(' ') << std::setw(5) << env.dataType() << std::setw(0) << "/" << env.senderStamp() << "; " << (static_cast<float>(static_cast<uint32_t>(freq*100.0f))/100.f) << " Hz; " << "sent: " << formatTimeStamp(env.sent()) << "; sample: " << formatTimeStamp(env.sampleTimeStamp());
-                            if (scopeOfMetaMessages.count(env.dataType()) > 0) {
-                                sstr << "; " << scopeOfMetaMessages[env.dataType()].messageName();
+            // Consecutive Envelopes are read in batches; once decoded, a batch holds
+            // the CSV rows per message identifier and senderStamp in their order.
+            struct Batch {
+                std::vector<std::pair<const char*, std::size_t>> serializedEnvelopes{};
+                std::vector<cluon::data::Envelope> envelopes{};
+                std::map<std::pair<int32_t, uint32_t>, std::string> rows{};
+                bool decoded{false};
+            };
+            constexpr const std::size_t ENVELOPES_PER_BATCH{4096};
+            const std::size_t MAX_BATCHES{4 * numberOfDecoders};
+
+            std::mutex batchesMutex;
+            std::condition_variable batchesChanged;
+            std::map<uint64_t, Batch> batches;
+            uint64_t nextBatchToRead{0};
+            uint64_t nextBatchToDecode{0};
+            bool readingDone{false};
+
+            // Read batches from the .rec file; the memory-mapped Envelopes are only decoded by the decoders.
+            std::thread reader([&player, &batchesMutex, &batchesChanged, &batches, &nextBatchToRead, &readingDone, ENVELOPES_PER_BATCH, MAX_BATCHES](){
+                try {
+                    bool hasMoreData{true};
+                    while (hasMoreData) {
+                        Batch batch;
+                        while ( hasMoreData && (batch.serializedEnvelopes.size() + batch.envelopes.size() < ENVELOPES_PER_BATCH) ) {
+                            auto next = player.getNextSerializedEnvelopeToBeReplayed();
+                            if (nullptr != next.first) {
+                                batch.serializedEnvelopes.push_back(next);
                             }
                             else {
-                                sstr << "; unknown data type";
+                                // The .rec file is not memory-mapped, e.g., a chunked .rec file.
+                                auto env = player.getNextEnvelopeToBeReplayed();
+                                if (env.first) {
+                                    batch.envelopes.push_back(std::move(env.second));
+                                }
+                                hasMoreData = env.first;
                             }
-                            sstr << std::endl;
+                            hasMoreData = hasMoreData && player.hasMoreData();
+                        }
 
-                            const auto AGE{cluon::time::deltaInMicroseconds(cluon::time::now(), env.received())};
+                        std::unique_lock<std::mutex> lck(batchesMutex);
+                        batchesChanged.wait(lck, [&batches, MAX_BATCHES](){ return batches.size() < MAX_BATCHES; });
+                        batches[nextBatchToRead++] = std::move(batch);
+                        batchesChanged.notify_all();
+                    }
+                } catch (...) {} // LCOV_EXCL_LINE
+                std::lock_guard<std::mutex> lck(batchesMutex);
+                readingDone = true;
+                batchesChanged.notify_all();
+            });
 
-                            Color c = Color::DEFAULT;
-                            if (AGE <= 2 * 1000 * 1000) { c = Color::GREEN; }
-                            if (AGE > 2 * 1000 * 1000 && AGE <= 5 * 1000 * 1000) { c = Color::YELLOW; }
-                            if (AGE > 5 * 1000 * 1000) { c = Color::RED; }
+            // Decode batches concurrently into CSV rows.
+            auto decoder = [&scope, &genericMessages, &TIMESTAMPS, &batchesMutex, &batchesChanged, &batches, &nextBatchToRead, &nextBatchToDecode, &readingDone](){
+                while (true) {
+                    Batch *batch{nullptr};
+                    {
+                        std::unique_lock<std::mutex> lck(batchesMutex);
+                        batchesChanged.wait(lck, [&nextBatchToRead, &nextBatchToDecode, &readingDone](){ return (nextBatchToDecode < nextBatchToRead) || readingDone; });
+                        if (nextBatchToDecode == nextBatchToRead) {
+                            break;
+                        }
+                        // References to the elements of a std::map stay valid while others are added or removed.
+                        batch = &batches[nextBatchToDecode++];
+                    }
 
-                            writeText(c, y++, x, sstr.str());
+                    try {
+                        const std::size_t NUMBER_OF_ENVELOPES{batch->serializedEnvelopes.size() + batch->envelopes.size()};
+                        for (std::size_t i{0}; i < NUMBER_OF_ENVELOPES; i++) {
+                            cluon::data::Envelope env{(i < batch->serializedEnvelopes.size())
+                                ? cluon::extractEnvelope(batch->serializedEnvelopes[i].first, batch->serializedEnvelopes[i].second).second
+                                : std::move(batch->envelopes[i - batch->serializedEnvelopes.size()])};
+                            auto gmIt = genericMessages.find(env.dataType());
+                            if ( (scope.end() != scope.find(env.dataType())) && (genericMessages.end() != gmIt) ) {
+                                cluon::GenericMessage gm{gmIt->second};
+
+                                cluon::FromProtoVisitor protoDecoder;
+                                protoDecoder.decodeFrom(env.serializedData().data(), env.serializedData().size(), gm);
+
+                                cluon::ToCSVVisitor timeStampsCSV(';', false, TIMESTAMPS);
+                                env.accept(timeStampsCSV);
+                                const std::string TIMESTAMPS_ROW{timeStampsCSV.csv()};
+
+                                cluon::ToCSVVisitor valuesCSV(';', false);
+                                gm.accept(valuesCSV);
+
+                                std::string &rows = batch->rows[std::make_pair(env.dataType(), env.senderStamp())];
+                                rows.append(TIMESTAMPS_ROW, 0, TIMESTAMPS_ROW.find('\n'));
+                                rows.append(valuesCSV.csv());
+                            }
                         }
+                        batch->serializedEnvelopes.clear();
+                        batch->envelopes.clear();
+                    } catch (...) {} // LCOV_EXCL_LINE
+
+                    std::lock_guard<std::mutex> lck(batchesMutex);
+                    batch->decoded = true;
+                    batchesChanged.notify_all();
+                }
+            };
+            std::vector<std::thread> decoders;
+            for (std::size_t i{0}; i < numberOfDecoders; i++) {
+                decoders.emplace_back(decoder);
+            }
+
+            // The header of a .csv file only depends on the message type.
+            auto header = [&genericMessages, &TIMESTAMPS](int32_t dataType){
+                cluon::data::Envelope env;
+                cluon::ToCSVVisitor timeStampsCSV(';', true, TIMESTAMPS);
+                env.accept(timeStampsCSV);
+                const std::string TIMESTAMPS_HEADER{timeStampsCSV.csv()};
+
+                cluon::GenericMessage gm{genericMessages[dataType]};
+                cluon::ToCSVVisitor valuesCSV(';', true);
+                gm.accept(valuesCSV);
+                const std::string VALUES_HEADER{valuesCSV.csv()};
+
+                return TIMESTAMPS_HEADER.substr(0, TIMESTAMPS_HEADER.find('\n')) + VALUES_HEADER.substr(0, VALUES_HEADER.find('\n')) + '\n';
+            };
+
+            // Write the decoded batches in their order to one .csv file per message identifier and senderStamp.
+            std::map<std::pair<int32_t, uint32_t>, std::unique_ptr<std::fstream>> files;
+            uint64_t nextBatchToWrite{0};
+            uint32_t envelopeCounter{0};
+            int32_t oldPercentage = -1;
+            while (true) {
+                Batch batch;
+                {
+                    std::unique_lock<std::mutex> lck(batchesMutex);
+                    batchesChanged.wait(lck, [&batches, &nextBatchToRead, &nextBatchToWrite, &readingDone](){
+                        auto it = batches.find(nextBatchToWrite);
+                        return ( (batches.end() != it) && it->second.decoded ) || (readingDone && (nextBatchToWrite == nextBatchToRead));
+                    });
+                    if (nextBatchToWrite == nextBatchToRead) {
+                        break;
                     }
+                    batch = std::move(batches[nextBatchToWrite]);
+                    batches.erase(nextBatchToWrite++);
+                    batchesChanged.notify_all();
                 }
-                return od4Session.isRunning();
-            });
 
-            retVal = 0;
+                for (const auto &rows : batch.rows) {
+                    auto &file = files[rows.first];
+                    if (!file) {
+                        const std::string FILENAME{scope[rows.first.first].messageName() + "-" + std::to_string(rows.first.second) + ".csv"};
+                        std::cerr << argv[0] << " writing '" << FILENAME << "'." << std::endl;
+                        file.reset(new std::fstream(FILENAME, std::ios::out|std::ios::binary|std::ios::trunc));
+                        const std::string HEADER{header(rows.first.first)};
+                        file->write(HEADER.c_str(), static_cast<std::streamsize>(HEADER.size()));
+                    }
+                    file->write(rows.second.c_str(), static_cast<std::streamsize>(rows.second.size()));
+                }
+
+                envelopeCounter += static_cast<uint32_t>(ENVELOPES_PER_BATCH);
+                const int32_t percentage = static_cast<int32_t>((static_cast<float>((std::min)(envelopeCounter, TOTAL_NUMBER_OF_ENVELOPES))*100.0f)/static_cast<float>(TOTAL_NUMBER_OF_ENVELOPES));
+                if ( (percentage % 5 == 0) && (percentage != oldPercentage) ) {
+                    std::cerr << argv[0] << ": Processed " << percentage << "%." << std::endl;
+                    oldPercentage = percentage;
+                }
+            }
+
+            reader.join();
+            for (auto &d : decoders) {
+                d.join();
+            }
+        }
+        else {
+            std::cerr << argv[0] << ": Recording '" << commandlineArguments["rec"] << "' not found." << std::endl;
+            retCode = 1;
         }
     }
-    return retVal;
+    return retCode;
 }
 
 #endif
-
 /*
  * Copyright (C) 2017-2018  Christian Berger
  *
@@ -18120,17 +23519,17 @@ inline int32_t cluon_livefeed(int32_t argc, char **argv) {
  */
 
 // This test for a compiler definition is necessary to preserve single-file, header-only compability.
-#ifndef HAVE_CLUON_LIVEFEED
-#include "cluon-livefeed.hpp"
+#ifndef HAVE_CLUON_REC2CSV
+#include "cluon-rec2csv.hpp"
 #endif
 
 #include <cstdint>
 
 int32_t main(int32_t argc, char **argv) {
-    return cluon_livefeed(argc, argv);
+    return cluon_rec2csv(argc, argv);
 }
 #endif
-#ifdef HAVE_CLUON_REC2CSV
+#ifdef HAVE_CLUON_REC2JSON
 /*
  * Copyright (C) 2017-2018  Christian Berger
  *
@@ -18139,50 +23538,39 @@ int32_t main(int32_t argc, char **argv) {
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
-#ifndef CLUON_REC2CSV_HPP
-#define CLUON_REC2CSV_HPP
+#ifndef CLUON_REC2JSON_HPP
+#define CLUON_REC2JSON_HPP
 
 //#include "cluon/cluon.hpp"
-//#include "cluon/GenericMessage.hpp"
-//#include "cluon/MessageParser.hpp"
-//#include "cluon/MetaMessage.hpp"
+//#include "cluon/EnvelopeConverter.hpp"
 //#include "cluon/Player.hpp"
-//#include "cluon/ToCSVVisitor.hpp"
-//#include "cluon/stringtoolbox.hpp"
-//#include "cluon/cluonDataStructures.hpp"
 
-#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
-#include <map>
 #include <sstream>
 #include <string>
-#include <thread>
+#include <utility>
 
-inline int32_t cluon_rec2csv(int32_t argc, char **argv) {
+inline int32_t cluon_rec2json(int32_t argc, char **argv) {
     int32_t retCode{0};
     auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
     if ( (0 == commandlineArguments.count("rec")) || (0 == commandlineArguments.count("odvd")) ) {
-        std::cerr << argv[0] << " extracts the content from a given .rec file using a provided .odvd message specification into separate .csv files." << std::endl;
-        std::cerr << "Usage:   " << argv[0] << " --rec=<Recording from an OD4Session> --odvd=<ODVD Message Specification>" << std::endl;
-        std::cerr << "Example: " << argv[0] << " --rec=myRecording.rec --odvd=myMessages.odvd" << std::endl;
+        std::cerr << argv[0] << " transforms the content from a given .rec file using a provided .odvd message specification into a JSON array." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --rec=<Recording from an OD4Session> --odvd=<ODVD Message Specification> [--out=<JSON file; default: stdout>]" << std::endl;
+        std::cerr << "         Envelopes from a chunked .rec file are transformed in chronological order." << std::endl;
+        std::cerr << "Example: " << argv[0] << " --rec=myRecording.rec --odvd=myMessages.odvd --out=myRecording.json" << std::endl;
         retCode = 1;
     } else {
-        // Maps of container-ID & sender-stamp.
-        std::map<std::string, std::string> mapOfFilenames;
-        std::map<std::string, std::string> mapOfEntries;
-        std::map<std::string, size_t> mapOfEntriesSizes;
-        std::map<std::string, bool> mapOfFilenamesThatHaveBeenReset;
-
-        cluon::MessageParser mp;
-        std::pair<std::vector<cluon::MetaMessage>, cluon::MessageParser::MessageParserErrorCodes> messageParserResult;
+        cluon::EnvelopeConverter envConverter;
         {
             std::ifstream fin(commandlineArguments["odvd"], std::ios::in|std::ios::binary);
             if (fin.good()) {
                 std::string input(static_cast<std::stringstream const&>(std::stringstream() << fin.rdbuf()).str()); // NOLINT
                 fin.close();
-                messageParserResult = mp.parse(input);
-                std::clog << "Found " << messageParserResult.first.size() << " messages." << std::endl;
+                std::clog << "Found " << envConverter.setMessageSpecification(input) << " messages." << std::endl;
             }
             else {
                 std::cerr << argv[0] << ": Message specification '" << commandlineArguments["odvd"] << "' not found." << std::endl;
@@ -18190,119 +23578,436 @@ inline int32_t cluon_rec2csv(int32_t argc, char **argv) {
             }
         }
 
-        std::fstream fin(commandlineArguments["rec"], std::ios::in|std::ios::binary);
+        std::ifstream fin(commandlineArguments["rec"], std::ios::in|std::ios::binary);
         if (fin.good()) {
-            fin.close();
-
-            auto fileWriter = [argv, &mapOfFilenames, &mapOfEntries, &mapOfEntriesSizes, &mapOfFilenamesThatHaveBeenReset](){
-              for(auto entries : mapOfFilenames) {
-                  std::cerr << argv[0] << " writing '" << entries.second << ".csv'...";
-                  // Reset files on first access.
-                  std::ios_base::openmode openMode = std::ios::out|std::ios::binary|(mapOfFilenamesThatHaveBeenReset.count(entries.second) == 0 ? std::ios::trunc : std::ios::app);
-                  std::fstream fout(entries.second + ".csv", openMode);
-                  if (fout.good() && mapOfEntries.count(entries.first)) {
-                      const std::string tmp{mapOfEntries[entries.first]};
-                      fout.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
-                      // Reset memory.
-                      mapOfEntries[entries.first] = "";
-                      mapOfEntriesSizes[entries.first] = 0;
-                  }
-                  fout.close();
-                  mapOfFilenamesThatHaveBeenReset[entries.second] = true;
-                  std::cerr << " done." << std::endl;
-              }
+            // Chunked .rec files are decompressed by cluon::Player; plain ones are streamed as they are.
+            bool chunked{false};
+            {
+                char magic[sizeof(cluon::CHUNKED_REC_FILE_MAGIC)]{};
+                fin.read(magic, sizeof(magic)); // Flawfinder: ignore
+                chunked = fin.good() && (0 == std::memcmp(magic, cluon::CHUNKED_REC_FILE_MAGIC, sizeof(magic)));
+                fin.clear();
+                fin.seekg(0, fin.beg);
+            }
+            auto transform = [&envConverter, &commandlineArguments, &fin, chunked](std::ostream &out) {
+                uint64_t transformed{0};
+                if (chunked) {
+                    constexpr bool AUTOREWIND{false};
+                    constexpr bool THREADING{false};
+                    cluon::Player player(commandlineArguments["rec"], AUTOREWIND, THREADING);
+                    transformed = envConverter.getJSONFromEnvelopes(
+                        [&player]() {
+                            std::pair<bool, cluon::data::Envelope> next{false, cluon::data::Envelope()};
+                            while (!next.first && player.hasMoreData()) {
+                                next = player.getNextEnvelopeToBeReplayed();
+                            }
+                            return next;
+                        },
+                        out);
+                }
+                else {
+                    transformed = envConverter.getJSONFromRecFile(fin, out);
+                }
+                return transformed;
             };
 
-            std::map<int32_t, cluon::MetaMessage> scope;
-            for (const auto &e : messageParserResult.first) { scope[e.messageIdentifier()] = e; }
+            uint64_t numberOfEnvelopes{0};
+            if (0 < commandlineArguments.count("out")) {
+                std::ofstream fout(commandlineArguments["out"], std::ios::out|std::ios::binary|std::ios::trunc);
+                if (!fout.good()) {
+                    std::cerr << argv[0] << ": Could not create '" << commandlineArguments["out"] << "'." << std::endl;
+                    return retCode = 1;
+                }
+                numberOfEnvelopes = transform(fout);
+            }
+            else {
+                numberOfEnvelopes = transform(std::cout);
+            }
+            std::clog << argv[0] << ": Transformed " << numberOfEnvelopes << " Envelopes." << std::endl;
+        }
+        else {
+            std::cerr << argv[0] << ": Recording '" << commandlineArguments["rec"] << "' not found." << std::endl;
+            retCode = 1;
+        }
+    }
+    return retCode;
+}
 
-            constexpr const bool AUTOREWIND{false};
-            constexpr const bool THREADING{false};
-            cluon::Player player(commandlineArguments["rec"], AUTOREWIND, THREADING);
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
 
-            constexpr const size_t TEN_MB{10*1024*1024};
-            uint32_t envelopeCounter{0};
-            int32_t oldPercentage = -1;
-            while (player.hasMoreData()) {
-                auto next = player.getNextEnvelopeToBeReplayed();
-                if (next.first) {
-                    {
-                        envelopeCounter++;
-                        const int32_t percentage = static_cast<int32_t>((static_cast<float>(envelopeCounter)*100.0f)/static_cast<float>(player.totalNumberOfEnvelopesInRecFile()));
-                        if ( (percentage % 5 == 0) && (percentage != oldPercentage) ) {
-                            std::cerr << argv[0] << ": Processed " << percentage << "%." << std::endl;
-                            oldPercentage = percentage;
-                        }
+// This test for a compiler definition is necessary to preserve single-file, header-only compability.
+#ifndef HAVE_CLUON_REC2JSON
+#include "cluon-rec2json.hpp"
+#endif
+
+#include <cstdint>
+
+int32_t main(int32_t argc, char **argv) {
+    return cluon_rec2json(argc, argv);
+}
+#endif
+#ifdef HAVE_CLUON_OD4BENCH
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_OD4BENCH_HPP
+#define CLUON_OD4BENCH_HPP
+
+//#include "cluon/cluon.hpp"
+//#include "cluon/Envelope.hpp"
+//#include "cluon/OD4Fragmentation.hpp"
+//#include "cluon/OD4Session.hpp"
+//#include "cluon/Time.hpp"
+//#include "cluon/UDPPacketSizeConstraints.hpp"
+//#include "cluon/stringtoolbox.hpp"
+
+// clang-format off
+#ifndef WIN32
+    #include <sys/resource.h>
+    #include <sys/time.h>
+#endif
+// clang-format on
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Data type used for the Envelopes exchanged during a benchmark.
+constexpr int32_t CLUON_OD4BENCH_DATATYPE{0x0D4B};
+
+inline std::vector<uint32_t> cluon_od4bench_parseList(const std::string &list) noexcept {
+    std::vector<uint32_t> retVal;
+    for (auto e : stringtoolbox::split(list + ",", ',')) {
+        stringtoolbox::trim(e);
+        if (!e.empty()) {
+            try {
+                retVal.push_back(static_cast<uint32_t>(std::stoul(e)));
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+    }
+    return retVal;
+}
+
+// Previous stringstream-based serializeEnvelope, kept as reference for cluon_od4bench_serialization.
+inline std::string cluon_od4bench_serializeEnvelopeViaStream(cluon::data::Envelope &&envelope) noexcept {
+    std::stringstream sstr;
+
+    cluon::ToProtoVisitor protoEncoder;
+    envelope.accept(protoEncoder);
+
+    const std::string tmp{protoEncoder.encodedData()};
+    uint32_t length{static_cast<uint32_t>(tmp.size())};
+    length <<= 8;
+    length = htole32(length);
+
+    sstr.put(static_cast<char>(0x0D));
+    auto posByte1 = sstr.tellp();
+    sstr.write(reinterpret_cast<char *>(&length), static_cast<std::streamsize>(sizeof(uint32_t)));
+    auto posByte5 = sstr.tellp();
+    sstr.seekp(posByte1);
+    sstr.put(static_cast<char>(0xA4));
+    sstr.seekp(posByte5);
+    sstr.write(tmp.data(), static_cast<std::streamsize>(tmp.size()));
+
+    return sstr.str();
+}
+
+// Time to serialize and extract an Envelope without any network involved.
+inline void cluon_od4bench_serialization(const std::vector<uint32_t> &sizes, uint32_t count) noexcept {
+    std::cout << "# serialization (in-memory; durations in nanoseconds per Envelope)" << std::endl;
+    std::cout << std::setw(10) << "size" << std::setw(12) << "via-stream" << std::setw(12) << "serialize" << std::setw(10) << "speedup"
+              << std::setw(12) << "extract" << std::setw(16) << "serialize[MB/s]" << std::endl;
+    for (auto size : sizes) {
+        const std::string PAYLOAD(size, 'x');
+        auto envelope = [&PAYLOAD]() {
+            cluon::data::Envelope env;
+            env.dataType(CLUON_OD4BENCH_DATATYPE).senderStamp(1).serializedData(PAYLOAD);
+            env.sent(cluon::time::now()).sampleTimeStamp(env.sent());
+            return env;
+        };
+
+        // Envelopes are prepared in batches outside of the measurement as each call consumes one.
+        constexpr uint32_t BATCH_SIZE{32};
+        std::vector<cluon::data::Envelope> envelopes;
+        auto measure = [&](const std::function<std::size_t(cluon::data::Envelope &&)> &f) {
+            std::size_t bytes{0};
+            std::chrono::nanoseconds duration{0};
+            for (uint32_t i{0}; i < count; i += BATCH_SIZE) {
+                envelopes.clear();
+                for (uint32_t j{i}; j < std::min(count, i + BATCH_SIZE); j++) {
+                    envelopes.emplace_back(envelope());
+                }
+                const auto START{std::chrono::steady_clock::now()};
+                for (auto &env : envelopes) {
+                    bytes += f(std::move(env));
+                }
+                duration += std::chrono::steady_clock::now() - START;
+            }
+            return std::make_pair(std::chrono::duration<double, std::nano>(duration).count() / count, bytes);
+        };
+
+        const auto VIA_STREAM{measure([](cluon::data::Envelope &&env) { return cluon_od4bench_serializeEnvelopeViaStream(std::move(env)).size(); })};
+        const auto SERIALIZE{measure([](cluon::data::Envelope &&env) { return cluon::serializeEnvelope(std::move(env)).size(); })};
+
+        const std::string FRAME{cluon::serializeEnvelope(envelope())};
+        std::size_t extracted{0};
+        const auto START{std::chrono::steady_clock::now()};
+        for (uint32_t i{0}; i < count; i++) {
+            extracted += cluon::extractEnvelope(FRAME.data(), FRAME.size()).second.serializedData().size();
+        }
+        const double EXTRACT{std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - START).count() / count};
+        (void)extracted;
+
+        std::cout << std::setw(10) << size << std::setw(12) << std::fixed << std::setprecision(0) << VIA_STREAM.first << std::setw(12) << SERIALIZE.first
+                  << std::setw(9) << std::setprecision(1) << VIA_STREAM.first / std::max(1e-9, SERIALIZE.first) << "x" << std::setw(12)
+                  << std::setprecision(0) << EXTRACT << std::setw(16)
+                  << static_cast<double>(SERIALIZE.second) / (1024.0 * 1024.0) / std::max(1e-9, SERIALIZE.first * count / 1e9) << std::endl;
+    }
+}
+
+// Reassembly throughput and frame loss caused by lost fragments without any network involved.
+inline void cluon_od4bench_fragmentation(const std::vector<uint32_t> &sizes, const std::vector<uint32_t> &lossesInPermille, uint32_t count) noexcept {
+    std::mt19937 generator{0x0D4};
+    std::uniform_int_distribution<uint32_t> permille{0, 999};
+
+    std::cout << "# fragmentation (in-memory)" << std::endl;
+    std::cout << std::setw(10) << "size" << std::setw(11) << "fragments" << std::setw(10) << "loss[%]" << std::setw(11) << "frames"
+              << std::setw(12) << "complete" << std::setw(14) << "split[MB/s]" << std::setw(19) << "reassembly[MB/s]" << std::endl;
+    for (auto size : sizes) {
+        cluon::data::Envelope env;
+        env.dataType(CLUON_OD4BENCH_DATATYPE).serializedData(std::string(size, 'x'));
+        const std::string FRAME{cluon::serializeEnvelope(std::move(env))};
+
+        for (auto loss : lossesInPermille) {
+            cluon::OD4FragmentAssembler assembler;
+            uint64_t completed{0};
+            std::size_t numberOfFragments{0};
+            std::chrono::nanoseconds durationSplit{0};
+            std::chrono::nanoseconds durationReassembly{0};
+            for (uint32_t i{0}; i < count; i++) {
+                auto start     = std::chrono::steady_clock::now();
+                auto fragments = cluon::fragmentOD4Frame(FRAME, i, cluon::OD4_MAX_FRAGMENT_SIZE);
+                durationSplit += std::chrono::steady_clock::now() - start;
+                numberOfFragments = fragments.size();
+
+                const auto NOW{std::chrono::system_clock::now()};
+                for (auto &f : fragments) {
+                    if (permille(generator) < loss) {
+                        continue;
                     }
-                    cluon::data::Envelope env{std::move(next.second)};
-                    if (scope.count(env.dataType()) > 0) {
-                        cluon::FromProtoVisitor protoDecoder;
-                        std::stringstream sstr(env.serializedData());
-                        protoDecoder.decodeFrom(sstr);
-
-                        cluon::MetaMessage m = scope[env.dataType()];
-                        cluon::GenericMessage gm;
-                        gm.createFrom(m, messageParserResult.first);
-                        gm.accept(protoDecoder);
-
-                        std::stringstream sstrKey;
-                        sstrKey << env.dataType() << "/" << env.senderStamp();
-                        const std::string KEY = sstrKey.str();
-
-                        std::stringstream sstrFilename;
-                        sstrFilename << m.messageName() << "-" << env.senderStamp();
-                        const std::string __FILENAME = sstrFilename.str();
-                        mapOfFilenames[KEY] = __FILENAME;
-
-                        if (mapOfEntries.count(KEY) > 0) {
-                            // Extract timestamps.
-                            std::string timeStamps;
-                            {
-                                cluon::ToCSVVisitor csv(';', false, { {1,false}, {2,false}, {3,true}, {4,true}, {5,true}, {6,false} });
-                                env.accept(csv);
-                                timeStamps = csv.csv();
-                            }
+                    start       = std::chrono::steady_clock::now();
+                    auto retVal = assembler.add(1, f.data(), f.size(), NOW);
+                    durationReassembly += std::chrono::steady_clock::now() - start;
+                    completed += (retVal.first ? 1 : 0);
+                }
+            }
+            const double MB{static_cast<double>(FRAME.size()) * count / (1024.0 * 1024.0)};
+            std::cout << std::setw(10) << size << std::setw(11) << numberOfFragments << std::setw(10) << std::fixed << std::setprecision(1)
+                      << static_cast<double>(loss) / 10.0 << std::setw(11) << count << std::setw(11) << std::setprecision(1)
+                      << 100.0 * static_cast<double>(completed) / count << "%" << std::setw(14) << std::setprecision(0)
+                      << MB / std::max(1e-9, std::chrono::duration<double>(durationSplit).count()) << std::setw(19)
+                      << MB / std::max(1e-9, std::chrono::duration<double>(durationReassembly).count()) << std::endl;
+        }
+    }
+}
+
+// CPU time (user and system) consumed by this process so far.
+inline std::chrono::microseconds cluon_od4bench_cpuTime() noexcept {
+    std::chrono::microseconds retVal{0};
+#ifndef WIN32
+    struct rusage usage {};
+    if (0 == ::getrusage(RUSAGE_SELF, &usage)) {
+        retVal = std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+                 + std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+    }
+#endif
+    return retVal;
+}
 
-                            cluon::ToCSVVisitor csv(';', false);
-                            gm.accept(csv);
+// One subscriber collecting the one-way latencies of the Envelopes of the current round.
+class cluon_od4bench_Subscriber {
+   private:
+    cluon_od4bench_Subscriber(const cluon_od4bench_Subscriber &) = delete;
+    cluon_od4bench_Subscriber(cluon_od4bench_Subscriber &&)      = delete;
+    cluon_od4bench_Subscriber &operator=(const cluon_od4bench_Subscriber &) = delete;
+    cluon_od4bench_Subscriber &operator=(cluon_od4bench_Subscriber &&) = delete;
 
-                            std::string entry{stringtoolbox::split(timeStamps, '\n')[0] + csv.csv()};
-                            mapOfEntries[KEY] += entry;
-                            mapOfEntriesSizes[KEY] += entry.size();
-                       }
-                        else {
-                            // Extract timestamps.
-                            std::vector<std::string> timeStampsWithHeader;
-                            {
-                                // Skip senderStamp (as it is in file name) and serializedData.
-                                cluon::ToCSVVisitor csv(';', true, { {1,false}, {2,false}, {3,true}, {4,true}, {5,true}, {6,false} });
-                                env.accept(csv);
-                                timeStampsWithHeader = stringtoolbox::split(csv.csv(), '\n');
-                            }
+   public:
+    cluon_od4bench_Subscriber(uint16_t cid, const std::atomic<uint32_t> &currentRound) noexcept
+        : m_currentRound(currentRound)
+        , m_od4(cid, [this](cluon::data::Envelope &&env) {
+            if ((CLUON_OD4BENCH_DATATYPE == env.dataType()) && (m_currentRound.load() == env.senderStamp())) {
+                std::lock_guard<std::mutex> lck(m_latenciesMutex);
+                m_latencies.push_back(cluon::time::deltaInMicroseconds(env.received(), env.sent()));
+                m_receivedBytes += env.serializedData().size();
+            }
+        }) {}
 
-                            cluon::ToCSVVisitor csv(';', true);
-                            gm.accept(csv);
+    bool isRunning() noexcept {
+        return m_od4.isRunning();
+    }
 
-                            std::vector<std::string> valuesWithHeader = stringtoolbox::split(csv.csv(), '\n');
-                            std::string entry{timeStampsWithHeader.at(0) + valuesWithHeader.at(0) + '\n' + timeStampsWithHeader.at(1) + valuesWithHeader.at(1) + '\n'};
-                            mapOfEntries[KEY] += entry;
-                            mapOfEntriesSizes[KEY] += entry.size();
-                        }
+    std::vector<int64_t> latencies(uint64_t &receivedBytes) noexcept {
+        std::lock_guard<std::mutex> lck(m_latenciesMutex);
+        std::vector<int64_t> retVal;
+        retVal.swap(m_latencies);
+        receivedBytes   = m_receivedBytes;
+        m_receivedBytes = 0;
+        return retVal;
+    }
+
+    std::size_t numberOfLatencies() noexcept {
+        std::lock_guard<std::mutex> lck(m_latenciesMutex);
+        return m_latencies.size();
+    }
+
+   private:
+    const std::atomic<uint32_t> &m_currentRound;
+    std::mutex m_latenciesMutex{};
+    std::vector<int64_t> m_latencies{};
+    uint64_t m_receivedBytes{0};
+    cluon::OD4Session m_od4;
+};
+
+// End-to-end one-way latency, delivered rate, loss, and CPU time per message of OD4Sessions on this host
+// (UDP multicast on loopback or shared memory) for all combinations of message sizes, send rates, and subscribers.
+inline void cluon_od4bench_loopback(uint16_t cid,
+                                    const std::vector<uint32_t> &sizes,
+                                    const std::vector<uint32_t> &rates,
+                                    const std::vector<uint32_t> &numbersOfSubscribers,
+                                    uint32_t count) noexcept {
+    std::atomic<uint32_t> currentRound{0};
+    cluon::OD4Session sender(cid);
+
+    std::cout << "# loopback (OD4Session " << cid << " via " << (sender.isUsingSharedMemory() ? "shared memory" : "UDP multicast")
+              << "; rate 0 = as fast as possible; latencies in microseconds)" << std::endl;
+    std::cout << std::setw(10) << "size" << std::setw(8) << "rate" << std::setw(6) << "subs" << std::setw(8) << "sent" << std::setw(10) << "received"
+              << std::setw(9) << "loss[%]" << std::setw(8) << "p50" << std::setw(8) << "p99" << std::setw(8) << "p99.9" << std::setw(8) << "max"
+              << std::setw(12) << "rate[msg/s]" << std::setw(12) << "rate[MB/s]" << std::setw(16) << "cpu/msg[us]" << std::endl;
+    for (auto numberOfSubscribers : numbersOfSubscribers) {
+        std::vector<std::unique_ptr<cluon_od4bench_Subscriber>> subscribers;
+        for (uint32_t i{0}; i < numberOfSubscribers; i++) {
+            subscribers.emplace_back(std::make_unique<cluon_od4bench_Subscriber>(cid, currentRound));
+            if (!subscribers.back()->isRunning()) {
+                std::cerr << "cluon-od4bench: OD4Session for CID " << cid << " is not running." << std::endl;
+                return;
+            }
+        }
+        for (auto size : sizes) {
+            for (auto rate : rates) {
+                const uint32_t ROUND{++currentRound};
+                const std::string PAYLOAD(size, 'x');
+                const auto CYCLE{std::chrono::nanoseconds((0 < rate) ? (1000 * 1000 * 1000 / rate) : 0)};
 
-                        // Keep track of buffer sizes.
-                        if (mapOfEntriesSizes[KEY] > TEN_MB) {
-                            std::cerr << argv[0] << ": Buffer for '" << KEY << "' has consumed " << mapOfEntriesSizes[KEY] << "/" << TEN_MB << " bytes; dumping data to disk."<< std::endl; // LCOV_EXCL_LINE
-                            fileWriter(); // LCOV_EXCL_LINE
+                const std::chrono::microseconds CPU_BEFORE{cluon_od4bench_cpuTime()};
+                const auto START{std::chrono::steady_clock::now()};
+                auto next{START};
+                for (uint32_t i{0}; i < count; i++) {
+                    cluon::data::Envelope env;
+                    env.dataType(CLUON_OD4BENCH_DATATYPE).senderStamp(ROUND).serializedData(PAYLOAD);
+                    env.sent(cluon::time::now()).sampleTimeStamp(env.sent());
+                    sender.send(std::move(env));
+                    if (0 < rate) {
+                        next += CYCLE;
+                        std::this_thread::sleep_until(next);
+                    }
+                }
+                // Wait for in-flight Envelopes until all arrived or nothing arrived for 500ms.
+                auto lastProgress{std::chrono::steady_clock::now()};
+                {
+                    std::size_t lastReceived{0};
+                    while (std::chrono::steady_clock::now() - lastProgress < std::chrono::milliseconds(500)) {
+                        std::size_t received{0};
+                        for (auto &s : subscribers) {
+                            received += s->numberOfLatencies();
+                        }
+                        if (received != lastReceived) {
+                            lastReceived = received;
+                            lastProgress = std::chrono::steady_clock::now();
+                        }
+                        if (received >= static_cast<std::size_t>(count) * numberOfSubscribers) {
+                            break;
                         }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
                     }
                 }
+                const double DURATION{std::chrono::duration<double>(lastProgress - START).count()};
+                const std::chrono::microseconds CPU{cluon_od4bench_cpuTime() - CPU_BEFORE};
+                currentRound++;
+
+                std::vector<int64_t> latencies;
+                uint64_t receivedBytes{0};
+                for (auto &s : subscribers) {
+                    uint64_t bytes{0};
+                    auto l{s->latencies(bytes)};
+                    latencies.insert(latencies.end(), l.begin(), l.end());
+                    receivedBytes += bytes;
+                }
+                std::sort(latencies.begin(), latencies.end());
+                auto percentile = [&latencies](double p) {
+                    return latencies.empty() ? 0 : latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * static_cast<double>(latencies.size())))];
+                };
+
+                const uint64_t EXPECTED{static_cast<uint64_t>(count) * numberOfSubscribers};
+                const uint64_t RECEIVED{latencies.size()};
+                std::cout << std::setw(10) << size << std::setw(8) << rate << std::setw(6) << numberOfSubscribers << std::setw(8) << count << std::setw(10)
+                          << RECEIVED << std::setw(9) << std::fixed << std::setprecision(1)
+                          << 100.0 * static_cast<double>(EXPECTED - std::min(EXPECTED, RECEIVED)) / static_cast<double>(std::max<uint64_t>(1, EXPECTED))
+                          << std::setw(8) << percentile(0.5) << std::setw(8) << percentile(0.99) << std::setw(8) << percentile(0.999) << std::setw(8)
+                          << percentile(1.0) << std::setw(12) << std::setprecision(0) << static_cast<double>(RECEIVED) / DURATION << std::setw(12)
+                          << std::setprecision(2) << static_cast<double>(receivedBytes) / (1024.0 * 1024.0) / DURATION << std::setw(16)
+                          << static_cast<double>(CPU.count()) / static_cast<double>(std::max<uint64_t>(1, RECEIVED)) << std::endl;
             }
-            // Clear buffer at the end.
-            fileWriter();
         }
-        else {
-            std::cerr << argv[0] << ": Recording '" << commandlineArguments["rec"] << "' not found." << std::endl;
-            retCode = 1;
+    }
+}
+
+inline int32_t cluon_od4bench(int32_t argc, char **argv) {
+    int32_t retCode{0};
+    const std::string PROGRAM{argv[0]}; // NOLINT
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 != commandlineArguments.count("help")) {
+        std::cerr << PROGRAM << " benchmarks the transport of Envelopes in an OpenDaVINCI session; sizes are given in bytes, rates in messages per second (0 = as fast as possible), and simulated fragment losses in permille." << std::endl;
+        std::cerr << "Usage:   " << PROGRAM << " [--cid=<OpenDaVINCI session>] [--sizes=64,1024,65536,1228800] [--count=1000] [--rates=1000,0] [--subscribers=1,2] [--loss=0,1,10,50]" << std::endl;
+        std::cerr << "Example: " << PROGRAM << " --cid=111 --sizes=1228800 --rates=10,30" << std::endl;
+        std::cerr << "         CLUON_OD4SESSION_SHAREDMEMORY=111 " << PROGRAM << " --cid=111 (to benchmark the shared memory transport)" << std::endl;
+        retCode = 1;
+    }
+    else {
+        const std::vector<uint32_t> SIZES{cluon_od4bench_parseList((0 != commandlineArguments.count("sizes")) ? commandlineArguments["sizes"] : "64,1024,65536,1228800")};
+        const std::vector<uint32_t> RATES{cluon_od4bench_parseList((0 != commandlineArguments.count("rates")) ? commandlineArguments["rates"] : "1000,0")};
+        const std::vector<uint32_t> SUBSCRIBERS{cluon_od4bench_parseList((0 != commandlineArguments.count("subscribers")) ? commandlineArguments["subscribers"] : "1,2")};
+        const std::vector<uint32_t> LOSSES{cluon_od4bench_parseList((0 != commandlineArguments.count("loss")) ? commandlineArguments["loss"] : "0,1,10,50")};
+        const uint32_t COUNT{(0 != commandlineArguments.count("count")) ? static_cast<uint32_t>(std::stoul(commandlineArguments["count"])) : 1000};
+
+        cluon_od4bench_serialization(SIZES, std::max<uint32_t>(1, COUNT));
+        cluon_od4bench_fragmentation(SIZES, LOSSES, std::max<uint32_t>(1, COUNT));
+        if (0 != commandlineArguments.count("cid")) {
+            cluon_od4bench_loopback(static_cast<uint16_t>(std::stoi(commandlineArguments["cid"])), SIZES, RATES, SUBSCRIBERS, std::max<uint32_t>(1, COUNT));
         }
     }
     return retCode;
@@ -18318,13 +24023,13 @@ inline int32_t cluon_rec2csv(int32_t argc, char **argv) {
  */
 
 // This test for a compiler definition is necessary to preserve single-file, header-only compability.
-#ifndef HAVE_CLUON_REC2CSV
-#include "cluon-rec2csv.hpp"
+#ifndef HAVE_CLUON_OD4BENCH
+#include "cluon-od4bench.hpp"
 #endif
 
 #include <cstdint>
 
 int32_t main(int32_t argc, char **argv) {
-    return cluon_rec2csv(argc, argv);
+    return cluon_od4bench(argc, argv);
 }
 #endif
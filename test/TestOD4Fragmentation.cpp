@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "cluon-complete-v0.0.127.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string createFrame(std::size_t size) {
+    std::string payload(size, '\0');
+    for (std::size_t i{0}; i < size; i++) {
+        payload[i] = static_cast<char>(i * 7);
+    }
+    cluon::data::Envelope env;
+    env.dataType(1234).serializedData(payload);
+    return cluon::serializeEnvelope(std::move(env));
+}
+
+TEST_CASE("Split an OD4 frame into fragments fitting into one Ethernet frame.") {
+    REQUIRE(1472 == cluon::OD4_MAX_FRAGMENT_SIZE);
+
+    const std::string FRAME{createFrame(1024 * 1024)};
+    auto fragments = cluon::fragmentOD4Frame(FRAME, 1, cluon::OD4_MAX_FRAGMENT_SIZE);
+    const std::size_t MAX_PAYLOAD{cluon::OD4_MAX_FRAGMENT_SIZE - cluon::OD4_FRAGMENT_HEADER_SIZE};
+    REQUIRE((FRAME.size() + MAX_PAYLOAD - 1) / MAX_PAYLOAD == fragments.size());
+    for (const auto &f : fragments) {
+        REQUIRE(cluon::isOD4Fragment(f.data(), f.size()));
+        REQUIRE(f.size() <= cluon::OD4_MAX_FRAGMENT_SIZE);
+    }
+}
+
+TEST_CASE("Reassemble an OD4 frame from reordered and duplicated fragments.") {
+    const std::string FRAME{createFrame(300 * 1000)};
+    auto fragments = cluon::fragmentOD4Frame(FRAME, 2, cluon::OD4_MAX_FRAGMENT_SIZE);
+    REQUIRE(1 < fragments.size());
+    std::reverse(fragments.begin(), fragments.end());
+    fragments.insert(fragments.begin() + 1, fragments.front());
+
+    cluon::OD4FragmentAssembler assembler;
+    const auto NOW{std::chrono::system_clock::now()};
+    uint32_t completed{0};
+    for (const auto &f : fragments) {
+        auto retVal = assembler.add(1, f.data(), f.size(), NOW);
+        if (retVal.first) {
+            completed++;
+            REQUIRE(FRAME == retVal.second);
+        }
+    }
+    REQUIRE(1 == completed);
+    REQUIRE(1 == assembler.numberOfCompletedFrames());
+    REQUIRE(0 == assembler.numberOfDroppedFrames());
+}
+
+TEST_CASE("Drop an incomplete OD4 frame after the timeout.") {
+    const std::string FRAME{createFrame(100 * 1000)};
+    auto fragments = cluon::fragmentOD4Frame(FRAME, 3, cluon::OD4_MAX_FRAGMENT_SIZE);
+    fragments.pop_back();
+
+    cluon::OD4FragmentAssembler assembler(64 * 1024 * 1024, std::chrono::milliseconds(1000));
+    const auto NOW{std::chrono::system_clock::now()};
+    for (const auto &f : fragments) {
+        REQUIRE(!assembler.add(1, f.data(), f.size(), NOW).first);
+    }
+
+    // A fragment from another sender arriving later expires the incomplete OD4 frame.
+    const std::string OTHER{createFrame(10 * 1000)};
+    auto others = cluon::fragmentOD4Frame(OTHER, 3, cluon::OD4_MAX_FRAGMENT_SIZE);
+    bool completed{false};
+    for (const auto &f : others) {
+        completed = assembler.add(2, f.data(), f.size(), NOW + std::chrono::milliseconds(1001)).first;
+    }
+    REQUIRE(completed);
+    REQUIRE(1 == assembler.numberOfDroppedFrames());
+}
+
+TEST_CASE("Send large Envelopes in UDP packets fitting into one Ethernet frame.") {
+    std::atomic<uint32_t> packets{0};
+    std::atomic<uint32_t> largePackets{0};
+    cluon::UDPReceiver receiver(
+        "225.0.0.177", 12175, [&packets, &largePackets](std::string &&data, std::string &&, std::chrono::system_clock::time_point &&) {
+            packets++;
+            largePackets += (cluon::OD4_MAX_FRAGMENT_SIZE < data.size()) ? 1 : 0;
+        });
+
+    std::atomic<uint32_t> received{0};
+    const std::string PAYLOAD(2 * 1024 * 1024, 'x');
+    cluon::OD4Session subscriber(177, [&received, &PAYLOAD](cluon::data::Envelope &&env) { received += (PAYLOAD == env.serializedData()) ? 1 : 0; });
+    cluon::OD4Session publisher(177);
+
+    cluon::data::Envelope env;
+    env.dataType(1234).serializedData(PAYLOAD);
+    publisher.send(std::move(env));
+
+    const auto UNTIL{std::chrono::steady_clock::now() + std::chrono::seconds(2)};
+    while ((1 != received.load()) && (std::chrono::steady_clock::now() < UNTIL)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(1 == received.load());
+    REQUIRE(PAYLOAD.size() / cluon::OD4_MAX_FRAGMENT_SIZE < packets.load());
+    REQUIRE(0 == largePackets.load());
+}
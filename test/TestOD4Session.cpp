@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "cluon-complete-v0.0.127.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+static bool waitFor(std::function<bool()> condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
+    const auto UNTIL{std::chrono::steady_clock::now() + timeout};
+    while (!condition() && (std::chrono::steady_clock::now() < UNTIL)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+TEST_CASE("Receive Envelopes sent via shared memory right after subscribing.") {
+    REQUIRE(0 == ::setenv("CLUON_OD4SESSION_SHAREDMEMORY", "171", 1));
+
+    for (int32_t i{0}; i < 20; i++) {
+        cluon::OD4Session publisher(171);
+
+        std::atomic<uint32_t> received{0};
+        cluon::OD4Session subscriber(171, [&received](cluon::data::Envelope &&) { received++; });
+        REQUIRE(publisher.isUsingSharedMemory());
+        REQUIRE(subscriber.isUsingSharedMemory());
+
+        cluon::data::TimeStamp ts;
+        ts.seconds(i);
+        publisher.send(ts);
+
+        REQUIRE(waitFor([&received]() { return 1 == received.load(); }));
+    }
+
+    REQUIRE(0 == ::unsetenv("CLUON_OD4SESSION_SHAREDMEMORY"));
+}
+
+TEST_CASE("Receive Envelopes via shared memory only once although they are also sent via UDP multicast.") {
+    REQUIRE(0 == ::setenv("CLUON_OD4SESSION_SHAREDMEMORY", "172", 1));
+
+    std::atomic<uint32_t> received{0};
+    std::atomic<uint32_t> receivedLarge{0};
+    cluon::OD4Session subscriber(172, [&received, &receivedLarge](cluon::data::Envelope &&env) {
+        if (6 * 1024 * 1024 == env.serializedData().size()) {
+            receivedLarge++;
+        } else {
+            received++;
+        }
+    });
+    cluon::OD4Session publisher(172);
+    REQUIRE(subscriber.isUsingSharedMemory());
+    REQUIRE(publisher.isUsingSharedMemory());
+
+    cluon::data::TimeStamp ts;
+    for (int32_t i{0}; i < 100; i++) {
+        publisher.send(ts);
+    }
+    std::vector<cluon::data::TimeStamp> batch(50, ts);
+    publisher.send(batch);
+
+    // Exceeds the 4 MB of the former fixed-size ring buffer.
+    cluon::data::Envelope large;
+    large.dataType(1234).serializedData(std::string(6 * 1024 * 1024, 'x'));
+    publisher.send(std::move(large));
+
+    REQUIRE(waitFor([&received, &receivedLarge]() { return (150 == received.load()) && (1 == receivedLarge.load()); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE(150 == received.load());
+    REQUIRE(1 == receivedLarge.load());
+
+    REQUIRE(0 == ::unsetenv("CLUON_OD4SESSION_SHAREDMEMORY"));
+}
+
+TEST_CASE("Receive Envelopes from a publisher using shared memory without using shared memory.") {
+    REQUIRE(0 == ::setenv("CLUON_OD4SESSION_SHAREDMEMORY", "173", 1));
+    cluon::OD4Session publisher(173);
+    REQUIRE(publisher.isUsingSharedMemory());
+    REQUIRE(0 == ::unsetenv("CLUON_OD4SESSION_SHAREDMEMORY"));
+
+    std::atomic<uint32_t> received{0};
+    cluon::OD4Session subscriber(173, [&received](cluon::data::Envelope &&) { received++; });
+    REQUIRE(!subscriber.isUsingSharedMemory());
+
+    cluon::data::TimeStamp ts;
+    for (int32_t i{0}; i < 10; i++) {
+        publisher.send(ts);
+    }
+
+    REQUIRE(waitFor([&received]() { return 10 == received.load(); }));
+}
+
+TEST_CASE("Destroy OD4Sessions while Envelopes are arriving.") {
+    std::atomic<bool> sending{true};
+    std::thread sender([&sending]() {
+        cluon::OD4Session publisher(174);
+        cluon::data::TimeStamp ts;
+        while (sending.load()) {
+            publisher.send(ts);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    for (int32_t i{0}; i < 20; i++) {
+        std::atomic<uint32_t> received{0};
+        {
+            const std::string NAME{"subscriber for destroying OD4Sessions"};
+            cluon::OD4Session subscriber(174, [&received, NAME](cluon::data::Envelope &&) {
+                // Keep the delegate busy while the OD4Session is destroyed and use its captured state afterwards.
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                received += NAME.empty() ? 0 : 1;
+            });
+            waitFor([&received]() { return 0 < received.load(); });
+        }
+        REQUIRE(0 < received.load());
+    }
+
+    sending.store(false);
+    sender.join();
+}
+
+TEST_CASE("Send a batch of Envelopes in one UDP packet per Envelope unless batching is enabled.") {
+    for (const bool BATCHING : {false, true}) {
+        if (BATCHING) {
+            REQUIRE(0 == ::setenv("CLUON_OD4SESSION_BATCHING", "175", 1));
+        }
+        cluon::OD4Session publisher(175);
+        REQUIRE(0 == ::unsetenv("CLUON_OD4SESSION_BATCHING"));
+
+        std::atomic<uint32_t> packets{0};
+        cluon::UDPReceiver receiver(
+            "225.0.0.175", 12175, [&packets](std::string &&, std::string &&, std::chrono::system_clock::time_point &&) { packets++; });
+        std::atomic<uint32_t> received{0};
+        cluon::OD4Session subscriber(175, [&received](cluon::data::Envelope &&) { received++; });
+
+        cluon::data::TimeStamp ts;
+        std::vector<cluon::data::TimeStamp> batch(50, ts);
+        publisher.send(batch);
+
+        REQUIRE(waitFor([&received]() { return 50 == received.load(); }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE(50 == received.load());
+        if (BATCHING) {
+            REQUIRE(packets.load() < 50);
+        } else {
+            REQUIRE(50 == packets.load());
+        }
+    }
+}
+
+TEST_CASE("Send a vector of Envelopes as they are.") {
+    cluon::OD4Session publisher(176);
+    std::atomic<uint32_t> receivedTimeStamps{0};
+    cluon::OD4Session subscriber(176, [&receivedTimeStamps](cluon::data::Envelope &&env) {
+        receivedTimeStamps += (cluon::data::TimeStamp::ID() == env.dataType()) ? 1 : 0;
+    });
+
+    cluon::data::TimeStamp ts;
+    ts.seconds(176);
+    cluon::ToProtoVisitor protoEncoder;
+    ts.accept(protoEncoder);
+    cluon::data::Envelope env;
+    env.dataType(cluon::data::TimeStamp::ID()).serializedData(protoEncoder.encodedData());
+
+    std::vector<cluon::data::Envelope> envelopes(10, env);
+    publisher.send(envelopes);
+    REQUIRE(10 == envelopes.size());
+    REQUIRE(env.serializedData() == envelopes.front().serializedData());
+
+    REQUIRE(waitFor([&receivedTimeStamps]() { return 10 == receivedTimeStamps.load(); }));
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "cluon-complete-v0.0.127.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void record(const std::string &file, const std::vector<int32_t> &seconds, bool chunked = false) {
+    cluon::Recorder recorder(file, chunked);
+    REQUIRE(recorder.isRecording());
+    for (int32_t s : seconds) {
+        cluon::data::TimeStamp payload;
+        payload.seconds(s);
+        cluon::ToProtoVisitor protoEncoder;
+        payload.accept(protoEncoder);
+
+        cluon::data::Envelope envelope;
+        envelope.dataType(cluon::data::TimeStamp::ID()).serializedData(protoEncoder.encodedData()).sampleTimeStamp(payload);
+        recorder.record(std::move(envelope));
+    }
+}
+
+static std::vector<int32_t> replay(const std::string &file) {
+    std::vector<int32_t> seconds;
+    cluon::Player player(file, false, false);
+    while (player.hasMoreData()) {
+        auto next = player.getNextEnvelopeToBeReplayed();
+        if (next.first) {
+            seconds.push_back(next.second.sampleTimeStamp().seconds());
+        }
+    }
+    return seconds;
+}
+
+static void removeRecFile(const std::string &file) {
+    std::remove(file.c_str());
+    std::remove((file + ".idx").c_str());
+}
+
+TEST_CASE("Ignore an index sidecar file for a rewritten rec file with the same size and modification time.") {
+    const std::string REC_FILE{"TestPlayer-rewritten.rec"};
+    removeRecFile(REC_FILE);
+
+    record(REC_FILE, {1001, 1002, 1003, 1004});
+    REQUIRE(0 == ::access((REC_FILE + ".idx").c_str(), F_OK));
+    REQUIRE(std::vector<int32_t>{1001, 1002, 1003, 1004} == replay(REC_FILE));
+
+    struct stat before {};
+    REQUIRE(0 == ::stat(REC_FILE.c_str(), &before));
+
+    // Rewrite the rec file with Envelopes of the same size in reverse order but keep the index sidecar file.
+    const std::string REWRITTEN{"TestPlayer-rewritten-2.rec"};
+    removeRecFile(REWRITTEN);
+    record(REWRITTEN, {1004, 1003, 1002, 1001});
+    REQUIRE(0 == std::rename(REWRITTEN.c_str(), REC_FILE.c_str()));
+    std::remove((REWRITTEN + ".idx").c_str());
+
+    const struct timespec TIMES[2]{before.st_atim, before.st_mtim};
+    REQUIRE(0 == ::utimensat(AT_FDCWD, REC_FILE.c_str(), TIMES, 0));
+    struct stat after {};
+    REQUIRE(0 == ::stat(REC_FILE.c_str(), &after));
+    REQUIRE(before.st_size == after.st_size);
+    REQUIRE(before.st_mtim.tv_sec == after.st_mtim.tv_sec);
+    REQUIRE(before.st_mtim.tv_nsec == after.st_mtim.tv_nsec);
+
+    // A stale index would replay the Envelopes in the order of their positions in the rewritten file.
+    REQUIRE(std::vector<int32_t>{1001, 1002, 1003, 1004} == replay(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Create the index sidecar file from concurrent Players.") {
+    const std::string REC_FILE{"TestPlayer-concurrent.rec"};
+    removeRecFile(REC_FILE);
+
+    std::vector<int32_t> seconds;
+    for (int32_t i{0}; i < 10000; i++) {
+        seconds.push_back(1000 + i);
+    }
+    record(REC_FILE, seconds);
+    REQUIRE(0 == std::remove((REC_FILE + ".idx").c_str()));
+
+    REQUIRE(0 == ::setenv("CLUON_PLAYER_INDEXFILE", "1", 1));
+    std::vector<std::thread> players;
+    std::vector<uint32_t> entries(8, 0);
+    for (std::size_t i{0}; i < entries.size(); i++) {
+        players.emplace_back([&REC_FILE, &entries, i]() {
+            cluon::Player player(REC_FILE, false, false);
+            entries[i] = player.totalNumberOfEnvelopesInRecFile();
+        });
+    }
+    for (auto &t : players) {
+        t.join();
+    }
+    REQUIRE(0 == ::unsetenv("CLUON_PLAYER_INDEXFILE"));
+    for (uint32_t e : entries) {
+        REQUIRE(seconds.size() == e);
+    }
+
+    // No temporary files are left behind.
+    uint32_t files{0};
+    DIR *dir{::opendir(".")};
+    REQUIRE(nullptr != dir);
+    for (struct dirent *entry{::readdir(dir)}; nullptr != entry; entry = ::readdir(dir)) {
+        files += (0 == std::string(entry->d_name).find(REC_FILE)) ? 1 : 0;
+    }
+    ::closedir(dir);
+    REQUIRE(2 == files);
+    REQUIRE(seconds == replay(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Store the index sidecar file from Player only on request.") {
+    const std::string REC_FILE{"TestPlayer-opt-in.rec"};
+    removeRecFile(REC_FILE);
+
+    record(REC_FILE, {1001, 1002, 1003});
+    REQUIRE(0 == std::remove((REC_FILE + ".idx").c_str()));
+
+    REQUIRE(0 == ::unsetenv("CLUON_PLAYER_INDEXFILE"));
+    REQUIRE(std::vector<int32_t>{1001, 1002, 1003} == replay(REC_FILE));
+    REQUIRE(0 != ::access((REC_FILE + ".idx").c_str(), F_OK));
+
+    REQUIRE(0 == ::setenv("CLUON_PLAYER_INDEXFILE", "1", 1));
+    REQUIRE(std::vector<int32_t>{1001, 1002, 1003} == replay(REC_FILE));
+    REQUIRE(0 == ::unsetenv("CLUON_PLAYER_INDEXFILE"));
+    REQUIRE(0 == ::access((REC_FILE + ".idx").c_str(), F_OK));
+    REQUIRE(std::vector<int32_t>{1001, 1002, 1003} == replay(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Replay a chunked rec file without and with its index sidecar file.") {
+    const std::string REC_FILE{"TestPlayer-chunked.rec"};
+    removeRecFile(REC_FILE);
+
+    // Several chunks of 4 MiB are indexed in parallel.
+    std::vector<int32_t> seconds;
+    for (int32_t i{0}; i < 400000; i++) {
+        seconds.push_back(1000 + i);
+    }
+    record(REC_FILE, seconds, true);
+    REQUIRE(seconds == replay(REC_FILE));
+    REQUIRE(0 == std::remove((REC_FILE + ".idx").c_str()));
+    REQUIRE(seconds == replay(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Replay a memory-mapped rec file.") {
+    const std::string REC_FILE{"TestPlayer-mapped.rec"};
+    removeRecFile(REC_FILE);
+
+    record(REC_FILE, {1003, 1001, 1002});
+    cluon::Player player(REC_FILE, false, false, true);
+    std::vector<int32_t> seconds;
+    while (player.hasMoreData()) {
+        auto next = player.getNextSerializedEnvelopeToBeReplayed();
+        if (nullptr != next.first) {
+            auto envelope = cluon::extractEnvelope(next.first, next.second);
+            REQUIRE(envelope.first);
+            seconds.push_back(envelope.second.sampleTimeStamp().seconds());
+        }
+    }
+    REQUIRE(std::vector<int32_t>{1001, 1002, 1003} == seconds);
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Replay only the allowed Envelopes.") {
+    const std::string REC_FILE{"TestPlayer-allowed.rec"};
+    removeRecFile(REC_FILE);
+
+    {
+        cluon::Recorder recorder(REC_FILE);
+        for (int32_t i{0}; i < 30; i++) {
+            cluon::data::Envelope envelope;
+            envelope.dataType(1000 + (i % 3)).senderStamp(static_cast<uint32_t>(i % 2)).sampleTimeStamp(cluon::time::fromMicroseconds(1000000 + i));
+            recorder.record(std::move(envelope));
+        }
+    }
+
+    for (const bool MEMORYMAPPED : {false, true}) {
+        cluon::Player player(REC_FILE, false, false, MEMORYMAPPED, {{1000, {}}, {1001, {1}}});
+        REQUIRE(15 == player.totalNumberOfEnvelopesInRecFile());
+        uint32_t replayed{0};
+        while (player.hasMoreData()) {
+            auto next = player.getNextEnvelopeToBeReplayed();
+            if (next.first) {
+                REQUIRE(((1000 == next.second.dataType()) || ((1001 == next.second.dataType()) && (1 == next.second.senderStamp()))));
+                replayed++;
+            }
+        }
+        REQUIRE(15 == replayed);
+    }
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Seek to a sample time stamp.") {
+    const std::string REC_FILE{"TestPlayer-seek.rec"};
+    removeRecFile(REC_FILE);
+
+    std::vector<int32_t> seconds;
+    for (int32_t i{0}; i < 100; i++) {
+        seconds.push_back(1000 + i);
+    }
+    record(REC_FILE, seconds);
+
+    for (const bool THREADING : {false, true}) {
+        cluon::Player player(REC_FILE, false, THREADING);
+        player.seekToTimestamp(static_cast<int64_t>(1050) * 1000 * 1000);
+        auto next = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(next.first);
+        REQUIRE(1050 == next.second.sampleTimeStamp().seconds());
+
+        player.rewind();
+        next = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(next.first);
+        REQUIRE(1000 == next.second.sampleTimeStamp().seconds());
+    }
+
+    removeRecFile(REC_FILE);
+}
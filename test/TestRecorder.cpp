@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "cluon-complete-v0.0.127.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static cluon::data::Envelope createEnvelope(int32_t i) {
+    cluon::data::Envelope envelope;
+    envelope.dataType(1000 + (i % 3))
+        .senderStamp(static_cast<uint32_t>(i % 2))
+        .serializedData(std::string(static_cast<std::size_t>(10 + i % 50), static_cast<char>('a' + i % 26)))
+        .sampleTimeStamp(cluon::time::fromMicroseconds(1000000 + i));
+    return envelope;
+}
+
+static std::vector<std::string> replaySerialized(const std::string &file) {
+    std::vector<std::string> envelopes;
+    cluon::Player player(file, false, false);
+    while (player.hasMoreData()) {
+        auto next = player.getNextEnvelopeToBeReplayed();
+        if (next.first) {
+            envelopes.emplace_back(cluon::serializeEnvelope(std::move(next.second)));
+        }
+    }
+    return envelopes;
+}
+
+static void removeRecFile(const std::string &file) {
+    std::remove(file.c_str());
+    std::remove((file + ".idx").c_str());
+}
+
+TEST_CASE("Record a plain rec file that is the concatenation of the OD4-framed Envelopes.") {
+    const std::string REC_FILE{"TestRecorder-plain.rec"};
+    removeRecFile(REC_FILE);
+
+    std::string expected;
+    std::vector<std::string> envelopes;
+    {
+        cluon::Recorder recorder(REC_FILE);
+        REQUIRE(recorder.isRecording());
+        for (int32_t i{0}; i < 1000; i++) {
+            envelopes.emplace_back(cluon::serializeEnvelope(createEnvelope(i)));
+            expected += envelopes.back();
+            recorder.record(createEnvelope(i));
+        }
+        REQUIRE(1000 == recorder.numberOfEnvelopes());
+    }
+
+    std::ifstream in(REC_FILE, std::ios::in | std::ios::binary);
+    std::stringstream sstr;
+    sstr << in.rdbuf();
+    REQUIRE(expected == sstr.str());
+    REQUIRE(0 == ::access((REC_FILE + ".idx").c_str(), F_OK));
+    REQUIRE(envelopes == replaySerialized(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Record a chunked rec file and replay it.") {
+    const std::string REC_FILE{"TestRecorder-chunked.rec"};
+    removeRecFile(REC_FILE);
+
+    std::vector<std::string> envelopes;
+    uint64_t bytes{0};
+    {
+        cluon::Recorder recorder(REC_FILE, true);
+        REQUIRE(recorder.isRecording());
+        for (int32_t i{0}; i < 200000; i++) {
+            envelopes.emplace_back(cluon::serializeEnvelope(createEnvelope(i)));
+            bytes += envelopes.back().size();
+            recorder.record(createEnvelope(i));
+        }
+    }
+
+    // The repetitive payloads are compressed.
+    struct stat fileStatus {};
+    REQUIRE(0 == ::stat(REC_FILE.c_str(), &fileStatus));
+    REQUIRE(static_cast<uint64_t>(fileStatus.st_size) < bytes / 2);
+
+    REQUIRE(envelopes == replaySerialized(REC_FILE));
+    REQUIRE(0 == std::remove((REC_FILE + ".idx").c_str()));
+    REQUIRE(envelopes == replaySerialized(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
+
+TEST_CASE("Replay a chunked rec file without its table of chunks.") {
+    const std::string REC_FILE{"TestRecorder-interrupted.rec"};
+    removeRecFile(REC_FILE);
+
+    std::vector<std::string> envelopes;
+    {
+        cluon::Recorder recorder(REC_FILE, true);
+        for (int32_t i{0}; i < 100; i++) {
+            envelopes.emplace_back(cluon::serializeEnvelope(createEnvelope(i)));
+            recorder.record(createEnvelope(i));
+        }
+    }
+    REQUIRE(0 == std::remove((REC_FILE + ".idx").c_str()));
+
+    // Remove the table of the one chunk and the trailer as if the recording was interrupted.
+    struct stat fileStatus {};
+    REQUIRE(0 == ::stat(REC_FILE.c_str(), &fileStatus));
+    REQUIRE(0 == ::truncate(REC_FILE.c_str(), fileStatus.st_size - static_cast<off_t>(cluon::CHUNKED_REC_FILE_CHUNK_ENTRY_SIZE + cluon::CHUNKED_REC_FILE_TRAILER_SIZE)));
+
+    REQUIRE(envelopes == replaySerialized(REC_FILE));
+
+    removeRecFile(REC_FILE);
+}
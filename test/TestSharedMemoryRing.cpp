@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "cluon-complete-v0.0.127.hpp"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+static std::vector<std::string> readAll(cluon::SharedMemoryRing &ring) {
+    std::vector<std::string> entries;
+    ring.read([&entries](std::string &&entry) { entries.emplace_back(std::move(entry)); }, std::chrono::milliseconds(100));
+    return entries;
+}
+
+TEST_CASE("Receive the entries written by others since attaching.") {
+    cluon::SharedMemoryRing producer("TestSharedMemoryRing-attach");
+    REQUIRE(producer.valid());
+    REQUIRE(producer.write("before", 6));
+
+    cluon::SharedMemoryRing consumer("TestSharedMemoryRing-attach");
+    REQUIRE(consumer.valid());
+    REQUIRE(producer.write("first", 5));
+    REQUIRE(consumer.write("own", 3));
+    REQUIRE(producer.write("second", 6));
+
+    REQUIRE(std::vector<std::string>{"first", "second"} == readAll(consumer));
+    REQUIRE(std::vector<std::string>{"own"} == readAll(producer));
+    REQUIRE(readAll(consumer).empty());
+    REQUIRE(0 == consumer.numberOfOverruns());
+}
+
+TEST_CASE("Count overruns of a consumer that does not keep up.") {
+    const std::string ENTRY(1000, 'x');
+    cluon::SharedMemoryRing producer("TestSharedMemoryRing-overrun", cluon::SharedMemoryRing::capacityFor(static_cast<uint32_t>(ENTRY.size())));
+    cluon::SharedMemoryRing consumer("TestSharedMemoryRing-overrun");
+    REQUIRE(ENTRY.size() <= consumer.maxEntrySize());
+    REQUIRE(!producer.write(std::string(2 * producer.maxEntrySize(), 'x').data(), 2 * producer.maxEntrySize()));
+
+    for (int32_t i{0}; i < 10; i++) {
+        REQUIRE(producer.write(ENTRY.data(), ENTRY.size()));
+    }
+    auto entries = readAll(consumer);
+    REQUIRE(entries.size() < 10);
+    REQUIRE(0 < consumer.numberOfOverruns());
+}
+
+TEST_CASE("Announce identifiers while attached.") {
+    std::unique_ptr<cluon::SharedMemoryRing> first{new cluon::SharedMemoryRing("TestSharedMemoryRing-participants")};
+    cluon::SharedMemoryRing second("TestSharedMemoryRing-participants");
+    REQUIRE(first->addParticipant(4711));
+    REQUIRE(second.hasParticipant(4711));
+    REQUIRE(!second.hasParticipant(4712));
+
+    first.reset();
+    REQUIRE(!second.hasParticipant(4711));
+}
+
+TEST_CASE("Exchange entries with another process.") {
+    cluon::SharedMemoryRing consumer("TestSharedMemoryRing-process");
+    REQUIRE(consumer.valid());
+
+    const pid_t CHILD{::fork()};
+    REQUIRE(-1 != CHILD);
+    if (0 == CHILD) {
+        int32_t written{0};
+        {
+            cluon::SharedMemoryRing producer("TestSharedMemoryRing-process");
+            for (int32_t i{0}; i < 100; i++) {
+                const std::string ENTRY{std::to_string(i)};
+                written += producer.write(ENTRY.data(), ENTRY.size()) ? 1 : 0;
+            }
+        }
+        ::_exit((100 == written) ? 0 : 1);
+    }
+    int status{0};
+    REQUIRE(CHILD == ::waitpid(CHILD, &status, 0));
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(0 == WEXITSTATUS(status));
+
+    std::vector<std::string> entries;
+    while (entries.size() < 100) {
+        auto next = readAll(consumer);
+        if (next.empty()) {
+            break;
+        }
+        entries.insert(entries.end(), next.begin(), next.end());
+    }
+    REQUIRE(100 == entries.size());
+    for (std::size_t i{0}; i < entries.size(); i++) {
+        REQUIRE(std::to_string(i) == entries[i]);
+    }
+}